@@ -0,0 +1,70 @@
+#ifndef ALLOCATIONPOLICY_H
+#define ALLOCATIONPOLICY_H
+
+#include "Car.h"
+
+// 车位分配策略（构造ParkingSystem时选定）
+enum AllocationPolicyKind : unsigned char {
+    ALLOCATE_STRICT,            // 只停本类型车位（默认）
+    ALLOCATE_BEST_FIT,          // 本类型车位已满时按Car::canParkIn停入低一级的车位
+    ALLOCATE_RESERVE_AWARE      // 同上，但每种车位留出一部分只给本类型车辆
+};
+
+// 车位分配策略基类（CRTP）
+// 派生类提供 int limitFor(int carType, int spaceType, int spaces) const：
+// carType型车辆最多可以把spaceType类型车位（共spaces个）占到多少个，0表示不能停入。
+// 候选次序对各策略相同：先本类型车位，再依次是低一级的车位（低级车位能停的车型更多，尽量留给其他车型）。
+// ParkingSystem按选定的策略调用对应的模板实例，分配的热路径上没有虚函数调用，上限的计算可以内联
+template <class Derived>
+class AllocationPolicy {
+public:
+    // 按候选次序的第index个车位类型（从0开始），没有更多候选时返回-1
+    static int candidate(int carType, int index) {
+        int spaceType = carType - index;
+        return carType >= SMALL && carType <= LARGE && index >= 0 && spaceType >= SPACE_SMALL ? spaceType : -1;
+    }
+    
+    // carType型车辆最多可以把spaceType类型车位占到多少个
+    int limit(int carType, int spaceType, int spaces) const {
+        return static_cast<const Derived*>(this)->limitFor(carType, spaceType, spaces);
+    }
+};
+
+// 严格匹配：车辆只停本类型车位
+class StrictPolicy : public AllocationPolicy<StrictPolicy> {
+public:
+    int limitFor(int carType, int spaceType, int spaces) const {
+        return carType == spaceType ? spaces : 0;
+    }
+};
+
+// 最佳适配：先停本类型车位，已满时停入canParkIn允许的低一级车位
+class BestFitPolicy : public AllocationPolicy<BestFitPolicy> {
+public:
+    int limitFor(int carType, int spaceType, int spaces) const {
+        return Car::canParkIn(static_cast<CarType>(carType), static_cast<ParkingSpaceType>(spaceType)) ? spaces : 0;
+    }
+};
+
+// 保留感知：与最佳适配相同，但其他车型最多只能把spaceType类型车位占到"数量-保留量"，
+// 保留的车位只给本类型车辆（例如留几个小型车位，大型车不会把小型车位占满）
+class ReserveAwarePolicy : public AllocationPolicy<ReserveAwarePolicy> {
+private:
+    const int* reserve;         // 小/中/大型车位的保留量（不拥有）
+    
+public:
+    explicit ReserveAwarePolicy(const int* reserved) : reserve(reserved) {}
+    
+    int limitFor(int carType, int spaceType, int spaces) const {
+        if (carType == spaceType) {
+            return spaces;
+        }
+        if (!Car::canParkIn(static_cast<CarType>(carType), static_cast<ParkingSpaceType>(spaceType))) {
+            return 0;
+        }
+        int shared = spaces - reserve[spaceType];
+        return shared > 0 ? shared : 0;
+    }
+};
+
+#endif // ALLOCATIONPOLICY_H
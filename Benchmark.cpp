@@ -0,0 +1,1859 @@
+#include "ParkingSystem.h"
+#include "ParkingCheckpoint.h"
+#include "ParkingFacility.h"
+#include "WorkloadGenerator.h"
+#include "TimestampFormat.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <queue>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+
+using namespace std;
+
+// ==================== 堆分配计数 ====================
+// 替换全局operator new，统计基准测试期间的堆分配次数
+
+static unsigned long long g_allocCount = 0;
+static unsigned long long g_allocBytes = 0;
+
+void* operator new(size_t size) {
+    g_allocCount++;
+    g_allocBytes += size;
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+// GCC无法识别成对替换的operator new/delete，会误报free与new不匹配
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+// ==================== 计时工具 ====================
+
+typedef chrono::steady_clock BenchClock;
+
+static double elapsedNs(BenchClock::time_point start) {
+    return static_cast<double>(
+        chrono::duration_cast<chrono::nanoseconds>(BenchClock::now() - start).count());
+}
+
+// 防止编译器把结果优化掉
+static volatile unsigned long long g_sink = 0;
+
+// ==================== 车辆记录布局 ====================
+
+// 原车辆记录布局（std::string车牌 + 4字节枚举 + 64位时间戳），用于对比
+struct LegacyCar {
+    string licensePlate;
+    int type;
+    time_t entryTime;
+    time_t exitTime;
+    int spaceType;
+    
+    LegacyCar() : type(0), entryTime(0), exitTime(0), spaceType(0) {}
+    LegacyCar(const string& plate, int carType, time_t entry)
+        : licensePlate(plate), type(carType), entryTime(entry), exitTime(0), spaceType(0) {}
+};
+
+// 生成测试车牌
+static string makePlate(int i) {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "TEST%05d", i);
+    return string(buffer);
+}
+
+// 按原carDeparture的方式让路：逐辆peek/pop/push进临时栈，再逐辆移回
+// 返回本次离开产生的车辆复制次数
+template <class CarT>
+static unsigned long long departViaTempStack(vector<CarT>& lot, vector<CarT>& temp, int position) {
+    unsigned long long copies = 0;
+    CarT target = lot[lot.size() - position];   // getCarAt
+    copies++;
+    for (int i = 1; i < position; i++) {
+        CarT blocking = lot.back();             // peek
+        copies++;
+        lot.pop_back();
+        temp.push_back(blocking);               // push到临时栈
+        copies++;
+    }
+    lot.pop_back();
+    while (!temp.empty()) {
+        CarT blocking = temp.back();            // peek
+        copies++;
+        temp.pop_back();
+        lot.push_back(blocking);                // push回停车场
+        copies++;
+    }
+    lot.push_back(target);                      // 目标车辆重新停入，保持车场规模不变
+    g_sink += lot.size();
+    return copies;
+}
+
+// 按现在carDeparture的方式让路：原地移除目标车辆，其后的车辆整体挪动（一次memmove）
+template <class CarT>
+static unsigned long long departInPlace(vector<CarT>& lot, vector<CarT>& temp, int position) {
+    (void)temp;
+    CarT target = lot[lot.size() - position];   // 复制目标车辆用于计费
+    lot.erase(lot.end() - position);
+    lot.push_back(target);                      // 目标车辆重新停入，保持车场规模不变
+    g_sink += lot.size();
+    return 1;
+}
+
+template <class CarT>
+static void runDepartureShuffle(const char* label, int lotSize, int blocking, int iterations,
+                                unsigned long long (*depart)(vector<CarT>&, vector<CarT>&, int)) {
+    vector<CarT> lot;
+    vector<CarT> temp;
+    lot.reserve(lotSize + 1);
+    temp.reserve(lotSize + 1);
+    for (int i = 0; i < lotSize; i++) {
+        lot.push_back(CarT(makePlate(i), SMALL, 1000 + i));
+    }
+    
+    unsigned long long copies = 0;
+    unsigned long long allocsBefore = g_allocCount;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < iterations; i++) {
+        copies += depart(lot, temp, blocking + 1);
+    }
+    double ns = elapsedNs(start);
+    unsigned long long allocs = g_allocCount - allocsBefore;
+    
+    cout << left << setw(28) << label
+         << right << setw(14) << fixed << setprecision(1) << ns / iterations
+         << setw(16) << setprecision(1) << static_cast<double>(copies) / iterations
+         << setw(16) << setprecision(2) << static_cast<double>(allocs) / iterations << endl;
+}
+
+// 离开时让路车辆数为blocking时，不同布局和让路方式的车辆复制和堆分配开销
+static void benchCarLayout() {
+    cout << "\n[car] 车辆记录布局" << endl;
+    cout << "  LegacyCar: " << sizeof(LegacyCar) << " 字节/车（另有车牌超出SSO时的堆内存）" << endl;
+    cout << "  Car:       " << sizeof(Car) << " 字节/车，可平凡复制: "
+         << (is_trivially_copyable<Car>::value ? "是" : "否") << endl;
+    
+    const int lotSize = 100;
+    const int blocking = 50;
+    const int iterations = 20000;
+    
+    cout << "\n[car] 离开让路（车场 " << lotSize << " 辆，让路 " << blocking << " 辆）" << endl;
+    cout << left << setw(28) << "  布局"
+         << right << setw(14) << "ns/离开"
+         << setw(16) << "复制/离开"
+         << setw(16) << "分配/离开" << endl;
+    runDepartureShuffle<LegacyCar>("  LegacyCar + 临时栈", lotSize, blocking, iterations,
+                                   departViaTempStack<LegacyCar>);
+    runDepartureShuffle<Car>("  Car + 临时栈", lotSize, blocking, iterations,
+                             departViaTempStack<Car>);
+    runDepartureShuffle<Car>("  Car + 原地移除", lotSize, blocking, iterations,
+                             departInPlace<Car>);
+}
+
+// ==================== 候车道队列 ====================
+
+// 原候车道实现：每次入队new一个节点，出队delete，用于对比
+class LegacyQueue {
+private:
+    struct Node {
+        Car car;
+        Node* next;
+        Node(const Car& c) : car(c), next(nullptr) {}
+    };
+    Node* front;
+    Node* rear;
+    int count;
+    
+public:
+    LegacyQueue() : front(nullptr), rear(nullptr), count(0) {}
+    ~LegacyQueue() {
+        while (dequeue()) {}
+    }
+    
+    void enqueue(const Car& car) {
+        Node* node = new Node(car);
+        if (front == nullptr) {
+            front = rear = node;
+        } else {
+            rear->next = node;
+            rear = node;
+        }
+        count++;
+    }
+    
+    bool dequeue() {
+        if (front == nullptr) {
+            return false;
+        }
+        Node* temp = front;
+        front = front->next;
+        if (front == nullptr) {
+            rear = nullptr;
+        }
+        delete temp;
+        count--;
+        return true;
+    }
+    
+    int size() const { return count; }
+};
+
+// 候车道保持depth辆车，反复入队一辆、出队一辆
+template <class QueueT>
+static void runQueuePairs(const char* label, int depth, int pairs) {
+    QueueT lane;
+    Car car(makePlate(1), SMALL, 1000);
+    for (int i = 0; i < depth; i++) {
+        lane.enqueue(car);
+    }
+    
+    unsigned long long allocsBefore = g_allocCount;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < pairs; i++) {
+        lane.enqueue(car);
+        lane.dequeue();
+    }
+    double ns = elapsedNs(start);
+    unsigned long long allocs = g_allocCount - allocsBefore;
+    g_sink += lane.size();
+    
+    cout << left << setw(28) << label
+         << right << setw(14) << fixed << setprecision(1) << ns / pairs
+         << setw(16) << setprecision(2) << pairs / (ns / 1e9) / 1e6
+         << setw(16) << setprecision(4) << static_cast<double>(allocs) / pairs << endl;
+}
+
+static void benchQueue() {
+    const int pairs = 1000000;
+    const int depths[] = { 1, 64, 4096 };
+    
+    for (size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+        cout << "\n[queue] " << pairs << " 次入队/出队（候车道保持 " << depths[d] << " 辆）" << endl;
+        cout << left << setw(28) << "  实现"
+             << right << setw(14) << "ns/对"
+             << setw(16) << "百万对/秒"
+             << setw(16) << "分配/对" << endl;
+        runQueuePairs<LegacyQueue>("  new/delete链表", depths[d], pairs);
+        runQueuePairs<Queue>("  节点池Queue", depths[d], pairs);
+    }
+}
+
+// ==================== 停车场实例占用 ====================
+
+// 不同容量下单个ParkingSystem实例的内存占用，以及大容量车场能否停满
+static void benchLotFootprint() {
+    cout << "\n[lot] 停车场实例占用" << endl;
+    cout << left << setw(16) << "  容量"
+         << right << setw(18) << "对象字节"
+         << setw(18) << "堆字节"
+         << setw(18) << "停满耗时(ms)" << endl;
+    
+    const int capacities[] = { 2, 100, 10000, 100000 };
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); c++) {
+        int capacity = capacities[c];
+        unsigned long long bytesBefore = g_allocBytes;
+        ParkingSystem* system = new ParkingSystem(capacity, 5.0);
+        unsigned long long heapBytes = g_allocBytes - bytesBefore - sizeof(ParkingSystem);
+        
+        // 全部设为大型车位，用大型车停满
+        system->setParkingSpaces(0, 0, capacity);
+        system->setEventSink(&nullEventSink());
+        BenchClock::time_point start = BenchClock::now();
+        int parked = 0;
+        for (int i = 0; i < capacity; i++) {
+            if (system->carArrival(makePlate(i), LARGE, 1000 + i).outcome == ARRIVAL_PARKED) {
+                parked++;
+            }
+        }
+        double ms = elapsedNs(start) / 1e6;
+        
+        cout << left << setw(16) << ("  " + to_string(capacity))
+             << right << setw(18) << sizeof(ParkingSystem)
+             << setw(18) << heapBytes
+             << setw(18) << fixed << setprecision(2) << ms
+             << (parked == capacity ? "" : "  （未停满）") << endl;
+        delete system;
+    }
+}
+
+// ==================== 快照保存与加载 ====================
+
+// 获取文件大小（字节）
+static long fileSize(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr) {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+// 停满10万辆车（另有1000辆在候车道）后，对比二进制快照和文本导出的保存、加载耗时
+static void benchSnapshot() {
+    const int capacity = 100000;
+    const int waiting = 1000;
+    const char* binaryFile = "bench_snapshot.bin";
+    const char* textFile = "bench_snapshot.txt";
+    
+    ParkingSystem system(capacity, 5.0);
+    system.setParkingSpaces(0, 0, capacity);
+    system.setEventSink(&nullEventSink());
+    for (int i = 0; i < capacity + waiting; i++) {
+        system.carArrival(makePlate(i), LARGE, 1000 + i);
+    }
+    
+    cout << "\n[snapshot] " << capacity << " 辆车在停车场，" << waiting << " 辆车在候车道（文件位于页缓存中）" << endl;
+    cout << left << setw(20) << "  格式"
+         << right << setw(16) << "文件字节"
+         << setw(16) << "保存(ms)"
+         << setw(16) << "加载(ms)" << endl;
+    
+    for (int format = 0; format < 2; format++) {
+        bool binary = format == 0;
+        const char* filename = binary ? binaryFile : textFile;
+        
+        BenchClock::time_point start = BenchClock::now();
+        bool saved = binary ? system.saveSnapshot(filename) : system.saveToFile(filename);
+        double saveMs = elapsedNs(start) / 1e6;
+        
+        ParkingSystem restored(1, 1.0);
+        restored.setEventSink(&nullEventSink());
+        start = BenchClock::now();
+        bool loaded = binary ? restored.loadSnapshot(filename) : restored.loadFromFile(filename);
+        double loadMs = elapsedNs(start) / 1e6;
+        bool complete = loaded && restored.getWaitingLaneLength() == waiting &&
+                        restored.getAvailableSpaces() == 0;
+        
+        cout << left << setw(20) << (binary ? "  二进制快照(mmap)" : "  文本导出")
+             << right << setw(16) << fileSize(filename)
+             << setw(16) << fixed << setprecision(2) << saveMs
+             << setw(16) << loadMs
+             << (saved && complete ? "" : "  （保存或加载失败）") << endl;
+        remove(filename);
+    }
+}
+
+// ==================== 到达/离开往返 ====================
+
+// 往返测量的结果
+struct PairResult {
+    double nsPerPair;           // 平均每对到达/离开的耗时（纳秒）
+    double allocsPerPair;       // 平均每对的堆分配次数
+};
+
+// 日志、事件、指标、跟踪各项开销共用的测量：停车场有depth+1个小型车位，事件输出到NullEventSink，
+// 预先停入depth辆车后调用attach挂接被测对象，然后让第depth+1辆车反复到达、再离开pairs次并计时。
+// afterPair在每对之后调用（参数为序号），finish在计时结束之前调用（如同步日志），都可以为空
+static PairResult runPairs(int depth, int pairs, const function<void(ParkingSystem&)>& attach,
+                           const function<void(int)>& afterPair = function<void(int)>(),
+                           const function<void()>& finish = function<void()>()) {
+    ParkingSystem system(depth + 1, 5.0);
+    system.setParkingSpaces(depth + 1, 0, 0);
+    system.setEventSink(&nullEventSink());
+    for (int i = 0; i < depth; i++) {
+        system.carArrival(makePlate(i), SMALL, 1000);
+    }
+    attach(system);
+    
+    string plate = makePlate(depth);
+    unsigned long long allocsBefore = g_allocCount;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < pairs; i++) {
+        system.carArrival(plate, SMALL, 1000 + i);
+        g_sink += system.carDeparture(plate, 4600 + i).makeWayCount;
+        if (afterPair) {
+            afterPair(i);
+        }
+    }
+    if (finish) {
+        finish();
+    }
+    PairResult result;
+    result.nsPerPair = elapsedNs(start) / pairs;
+    result.allocsPerPair = static_cast<double>(g_allocCount - allocsBefore) / pairs;
+    return result;
+}
+
+// ==================== 操作日志组提交 ====================
+
+// 每对操作追加两条日志记录；policy为nullptr时不记录日志，作为基线
+static void runJournalPairs(const char* label, const JournalPolicy* policy, int depth, int pairs) {
+    const char* journalFile = "bench_journal.log";
+    remove(journalFile);
+    
+    ParkingJournal journal;
+    vector<JournalRecord> records;
+    if (policy != nullptr) {
+        if (!journal.open(journalFile, records)) {
+            cout << left << setw(28) << label << "  （无法打开日志文件）" << endl;
+            return;
+        }
+        journal.setPolicy(*policy);
+    }
+    
+    PairResult result = runPairs(depth, pairs,
+        [&](ParkingSystem& system) {
+            if (policy != nullptr) {
+                system.setJournal(&journal);
+            }
+        },
+        function<void(int)>(),
+        [&]() {
+            if (policy != nullptr) {
+                journal.sync();
+            }
+        });
+    double nsPerOp = result.nsPerPair / 2;
+    
+    cout << left << setw(28) << label
+         << right << setw(14) << fixed << setprecision(1) << nsPerOp / 1000
+         << setw(16) << setprecision(0) << 1e9 / nsPerOp
+         << setw(16) << journal.getSyncCount()
+         << (policy == nullptr || journal.good() ? "" : "  （写入失败）") << endl;
+    
+    journal.close();
+    remove(journalFile);
+}
+
+static void benchJournal() {
+    const int depth = 64;
+    const int syncedPairs = 1000;       // 每次操作都同步时较慢，少做一些
+    const int groupedPairs = 100000;
+    
+    JournalPolicy everyOp(1, 0);
+    JournalPolicy batch8(8, 0);
+    JournalPolicy batch64(64, 0);
+    JournalPolicy batch512(512, 0);
+    JournalPolicy interval10(0, 10);
+    JournalPolicy defaults;
+    
+    cout << "\n[journal] 到达/离开各追加一条日志记录（停车场保持 " << depth << " 辆，日志位于当前目录）" << endl;
+    cout << left << setw(28) << "  同步策略"
+         << right << setw(14) << "us/次"
+         << setw(16) << "次/秒"
+         << setw(16) << "fsync次数" << endl;
+    runJournalPairs("  不记录日志", nullptr, depth, groupedPairs);
+    runJournalPairs("  每条记录同步", &everyOp, depth, syncedPairs);
+    runJournalPairs("  每8条同步", &batch8, depth, groupedPairs / 10);
+    runJournalPairs("  每64条同步", &batch64, depth, groupedPairs);
+    runJournalPairs("  每512条同步", &batch512, depth, groupedPairs);
+    runJournalPairs("  每10ms同步", &interval10, depth, groupedPairs);
+    runJournalPairs("  默认（64条或50ms）", &defaults, depth, groupedPairs);
+}
+
+// ==================== 检查点期间的到达延迟 ====================
+
+// 检查点方式
+enum CheckpointMode {
+    CHECKPOINT_NONE,            // 不做检查点
+    CHECKPOINT_INLINE,          // 在大门的处理路径上同步写快照
+    CHECKPOINT_BACKGROUND       // 冻结状态后由后台线程写快照
+};
+
+// 停车场停满lotSize辆车并挂接日志，按固定间隔（开环）安排到达/离开，在第startAt对时开始检查点
+// 两次操作之间大门线程休眠（大门大部分时间在等车），统计从检查点开始之后各次操作的延迟。
+// 延迟从计划时间算起：前面的操作被检查点阻塞时，排在后面的操作也一并计入等待时间
+static void runCheckpointLatency(const char* label, CheckpointMode mode, int lotSize,
+                                 int pairs, int startAt, int intervalUs) {
+    const char* journalFile = "bench_checkpoint.log";
+    const char* snapshotFile = "bench_checkpoint.snap";
+    string rotatedFile = string(journalFile) + ".old";
+    remove(journalFile);
+    remove(rotatedFile.c_str());
+    remove(snapshotFile);
+    
+    ParkingSystem system(lotSize + 1, 5.0);
+    system.setParkingSpaces(0, 0, lotSize + 1);
+    system.setEventSink(&nullEventSink());
+    for (int i = 0; i < lotSize; i++) {
+        system.carArrival(makePlate(i), LARGE, 1000);
+    }
+    if (system.getWaitingLaneLength() != 0) {
+        cout << left << setw(24) << label << "  （停车场未停满）" << endl;
+        return;
+    }
+    
+    ParkingJournal journal;
+    vector<JournalRecord> records;
+    if (!journal.open(journalFile, records)) {
+        cout << left << setw(24) << label << "  （无法打开日志文件）" << endl;
+        return;
+    }
+    system.setJournal(&journal);
+    ParkingCheckpointer checkpointer(snapshotFile);
+    // 先做一次后台检查点，让冻结缓冲区分配好（常驻进程中缓冲区在多次检查点之间复用）
+    checkpointer.begin(system);
+    checkpointer.wait();
+    
+    vector<double> latencies;
+    latencies.reserve(pairs - startAt);
+    string plate = makePlate(lotSize);
+    double checkpointMs = 0;
+    BenchClock::time_point checkpointStart;
+    BenchClock::time_point origin = BenchClock::now();
+    for (int i = 0; i < pairs; i++) {
+        BenchClock::time_point scheduled = origin + chrono::microseconds(static_cast<long long>(i) * intervalUs);
+        this_thread::sleep_until(scheduled);
+        
+        if (i == startAt) {
+            checkpointStart = BenchClock::now();
+            if (mode == CHECKPOINT_INLINE) {
+                checkpointer.checkpointNow(system);
+                checkpointMs = elapsedNs(checkpointStart) / 1e6;
+            } else if (mode == CHECKPOINT_BACKGROUND) {
+                checkpointer.begin(system);
+            }
+        }
+        if (mode == CHECKPOINT_BACKGROUND && checkpointer.inProgress()) {
+            checkpointer.poll();
+            if (!checkpointer.inProgress()) {
+                checkpointMs = elapsedNs(checkpointStart) / 1e6;
+            }
+        }
+        
+        system.carArrival(plate, LARGE, 2000 + i);
+        g_sink += system.carDeparture(plate, 5600 + i).makeWayCount;
+        if (i >= startAt) {
+            latencies.push_back(elapsedNs(scheduled));
+        }
+    }
+    bool unfinished = checkpointer.inProgress();
+    checkpointer.wait();
+    
+    size_t count = latencies.size();
+    sort(latencies.begin(), latencies.end());
+    cout << left << setw(24) << label
+         << right << setw(12) << fixed << setprecision(1) << latencies[count / 2] / 1000
+         << setw(12) << latencies[count * 99 / 100] / 1000
+         << setw(12) << latencies[count * 999 / 1000] / 1000
+         << setw(12) << latencies[count - 1] / 1000
+         << setw(12) << setprecision(2) << checkpointMs
+         << setw(12) << (mode == CHECKPOINT_BACKGROUND ? checkpointer.lastFreezeMs() : 0.0)
+         << (unfinished ? "  （统计窗口内检查点未完成）" : "") << endl;
+    
+    journal.close();
+    remove(journalFile);
+    remove(rotatedFile.c_str());
+    remove(snapshotFile);
+}
+
+static void benchCheckpoint() {
+    const int lotSize = 500000;
+    const int pairs = 3000;
+    const int startAt = 1000;
+    const int intervalUs = 100;
+    
+    cout << "\n[checkpoint] 停车场 " << lotSize << " 辆车，每 " << intervalUs
+         << " us 一次到达/离开，第 " << startAt << " 次时开始检查点，统计之后 "
+         << pairs - startAt << " 次操作的延迟（硬件线程数 " << thread::hardware_concurrency() << "）" << endl;
+    cout << left << setw(24) << "  检查点方式"
+         << right << setw(12) << "p50(us)"
+         << setw(12) << "p99(us)"
+         << setw(12) << "p99.9(us)"
+         << setw(12) << "最大(us)"
+         << setw(12) << "检查点(ms)"
+         << setw(12) << "最长持锁(ms)" << endl;
+    runCheckpointLatency("  不做检查点", CHECKPOINT_NONE, lotSize, pairs, startAt, intervalUs);
+    runCheckpointLatency("  同步检查点", CHECKPOINT_INLINE, lotSize, pairs, startAt, intervalUs);
+    runCheckpointLatency("  后台检查点", CHECKPOINT_BACKGROUND, lotSize, pairs, startAt, intervalUs);
+}
+
+// ==================== 事件输出开销 ====================
+
+// 丢弃所有字符的输出缓冲区（只统计格式化开销，不计终端输出）
+class DiscardBuffer : public streambuf {
+protected:
+    int overflow(int c) { return c; }
+    streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+// 事件输出到sink；buffered不为nullptr时每1000对清空一次缓冲的事件
+static void runEventPairs(const char* label, ParkingEventSink* sink, BufferedEventSink* buffered,
+                          int depth, int pairs) {
+    function<void(int)> clearBuffered;
+    if (buffered != nullptr) {
+        clearBuffered = [buffered](int i) {
+            if (i % 1000 == 999) {
+                buffered->clear();
+            }
+        };
+    }
+    PairResult result = runPairs(depth, pairs, [sink](ParkingSystem& system) { system.setEventSink(sink); },
+                                 clearBuffered);
+    
+    cout << left << setw(28) << label
+         << right << setw(14) << fixed << setprecision(1) << result.nsPerPair
+         << setw(16) << setprecision(2) << 1e3 / result.nsPerPair
+         << setw(16) << setprecision(2) << result.allocsPerPair << endl;
+}
+
+static void benchEventSinks() {
+    const int pairs = 200000;
+    const int depth = 64;
+    
+    DiscardBuffer discard;
+    ostream discardStream(&discard);
+    ConsoleEventSink console(discardStream);
+    BufferedEventSink buffered;
+    
+    cout << "\n[events] " << pairs << " 次到达/离开（停车场保持 " << depth << " 辆）" << endl;
+    cout << left << setw(28) << "  事件接收器"
+         << right << setw(14) << "ns/对"
+         << setw(16) << "百万对/秒"
+         << setw(16) << "分配/对" << endl;
+    runEventPairs("  ConsoleEventSink", &console, nullptr, depth, pairs);
+    runEventPairs("  BufferedEventSink", &buffered, &buffered, depth, pairs);
+    runEventPairs("  NullEventSink", &nullEventSink(), nullptr, depth, pairs);
+}
+
+// ==================== 运行指标开销 ====================
+
+// 输出一行往返测量结果（ns/对、分配/对），返回ns/对
+static double printPairResult(const char* label, const PairResult& result) {
+    cout << left << setw(28) << label
+         << right << setw(14) << fixed << setprecision(1) << result.nsPerPair
+         << setw(16) << setprecision(2) << result.allocsPerPair << endl;
+    return result.nsPerPair;
+}
+
+// metrics不为nullptr时挂接运行指标
+static double runMetricPairs(const char* label, ParkingMetrics* metrics, int depth, int pairs) {
+    return printPairResult(label, runPairs(depth, pairs,
+        [metrics](ParkingSystem& system) { system.setMetrics(metrics); }));
+}
+
+// threads个线程同时记录，返回平均每次记录的耗时（纳秒，总耗时/总次数）
+static double runMetricRecords(ParkingMetrics& metrics, int threads, int recordsPerThread) {
+    vector<thread> workers;
+    BenchClock::time_point start = BenchClock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.push_back(thread([&metrics, recordsPerThread]() {
+            for (int i = 0; i < recordsPerThread; i++) {
+                metrics.recordArrival(ARRIVAL_PARKED, 100 + (i & 1023));
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    return elapsedNs(start) / (static_cast<double>(threads) * recordsPerThread);
+}
+
+static void benchMetrics() {
+    const int pairs = 200000;
+    const int depth = 64;
+    
+    cout << "\n[metrics] " << pairs << " 次到达/离开（停车场保持 " << depth << " 辆）" << endl;
+    cout << left << setw(28) << "  运行指标"
+         << right << setw(14) << "ns/对"
+         << setw(16) << "分配/对" << endl;
+    ParkingMetrics metrics;
+    double without = runMetricPairs("  不挂接", nullptr, depth, pairs);
+    double with = runMetricPairs("  挂接ParkingMetrics", &metrics, depth, pairs);
+    cout << "  每次操作增加 " << setprecision(1) << (with - without) / 2 << " ns（含两次计时）" << endl;
+    
+    const int records = 2000000;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < records; i++) {
+        g_sink += ParkingMetrics::now();
+    }
+    cout << "\n[metrics] 单项开销" << endl;
+    cout << "  ParkingMetrics::now      " << setw(8) << elapsedNs(start) / records << " ns/次" << endl;
+    
+    const int threadCounts[] = { 1, 2, 4, 8 };
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        ParkingMetrics shared;
+        double ns = runMetricRecords(shared, threadCounts[i], records / threadCounts[i]);
+        bool complete = shared.getArrivals(ARRIVAL_PARKED) ==
+                        static_cast<uint64_t>(records / threadCounts[i]) * threadCounts[i];
+        cout << "  recordArrival " << threadCounts[i] << " 线程     " << setw(8) << setprecision(1) << ns
+             << " ns/次" << (complete ? "" : "  （计数不完整）") << endl;
+    }
+    
+    DiscardBuffer discard;
+    ostream discardStream(&discard);
+    const int exports = 200;
+    start = BenchClock::now();
+    for (int i = 0; i < exports; i++) {
+        metrics.writePrometheus(discardStream);
+    }
+    cout << "  writePrometheus          " << setw(8) << setprecision(1) << elapsedNs(start) / exports / 1000
+         << " us/次（合并 " << ParkingMetrics::SHARD_COUNT + 1 << " 个分片）" << endl;
+}
+
+// ==================== 操作阶段跟踪开销 ====================
+
+// tracer不为nullptr时挂接阶段跟踪
+static double runTracedPairs(const char* label, ParkingTracer* tracer, int depth, int pairs) {
+    return printPairResult(label, runPairs(depth, pairs,
+        [tracer](ParkingSystem& system) { system.setTracer(tracer); }));
+}
+
+static void benchTracer() {
+    const int pairs = 200000;
+    const int depth = 64;
+    
+    cout << "\n[tracer] " << pairs << " 次到达/离开（停车场保持 " << depth << " 辆）" << endl;
+    cout << left << setw(28) << "  阶段跟踪"
+         << right << setw(14) << "ns/对"
+         << setw(16) << "分配/对" << endl;
+    ParkingTracer tracer(1 << 16);
+    double without = runTracedPairs("  不挂接", nullptr, depth, pairs);
+    double with = runTracedPairs("  挂接ParkingTracer", &tracer, depth, pairs);
+    double spans = static_cast<double>(tracer.count()) / pairs;
+    cout << "  每对记录 " << setprecision(1) << spans << " 个阶段，每个阶段增加 "
+         << (with - without) / spans << " ns（含计时读数）" << endl;
+    
+    DiscardBuffer discard;
+    ostream discardStream(&discard);
+    BenchClock::time_point start = BenchClock::now();
+    uint64_t written = tracer.writeChromeTrace(discardStream);
+    cout << "  writeChromeTrace " << written << " 个阶段 " << setprecision(2) << elapsedNs(start) / 1e6 << " ms" << endl;
+}
+
+// ==================== 多大门并发 ====================
+
+// 每个大门线程反复让自己的一辆车到达、再离开；停车场预先停入depth辆车
+// coarse为true时用一把全局锁串行化整个操作，作为对照（相当于没有细粒度锁时的做法）
+static double runGatePairs(int threads, bool coarse, int depth, int pairsPerThread) {
+    ParkingSystem system(depth + threads, 5.0);
+    system.setParkingSpaces(depth + threads, 0, 0);
+    system.setEventSink(&nullEventSink());
+    for (int i = 0; i < depth; i++) {
+        system.carArrival(makePlate(i), SMALL, 1000);
+    }
+    
+    mutex coarseLock;
+    vector<thread> gates;
+    BenchClock::time_point start = BenchClock::now();
+    for (int t = 0; t < threads; t++) {
+        gates.push_back(thread([&system, &coarseLock, coarse, depth, pairsPerThread, t]() {
+            string plate = makePlate(depth + t);
+            unsigned long long moves = 0;
+            for (int i = 0; i < pairsPerThread; i++) {
+                if (coarse) {
+                    lock_guard<mutex> guard(coarseLock);
+                    system.carArrival(plate, SMALL, 1000);
+                    moves += system.carDeparture(plate, 4600).makeWayCount;
+                } else {
+                    system.carArrival(plate, SMALL, 1000);
+                    moves += system.carDeparture(plate, 4600).makeWayCount;
+                }
+            }
+            g_sink += moves;
+        }));
+    }
+    for (size_t t = 0; t < gates.size(); t++) {
+        gates[t].join();
+    }
+    double ns = elapsedNs(start);
+    return static_cast<double>(threads) * pairsPerThread / (ns / 1e9);
+}
+
+static void benchGates() {
+    const int pairsPerThread = 100000;
+    const int depth = 64;
+    const int threadCounts[] = { 1, 2, 4, 8 };
+    
+    cout << "\n[gates] 每个大门线程 " << pairsPerThread << " 次到达/离开（停车场保持 " << depth
+         << " 辆，硬件线程数 " << thread::hardware_concurrency() << "）" << endl;
+    cout << left << setw(12) << "  大门线程"
+         << right << setw(18) << "细粒度 万对/秒"
+         << setw(12) << "加速比"
+         << setw(18) << "全局锁 万对/秒"
+         << setw(12) << "加速比" << endl;
+    double fineBase = 0, coarseBase = 0;
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        int threads = threadCounts[i];
+        double fine = runGatePairs(threads, false, depth, pairsPerThread);
+        double coarse = runGatePairs(threads, true, depth, pairsPerThread);
+        if (i == 0) {
+            fineBase = fine;
+            coarseBase = coarse;
+        }
+        cout << "  " << left << setw(10) << threads
+             << right << setw(18) << fixed << setprecision(1) << fine / 1e4
+             << setw(12) << setprecision(2) << fine / fineBase
+             << setw(18) << setprecision(1) << coarse / 1e4
+             << setw(12) << setprecision(2) << coarse / coarseBase << endl;
+    }
+}
+
+// ==================== 候车道入口队列 ====================
+
+// 加锁的候车道队列（对照组：每次入队都加锁，消费者加锁后一次取走全部车辆）
+class LockedQueue {
+private:
+    std::mutex lock;
+    Queue queue;
+    
+public:
+    bool tryEnqueue(const Car& car) {
+        lock_guard<mutex> guard(lock);
+        queue.enqueue(car);
+        return true;
+    }
+    
+    int drain() {
+        lock_guard<mutex> guard(lock);
+        int count = 0;
+        while (!queue.isEmpty()) {
+            g_sink += queue.getFront().getVehicleId();
+            queue.dequeue();
+            count++;
+        }
+        return count;
+    }
+};
+
+// 无锁入口队列的消费者：逐个取出，直到暂时为空
+static int drainQueue(LockFreeQueue& queue) {
+    int count = 0;
+    Car car;
+    while (queue.tryDequeue(car)) {
+        g_sink += car.getVehicleId();
+        count++;
+    }
+    return count;
+}
+
+static int drainQueue(LockedQueue& queue) {
+    return queue.drain();
+}
+
+// producers个大门线程各入队perProducer辆车，一个放行线程不断取出；返回每秒入队的车辆数
+template <typename QueueT>
+static double runInboxContention(QueueT& queue, int producers, int perProducer) {
+    vector<thread> gates;
+    BenchClock::time_point start = BenchClock::now();
+    for (int p = 0; p < producers; p++) {
+        gates.push_back(thread([&queue, p, perProducer]() {
+            Car car(makePlate(p), SMALL, 0);
+            for (int i = 0; i < perProducer; i++) {
+                car.setVehicleId(static_cast<uint32_t>(i));
+                while (!queue.tryEnqueue(car)) {
+                    this_thread::yield();   // 有界队列已满，等放行线程取走
+                }
+            }
+        }));
+    }
+    
+    long long total = static_cast<long long>(producers) * perProducer;
+    long long drained = 0;
+    while (drained < total) {
+        int got = drainQueue(queue);
+        if (got == 0) {
+            this_thread::yield();
+        }
+        drained += got;
+    }
+    for (size_t p = 0; p < gates.size(); p++) {
+        gates[p].join();
+    }
+    double ns = elapsedNs(start);
+    return total / (ns / 1e9);
+}
+
+static void benchInbox() {
+    const int perProducer = 200000;
+    const int producerCounts[] = { 1, 2, 4, 8 };
+    
+    cout << "\n[inbox] 每个大门线程入队 " << perProducer << " 辆车，一个放行线程取出（硬件线程数 "
+         << thread::hardware_concurrency() << "）" << endl;
+    cout << left << setw(12) << "  大门线程"
+         << right << setw(22) << "无锁环形队列 万辆/秒"
+         << setw(22) << "加锁Queue 万辆/秒" << endl;
+    for (size_t i = 0; i < sizeof(producerCounts) / sizeof(producerCounts[0]); i++) {
+        int producers = producerCounts[i];
+        LockFreeQueue ring(1024);
+        LockedQueue locked;
+        double ringRate = runInboxContention(ring, producers, perProducer);
+        double lockedRate = runInboxContention(locked, producers, perProducer);
+        cout << "  " << left << setw(10) << producers
+             << right << setw(22) << fixed << setprecision(1) << ringRate / 1e4
+             << setw(22) << lockedRate / 1e4 << endl;
+    }
+}
+
+// ==================== 候车道调度模拟 ====================
+
+// 模拟用的车辆到达记录
+struct SimArrival {
+    int time;       // 到达时间（秒）
+    int type;       // 车型
+    int dwell;      // 停车时长（秒，从进入停车场开始计）
+};
+
+// 生成混合车流（固定种子，各策略使用同一份到达序列）
+// 到达间隔和停车时长服从指数分布，车型按给定比例（百分比）随机抽取
+static vector<SimArrival> makeMixedTraffic(int count, double meanGap, double meanDwell,
+                                           const int mix[3], unsigned int seed) {
+    vector<SimArrival> trace;
+    unsigned int state = seed;
+    double time = 0;
+    for (int i = 0; i < count; i++) {
+        double draws[3];
+        for (int d = 0; d < 3; d++) {
+            // xorshift32
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            draws[d] = (state + 1.0) / 4294967297.0;
+        }
+        
+        time += -log(draws[0]) * meanGap;
+        int roll = static_cast<int>(draws[1] * 100);
+        SimArrival arrival;
+        arrival.time = static_cast<int>(time);
+        arrival.type = roll < mix[0] ? SMALL : (roll < mix[0] + mix[1] ? MEDIUM : LARGE);
+        arrival.dwell = 60 + static_cast<int>(-log(draws[2]) * meanDwell);
+        trace.push_back(arrival);
+    }
+    return trace;
+}
+
+// 原候车道策略：单条队列，出现空位时只看队头，每次离开最多放行一辆
+class HeadOfLineLane {
+private:
+    int spaces[3];
+    int used[3];
+    vector<int> waiting;        // 候车车辆（按到达次序）
+    const vector<SimArrival>& trace;
+    
+public:
+    HeadOfLineLane(const int spaceCounts[3], const vector<SimArrival>& t) : trace(t) {
+        for (int i = 0; i < 3; i++) {
+            spaces[i] = spaceCounts[i];
+            used[i] = 0;
+        }
+    }
+    
+    // 返回true表示直接停入停车场
+    bool arrive(int id) {
+        int type = trace[id].type;
+        if (used[type] < spaces[type]) {
+            used[type]++;
+            return true;
+        }
+        waiting.push_back(id);
+        return false;
+    }
+    
+    void depart(int id, vector<int>& parked) {
+        used[trace[id].type]--;
+        if (!waiting.empty() && used[trace[waiting[0]].type] < spaces[trace[waiting[0]].type]) {
+            used[trace[waiting[0]].type]++;
+            parked.push_back(waiting[0]);
+            waiting.erase(waiting.begin());
+        }
+    }
+    
+    int waitingCount() const { return static_cast<int>(waiting.size()); }
+};
+
+// 分车型候车道：直接驱动ParkingSystem（按给定的车位分配策略）
+// 保留感知策略每种车位保留十分之一（至少1个）给本类型车辆
+template <AllocationPolicyKind Policy>
+class SystemLane {
+private:
+    ParkingSystem system;
+    vector<int> waiting;        // 仍在候车道中的车辆
+    const vector<SimArrival>& trace;
+    
+public:
+    SystemLane(const int spaceCounts[3], const vector<SimArrival>& t)
+        : system(spaceCounts[0] + spaceCounts[1] + spaceCounts[2], 5.0, Policy), trace(t) {
+        system.setParkingSpaces(spaceCounts[0], spaceCounts[1], spaceCounts[2]);
+        system.setSpaceReserve(max(1, spaceCounts[0] / 10), max(1, spaceCounts[1] / 10), max(1, spaceCounts[2] / 10));
+        system.setEventSink(&nullEventSink());
+    }
+    
+    bool arrive(int id) {
+        // 模拟时间不影响调度，车辆记录只需要一个合法的进入时间
+        if (system.carArrival(makePlate(id), trace[id].type, 1000).outcome == ARRIVAL_PARKED) {
+            return true;
+        }
+        waiting.push_back(id);
+        return false;
+    }
+    
+    void depart(int id, vector<int>& parked) {
+        system.carDeparture(makePlate(id), 2000);
+        
+        // 找出本次离开后从候车道进入停车场的车辆
+        for (size_t i = 0; i < waiting.size(); ) {
+            if (system.findCar(makePlate(waiting[i])) == 1) {
+                parked.push_back(waiting[i]);
+                waiting.erase(waiting.begin() + i);
+            } else {
+                i++;
+            }
+        }
+    }
+    
+    int waitingCount() const { return static_cast<int>(waiting.size()); }
+};
+
+// 输出调度模拟结果的表头
+static void printLaneSimHeader() {
+    cout << left << setw(24) << "  策略"
+         << right << setw(14) << "利用率(%)"
+         << setw(18) << "平均等待(分钟)"
+         << setw(18) << "平均候车车辆"
+         << setw(14) << "停入车辆"
+         << setw(14) << "仍在等待" << endl;
+}
+
+// 按时间次序回放到达序列，统计停车场利用率、候车时间和候车道长度（按时间加权平均）
+template <class LaneT>
+static void runLaneSim(const char* label, const int spaces[3], const vector<SimArrival>& trace, int horizon) {
+    LaneT lane(spaces, trace);
+    typedef pair<int, int> Departure;   // (离开时间, 车辆编号)
+    priority_queue<Departure, vector<Departure>, greater<Departure> > departures;
+    vector<int> parked;
+    
+    int capacity = spaces[0] + spaces[1] + spaces[2];
+    int occupied = 0;
+    int served = 0;
+    double waitSum = 0;
+    double occupiedArea = 0;
+    double waitingArea = 0;
+    int lastTime = 0;
+    size_t next = 0;
+    
+    while (true) {
+        bool hasArrival = next < trace.size() && trace[next].time <= horizon;
+        bool hasDeparture = !departures.empty() && departures.top().first <= horizon;
+        if (!hasArrival && !hasDeparture) {
+            break;
+        }
+        
+        // 同一时刻先处理离开，再处理到达
+        int now = (hasDeparture && (!hasArrival || departures.top().first <= trace[next].time))
+                ? departures.top().first : trace[next].time;
+        occupiedArea += static_cast<double>(occupied) * (now - lastTime);
+        waitingArea += static_cast<double>(lane.waitingCount()) * (now - lastTime);
+        lastTime = now;
+        
+        parked.clear();
+        if (hasDeparture && departures.top().first == now) {
+            int id = departures.top().second;
+            departures.pop();
+            occupied--;
+            lane.depart(id, parked);
+        } else {
+            int id = static_cast<int>(next++);
+            if (lane.arrive(id)) {
+                parked.push_back(id);
+            }
+        }
+        
+        for (size_t i = 0; i < parked.size(); i++) {
+            int id = parked[i];
+            occupied++;
+            served++;
+            waitSum += now - trace[id].time;
+            departures.push(Departure(now + trace[id].dwell, id));
+        }
+    }
+    occupiedArea += static_cast<double>(occupied) * (horizon - lastTime);
+    waitingArea += static_cast<double>(lane.waitingCount()) * (horizon - lastTime);
+    
+    cout << left << setw(24) << label
+         << right << setw(14) << fixed << setprecision(1) << 100.0 * occupiedArea / (static_cast<double>(capacity) * horizon)
+         << setw(18) << setprecision(1) << (served > 0 ? waitSum / served / 60 : 0.0)
+         << setw(18) << setprecision(1) << waitingArea / horizon
+         << setw(14) << served
+         << setw(14) << lane.waitingCount() << endl;
+}
+
+static void benchLaneScheduling() {
+    const int horizon = 7 * 24 * 3600;
+    // 车位配置与车型比例（百分比）大致匹配
+    const int spaces[][3] = { { 10, 10, 10 }, { 15, 9, 6 }, { 6, 9, 15 } };
+    const int mixes[][3] = { { 34, 33, 33 }, { 50, 30, 20 }, { 20, 30, 50 } };
+    
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m++) {
+        // 平均每4分钟到达一辆车，平均停车约1小时50分：总负载约为30个车位的92%
+        vector<SimArrival> trace = makeMixedTraffic(horizon / 240, 240, 6600, mixes[m], 2024u + m);
+        
+        cout << "\n[lane] 混合车流候车道调度（车位 " << spaces[m][0] << "/" << spaces[m][1] << "/" << spaces[m][2]
+             << "，车型比例 " << mixes[m][0] << "/" << mixes[m][1] << "/" << mixes[m][2] << "，模拟7天）" << endl;
+        printLaneSimHeader();
+        runLaneSim<HeadOfLineLane>("  单队列只看队头", spaces[m], trace, horizon);
+        runLaneSim<SystemLane<ALLOCATE_STRICT> >("  分车型子队列", spaces[m], trace, horizon);
+    }
+}
+
+// 车位分配策略对比：车位配置与车型比例不匹配时，允许停入低一级车位能减少候车
+static void benchAllocationPolicies() {
+    const int horizon = 7 * 24 * 3600;
+    const int spaces[][3] = { { 10, 10, 10 }, { 10, 10, 10 }, { 15, 9, 6 }, { 12, 12, 6 } };
+    const int mixes[][3] = { { 34, 33, 33 }, { 20, 30, 50 }, { 20, 30, 50 }, { 30, 45, 25 } };
+    
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); m++) {
+        // 与lane测试组相同的负载：平均每4分钟到达一辆车，平均停车约1小时50分
+        vector<SimArrival> trace = makeMixedTraffic(horizon / 240, 240, 6600, mixes[m], 3031u + m);
+        
+        cout << "\n[policy] 车位分配策略（车位 " << spaces[m][0] << "/" << spaces[m][1] << "/" << spaces[m][2]
+             << "，车型比例 " << mixes[m][0] << "/" << mixes[m][1] << "/" << mixes[m][2] << "，模拟7天）" << endl;
+        printLaneSimHeader();
+        runLaneSim<SystemLane<ALLOCATE_STRICT> >("  严格匹配", spaces[m], trace, horizon);
+        runLaneSim<SystemLane<ALLOCATE_BEST_FIT> >("  最佳适配", spaces[m], trace, horizon);
+        runLaneSim<SystemLane<ALLOCATE_RESERVE_AWARE> >("  保留感知", spaces[m], trace, horizon);
+    }
+}
+
+// ==================== 车流轨迹 ====================
+
+// 读完整个轨迹，返回每个事件的平均耗时（纳秒），事件数写入count
+static double readTrace(const char* filename, unsigned long long& count) {
+    TraceReader reader;
+    count = 0;
+    if (!reader.open(filename)) {
+        return 0;
+    }
+    TraceEvent event;
+    unsigned long long checksum = 0;
+    BenchClock::time_point start = BenchClock::now();
+    while (reader.next(event)) {
+        checksum += event.time + event.dwell;
+        count++;
+    }
+    double ns = elapsedNs(start);
+    g_sink += checksum;
+    return count > 0 ? ns / count : 0;
+}
+
+static void benchTrace() {
+    const uint64_t arrivals = 1000000;
+    const char* binaryFile = "bench_trace.bin";
+    const char* textFile = "bench_trace.txt";
+    
+    WorkloadConfig config;
+    config.seed = 2024;
+    config.arrivals = arrivals;
+    config.process = PROCESS_EVENT_DAY;
+    config.dwell = DWELL_LOGNORMAL;
+    
+    // 生成器作为内存中的事件流直接取用
+    WorkloadGenerator generator(config);
+    TraceEvent event;
+    unsigned long long checksum = 0;
+    BenchClock::time_point start = BenchClock::now();
+    while (generator.next(event)) {
+        checksum += event.time;
+    }
+    double generateNs = elapsedNs(start) / arrivals;
+    g_sink += checksum;
+    
+    cout << "\n[trace] " << arrivals << " 个到达事件（活动日到达过程、对数正态停车时长；文件位于页缓存中）" << endl;
+    cout << "  生成（内存中的事件流）：" << fixed << setprecision(1) << generateNs << " ns/事件" << endl;
+    cout << left << setw(20) << "  格式"
+         << right << setw(16) << "文件字节"
+         << setw(16) << "写入(ms)"
+         << setw(16) << "读取ns/事件" << endl;
+    
+    for (int format = 0; format < 2; format++) {
+        bool binary = format == 0;
+        const char* filename = binary ? binaryFile : textFile;
+        
+        generator.restart();
+        TraceWriter writer;
+        start = BenchClock::now();
+        bool written = writer.open(filename, binary, config.seed);
+        while (written && generator.next(event)) {
+            written = writer.write(event);
+        }
+        written = writer.close() && written;
+        double writeMs = elapsedNs(start) / 1e6;
+        
+        unsigned long long count;
+        double readNs = readTrace(filename, count);
+        
+        cout << left << setw(20) << (binary ? "  二进制(mmap)" : "  文本")
+             << right << setw(16) << fileSize(filename)
+             << setw(16) << fixed << setprecision(1) << writeMs
+             << setw(16) << readNs
+             << (written && count == arrivals ? "" : "  （写入或读取失败）") << endl;
+        
+        // 二进制轨迹还可以直接遍历映射的事件数组
+        if (binary) {
+            TraceReader reader;
+            if (reader.open(filename)) {
+                const TraceEvent* events = reader.data();
+                checksum = 0;
+                start = BenchClock::now();
+                for (uint64_t i = 0; i < reader.size(); i++) {
+                    checksum += events[i].time + events[i].dwell;
+                }
+                double scanNs = elapsedNs(start) / arrivals;
+                g_sink += checksum;
+                cout << left << setw(20) << "  二进制(直接遍历)"
+                     << right << setw(16) << "-"
+                     << setw(16) << "-"
+                     << setw(16) << scanNs << endl;
+            }
+        }
+        remove(filename);
+    }
+}
+
+// ==================== 车位占用位图 ====================
+
+// 对照组：每个车位一个字节，逐个车位查找第一个空位
+class ByteSpaceMap {
+private:
+    vector<unsigned char> occupied;
+    
+public:
+    explicit ByteSpaceMap(int count) : occupied(count, 0) {}
+    
+    int acquireFirstFree() {
+        for (size_t i = 0; i < occupied.size(); i++) {
+            if (!occupied[i]) {
+                occupied[i] = 1;
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+    
+    void release(int spaceId) {
+        occupied[spaceId] = 0;
+    }
+    
+    int countOccupied() const {
+        int count = 0;
+        for (size_t i = 0; i < occupied.size(); i++) {
+            count += occupied[i];
+        }
+        return count;
+    }
+};
+
+// 先占满fillPercent%的车位，再反复随机释放一个车位、分配一个车位；返回每次分配+释放和每次计数的纳秒数
+template <typename MapT>
+static void runSpaceChurn(const char* label, int spaces, int fillPercent, int rounds) {
+    MapT map(spaces);
+    vector<int> taken;
+    for (int i = 0; i < spaces * fillPercent / 100; i++) {
+        taken.push_back(map.acquireFirstFree());
+    }
+    
+    srand(7);
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < rounds; i++) {
+        size_t pick = static_cast<size_t>(rand()) % taken.size();
+        map.release(taken[pick]);
+        taken[pick] = map.acquireFirstFree();
+    }
+    double churnNs = elapsedNs(start) / rounds;
+    
+    const int counts = 2000;
+    start = BenchClock::now();
+    for (int i = 0; i < counts; i++) {
+        g_sink += map.countOccupied();
+    }
+    double countNs = elapsedNs(start) / counts;
+    
+    cout << "  " << left << setw(26) << label << right << setw(8) << fillPercent << "%"
+         << setw(16) << fixed << setprecision(1) << churnNs
+         << setw(16) << countNs << endl;
+}
+
+static void benchSpaces() {
+    const int spaces = 65535;
+    const int rounds = 20000;
+    const int fills[] = { 50, 90, 99 };
+    
+    cout << "\n[spaces] " << spaces << " 个车位，随机释放一个再分配编号最小的空位" << endl;
+    cout << left << setw(28) << "  占用记录"
+         << right << setw(9) << "占用率"
+         << setw(16) << "ns/分配+释放"
+         << setw(16) << "ns/计数" << endl;
+    for (size_t i = 0; i < sizeof(fills) / sizeof(fills[0]); i++) {
+        runSpaceChurn<SpaceBitmap>("SpaceBitmap（64位字）", spaces, fills[i], rounds);
+        runSpaceChurn<ByteSpaceMap>("逐车位字节数组", spaces, fills[i], rounds);
+    }
+}
+
+// ==================== 多停车场园区 ====================
+
+// 园区配置：lotCount个停车场，距离各不相同
+static vector<LotConfig> makeFacilityConfigs(int lotCount, int spacesPerType) {
+    vector<LotConfig> configs;
+    for (int i = 0; i < lotCount; i++) {
+        configs.push_back(LotConfig(spacesPerType * 3, 5.0, spacesPerType, spacesPerType, spacesPerType,
+                                    (i * 7) % lotCount));
+    }
+    return configs;
+}
+
+// 在园区上产生随机车流：车辆数低于target时多到达，否则多离开；
+// 返回每次操作的纳秒数，成功的到达/离开按分流结果记入trace（可为nullptr）
+static double runFacilityTraffic(ParkingFacility& facility, int operations, int target,
+                                 unsigned int seed, vector<FacilityEvent>* trace) {
+    srand(seed);
+    vector<string> present;
+    int nextPlate = 0;
+    time_t now = 1000;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < operations; i++) {
+        now += 1;
+        bool arrive = present.empty() || rand() % 100 < (static_cast<int>(present.size()) < target ? 70 : 30);
+        if (arrive) {
+            string plate = makePlate(nextPlate++);
+            int carType = rand() % 3;
+            FacilityArrival arrival = facility.carArrival(plate, carType, now);
+            if (arrival.result.ok()) {
+                present.push_back(plate);
+                if (trace != nullptr) {
+                    FacilityEvent event = { arrival.lot, true, carType, now, plate };
+                    trace->push_back(event);
+                }
+            }
+        } else {
+            size_t pick = static_cast<size_t>(rand()) % present.size();
+            FacilityDeparture departure = facility.carDeparture(present[pick], now);
+            if (departure.result.ok() && trace != nullptr) {
+                FacilityEvent event = { departure.lot, false, 0, now, present[pick] };
+                trace->push_back(event);
+            }
+            present[pick] = present.back();
+            present.pop_back();
+        }
+    }
+    return elapsedNs(start) / operations;
+}
+
+static bool sameOccupancy(const FacilityOccupancy& a, const FacilityOccupancy& b) {
+    return a.used[0] == b.used[0] && a.used[1] == b.used[1] && a.used[2] == b.used[2]
+        && a.parked == b.parked && a.waiting == b.waiting;
+}
+
+static void benchFacility() {
+    const int lotCount = 32;
+    const int spacesPerType = 16;
+    const int operations = 400000;
+    const int target = lotCount * spacesPerType * 3;    // 车辆数略多于车位，部分车辆进入候车道
+    
+    cout << "\n[facility] " << lotCount << " 个停车场（每个 " << spacesPerType * 3 << " 个车位），"
+         << operations << " 次随机到达/离开" << endl;
+    
+    // 分流：每次到达/离开的耗时
+    vector<FacilityEvent> trace;
+    ParkingFacility recorded(makeFacilityConfigs(lotCount, spacesPerType), ROUTE_NEAREST);
+    recorded.setEventSink(&nullEventSink());
+    double nearestNs = runFacilityTraffic(recorded, operations, target, 42, &trace);
+    ParkingFacility balanced(makeFacilityConfigs(lotCount, spacesPerType), ROUTE_LEAST_LOADED);
+    balanced.setEventSink(&nullEventSink());
+    double balancedNs = runFacilityTraffic(balanced, operations, target, 42, nullptr);
+    cout << "  分流 最近停车场      " << fixed << setprecision(1) << setw(10) << nearestNs << " ns/次" << endl;
+    cout << "  分流 最空闲停车场    " << setw(10) << balancedNs << " ns/次" << endl;
+    
+    // 查找：园区登记表 vs 逐个询问各停车场
+    vector<string> plates;
+    for (int lot = 0; lot < recorded.getLotCount(); lot++) {
+        const Stack& cars = recorded.getLot(lot).getParkingLot();
+        for (Stack::const_iterator it = cars.begin(); it != cars.end(); ++it) {
+            plates.push_back(it->getLicensePlate());
+        }
+    }
+    const int lookups = 200000;
+    unsigned long long found = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (int i = 0; i < lookups; i++) {
+        found += recorded.findCar(plates[i % plates.size()]);
+    }
+    double indexedNs = elapsedNs(start) / lookups;
+    start = BenchClock::now();
+    for (int i = 0; i < lookups; i++) {
+        for (int lot = 0; lot < recorded.getLotCount(); lot++) {
+            int location = recorded.getLot(lot).findCar(plates[i % plates.size()]);
+            if (location != 0) {
+                found += location;
+                break;
+            }
+        }
+    }
+    double scanNs = elapsedNs(start) / lookups;
+    g_sink += found;
+    cout << "  查找 园区登记表      " << setw(10) << indexedNs << " ns/次" << endl;
+    cout << "  查找 逐个询问停车场  " << setw(10) << scanNs << " ns/次" << endl;
+    
+    // 整体占用：增量计数 vs 逐个汇总
+    const int polls = 200000;
+    start = BenchClock::now();
+    for (int i = 0; i < polls; i++) {
+        g_sink += recorded.getOccupancy().parked;
+    }
+    double countedNs = elapsedNs(start) / polls;
+    start = BenchClock::now();
+    for (int i = 0; i < polls; i++) {
+        int total = 0;
+        for (int lot = 0; lot < recorded.getLotCount(); lot++) {
+            int small, medium, large, usedSmall, usedMedium, usedLarge;
+            recorded.getLot(lot).getSpaceInfo(small, medium, large, usedSmall, usedMedium, usedLarge);
+            total += usedSmall + usedMedium + usedLarge + recorded.getLot(lot).getWaitingLaneLength();
+        }
+        g_sink += total;
+    }
+    double polledNs = elapsedNs(start) / polls;
+    cout << "  整体占用 增量计数    " << setw(10) << countedNs << " ns/次" << endl;
+    cout << "  整体占用 逐个汇总    " << setw(10) << polledNs << " ns/次" << endl;
+    
+    // 并行重放：按停车场分组在线程池上重放记录的车流
+    cout << "  重放 " << trace.size() << " 条已分流事件（硬件线程数 " << thread::hardware_concurrency() << "）" << endl;
+    const int threadCounts[] = { 1, 2, 4, 8 };
+    double baseMs = 0;
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        ParkingFacility replayed(makeFacilityConfigs(lotCount, spacesPerType), ROUTE_NEAREST);
+        replayed.setEventSink(&nullEventSink());
+        ThreadPool pool(threadCounts[i]);
+        start = BenchClock::now();
+        replayed.replay(trace, pool);
+        double ms = elapsedNs(start) / 1e6;
+        if (i == 0) {
+            baseMs = ms;
+        }
+        bool same = sameOccupancy(replayed.getOccupancy(), recorded.getOccupancy()) && replayed.checkConsistency();
+        cout << "    " << left << setw(4) << threadCounts[i] << "线程" << right << setw(10) << setprecision(1)
+             << ms << " ms  加速比 " << setprecision(2) << baseMs / ms
+             << (same ? "  结果一致" : "  结果不一致") << endl;
+    }
+}
+
+// ==================== 基本操作微基准 ====================
+// 逐项测量栈、队列、计费和车场到达/离开的单次操作开销（耗时、堆分配次数和字节数），
+// 结果可以用 --json 另外写成文件，便于在版本之间对比
+
+// 一项微基准的结果
+struct MicroResult {
+    string name;                // 操作名称
+    int size;                   // 规模（栈、队列或车场中的车辆数）
+    unsigned long long ops;     // 操作次数
+    double nsPerOp;             // 每次操作耗时（纳秒）
+    double allocsPerOp;         // 每次操作的堆分配次数
+    double bytesPerOp;          // 每次操作的堆分配字节数
+};
+
+static vector<MicroResult> g_microResults;
+
+// 操作计量：只累计start/stop之间的耗时和堆分配，准备和恢复数据的部分不计入
+class OpMeter {
+private:
+    BenchClock::time_point started;
+    unsigned long long allocsAtStart;
+    unsigned long long bytesAtStart;
+    double ns;
+    unsigned long long allocs;
+    unsigned long long bytes;
+    unsigned long long ops;
+    
+public:
+    OpMeter() : allocsAtStart(0), bytesAtStart(0), ns(0), allocs(0), bytes(0), ops(0) {}
+    
+    void start() {
+        allocsAtStart = g_allocCount;
+        bytesAtStart = g_allocBytes;
+        started = BenchClock::now();
+    }
+    
+    // 结束一段计量，这段时间内完成了count次操作
+    void stop(unsigned long long count) {
+        ns += elapsedNs(started);
+        allocs += g_allocCount - allocsAtStart;
+        bytes += g_allocBytes - bytesAtStart;
+        ops += count;
+    }
+    
+    // 登记结果并输出一行
+    void report(const char* name, int size) const {
+        MicroResult result;
+        result.name = name;
+        result.size = size;
+        result.ops = ops;
+        result.nsPerOp = ops > 0 ? ns / ops : 0;
+        result.allocsPerOp = ops > 0 ? static_cast<double>(allocs) / ops : 0;
+        result.bytesPerOp = ops > 0 ? static_cast<double>(bytes) / ops : 0;
+        g_microResults.push_back(result);
+        
+        cout << "  " << left << setw(46) << name
+             << right << setw(8) << size
+             << setw(12) << fixed << setprecision(1) << result.nsPerOp
+             << setw(12) << setprecision(3) << result.allocsPerOp
+             << setw(12) << setprecision(1) << result.bytesPerOp << endl;
+    }
+};
+
+// 每个规模下常数时间操作的总次数，以及按规模线性增长的操作（查找、中间移除）的计算量
+static const int MICRO_CONSTANT_OPS = 1000000;
+static const int MICRO_LINEAR_WORK = 20000000;
+
+// 线性操作的次数：规模越大次数越少，至少200次
+static int linearOps(int size) {
+    return max(200, MICRO_LINEAR_WORK / size);
+}
+
+// 栈：整栈压入、整栈弹出、按车牌查找中间的车辆、移除中间的车辆（再压回栈顶保持规模）
+static void microStack(int size) {
+    Stack stack(size);
+    vector<Car> cars;
+    cars.reserve(size);
+    for (int i = 0; i < size; i++) {
+        cars.push_back(Car(makePlate(i), SMALL, 1000 + i));
+    }
+    
+    OpMeter pushMeter;
+    OpMeter popMeter;
+    int rounds = max(1, MICRO_CONSTANT_OPS / size);
+    for (int r = 0; r < rounds; r++) {
+        pushMeter.start();
+        for (int i = 0; i < size; i++) {
+            stack.push(cars[i]);
+        }
+        pushMeter.stop(size);
+        popMeter.start();
+        for (int i = 0; i < size; i++) {
+            stack.pop();
+        }
+        popMeter.stop(size);
+    }
+    pushMeter.report("Stack::push", size);
+    popMeter.report("Stack::pop", size);
+    
+    for (int i = 0; i < size; i++) {
+        stack.push(cars[i]);
+    }
+    const string target = makePlate(size / 2);
+    int ops = linearOps(size);
+    OpMeter findMeter;
+    findMeter.start();
+    for (int k = 0; k < ops; k++) {
+        g_sink += stack.findCar(target);
+    }
+    findMeter.stop(ops);
+    findMeter.report("Stack::findCar(middle)", size);
+    
+    // 栈中间（从栈顶数第size/2+1个）的车辆移除后压回栈顶，栈中的车辆数不变
+    int position = size / 2 + 1;
+    OpMeter removeMeter;
+    removeMeter.start();
+    for (int k = 0; k < ops; k++) {
+        Car car = stack.getCarAt(position);
+        stack.removeCarAt(position);
+        stack.push(car);
+    }
+    removeMeter.stop(ops);
+    removeMeter.report("Stack::removeCarAt(middle)+push", size);
+    g_sink += stack.size();
+}
+
+// 队列：整队入队、整队出队、按车牌查找中间的车辆
+static void microQueue(int size) {
+    Queue queue;
+    queue.reserve(size);
+    vector<Car> cars;
+    cars.reserve(size);
+    for (int i = 0; i < size; i++) {
+        cars.push_back(Car(makePlate(i), SMALL, 1000 + i));
+    }
+    
+    OpMeter enqueueMeter;
+    OpMeter dequeueMeter;
+    int rounds = max(1, MICRO_CONSTANT_OPS / size);
+    for (int r = 0; r < rounds; r++) {
+        enqueueMeter.start();
+        for (int i = 0; i < size; i++) {
+            queue.enqueue(cars[i]);
+        }
+        enqueueMeter.stop(size);
+        dequeueMeter.start();
+        for (int i = 0; i < size; i++) {
+            queue.dequeue();
+        }
+        dequeueMeter.stop(size);
+    }
+    enqueueMeter.report("Queue::enqueue", size);
+    dequeueMeter.report("Queue::dequeue", size);
+    
+    for (int i = 0; i < size; i++) {
+        queue.enqueue(cars[i]);
+    }
+    const string target = makePlate(size / 2);
+    int ops = linearOps(size);
+    OpMeter findMeter;
+    findMeter.start();
+    for (int k = 0; k < ops; k++) {
+        g_sink += queue.findCar(target);
+    }
+    findMeter.stop(ops);
+    findMeter.report("Queue::findCar(middle)", size);
+}
+
+// 计费：已离开的车辆按进出时间计费；仍在场的车辆按当前时间计费
+// （逐辆读取墙上时钟，对比先读一次时钟再计费，即累计费用查询的做法）
+static void microCarFee() {
+    const int count = 1024;
+    vector<Car> departed;
+    vector<Car> parked;
+    for (int i = 0; i < count; i++) {
+        Car car(makePlate(i), static_cast<CarType>(i % 3), 1000 + i);
+        parked.push_back(car);
+        car.setExitTime(1000 + i + 600 + (i * 37) % 20000);
+        departed.push_back(car);
+    }
+    
+    double total = 0;
+    OpMeter departedMeter;
+    departedMeter.start();
+    for (int k = 0; k < MICRO_CONSTANT_OPS * 10; k++) {
+        total += departed[k & (count - 1)].calculateFee(5.0, 0);
+    }
+    departedMeter.stop(MICRO_CONSTANT_OPS * 10);
+    departedMeter.report("Car::calculateFee(departed)", 1);
+    
+    OpMeter parkedMeter;
+    parkedMeter.start();
+    for (int k = 0; k < MICRO_CONSTANT_OPS; k++) {
+        total += parked[k & (count - 1)].calculateFee(5.0, wallClock().now());
+    }
+    parkedMeter.stop(MICRO_CONSTANT_OPS);
+    parkedMeter.report("Car::calculateFee(parked,clock per car)", 1);
+    
+    OpMeter scanMeter;
+    scanMeter.start();
+    time_t now = wallClock().now();
+    for (int k = 0; k < MICRO_CONSTANT_OPS * 10; k++) {
+        total += parked[k & (count - 1)].calculateFee(5.0, now);
+    }
+    scanMeter.stop(MICRO_CONSTANT_OPS * 10);
+    scanMeter.report("Car::calculateFee(parked,one clock read)", 1);
+    g_sink += static_cast<unsigned long long>(total);
+}
+
+// 时间戳格式化：进入时间按到达次序递增、跨越若干天（与逐行显示停车场时相同），
+// 对比逐次调用localtime+strftime与缓存当天日期的formatTimestamp
+static void microTimestamp() {
+    const int count = 4096;
+    vector<time_t> times;
+    time_t start = 1700000000;
+    for (int i = 0; i < count; i++) {
+        times.push_back(start + static_cast<time_t>(i) * 97);
+    }
+    
+    char buffer[32];
+    OpMeter strftimeMeter;
+    strftimeMeter.start();
+    for (int k = 0; k < MICRO_CONSTANT_OPS; k++) {
+        time_t time = times[k & (count - 1)];
+        struct tm* timeinfo = localtime(&time);
+        g_sink += strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
+    }
+    strftimeMeter.stop(MICRO_CONSTANT_OPS);
+    strftimeMeter.report("localtime+strftime", 1);
+    
+    OpMeter formatMeter;
+    formatMeter.start();
+    for (int k = 0; k < MICRO_CONSTANT_OPS * 10; k++) {
+        g_sink += formatTimestamp(times[k & (count - 1)], buffer);
+    }
+    formatMeter.stop(MICRO_CONSTANT_OPS * 10);
+    formatMeter.report("formatTimestamp", 1);
+}
+
+// 车场：停有size辆车时成批到达、再按相反次序离开（每辆都在栈顶，不需要让路），
+// 以及中间的车辆离开（让路约size/2辆）后重新到达
+static void microParkingSystem(int size) {
+    const int batch = 100;
+    ParkingSystem system(size + batch, 5.0);
+    system.setParkingSpaces(0, 0, size + batch);
+    system.setEventSink(&nullEventSink());
+    
+    vector<string> plates;
+    plates.reserve(size + batch);
+    for (int i = 0; i < size + batch; i++) {
+        plates.push_back(makePlate(i));
+    }
+    time_t now = 1000;
+    for (int i = 0; i < size; i++) {
+        system.carArrival(plates[i], LARGE, now++);
+    }
+    if (system.getWaitingLaneLength() != 0) {
+        cout << "  （规模 " << size << " 的停车场未停满，跳过）" << endl;
+        return;
+    }
+    
+    OpMeter arrivalMeter;
+    OpMeter departureMeter;
+    int rounds = max(10, MICRO_CONSTANT_OPS / 5 / batch);
+    for (int r = 0; r < rounds; r++) {
+        arrivalMeter.start();
+        for (int i = 0; i < batch; i++) {
+            g_sink += system.carArrival(plates[size + i], LARGE, now++).outcome;
+        }
+        arrivalMeter.stop(batch);
+        departureMeter.start();
+        for (int i = batch - 1; i >= 0; i--) {
+            g_sink += system.carDeparture(plates[size + i], now++).makeWayCount;
+        }
+        departureMeter.stop(batch);
+    }
+    arrivalMeter.report("ParkingSystem::carArrival", size);
+    departureMeter.report("ParkingSystem::carDeparture(top)", size);
+    
+    // 第half辆车离开后重新到达，停到栈顶；此后下标half处依次是原来的half+1、half+2……，
+    // 上半部分轮转一遍后又回到第half辆
+    int half = size / 2;
+    int ops = max(100, MICRO_LINEAR_WORK / 10 / size);
+    OpMeter middleMeter;
+    middleMeter.start();
+    for (int k = 0; k < ops; k++) {
+        const string& plate = plates[half + k % (size - half)];
+        g_sink += system.carDeparture(plate, now++).makeWayCount;
+        g_sink += system.carArrival(plate, LARGE, now++).outcome;
+    }
+    middleMeter.stop(ops);
+    middleMeter.report("ParkingSystem::carDeparture(middle)+carArrival", size);
+    
+    // 累计费用查询：按模拟时钟扫描整个停车场
+    SimulationClock clock(now);
+    system.setClock(&clock);
+    int scans = max(10, MICRO_LINEAR_WORK / 10 / size);
+    OpMeter accruedMeter;
+    accruedMeter.start();
+    for (int k = 0; k < scans; k++) {
+        g_sink += static_cast<unsigned long long>(system.getAccruedFees());
+    }
+    accruedMeter.stop(scans);
+    accruedMeter.report("ParkingSystem::getAccruedFees", size);
+    system.setClock(nullptr);
+}
+
+static void benchMicro() {
+    cout << "\n[micro] 基本操作（每项单独计时，准备数据不计入）" << endl;
+    cout << "  " << left << setw(46) << "操作"
+         << right << setw(8) << "规模"
+         << setw(12) << "ns/次"
+         << setw(12) << "分配/次"
+         << setw(12) << "字节/次" << endl;
+    
+    const int sizes[] = { 10, 100, 1000, 10000, 100000 };
+    const int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+    for (int s = 0; s < sizeCount; s++) {
+        microStack(sizes[s]);
+    }
+    for (int s = 0; s < sizeCount; s++) {
+        microQueue(sizes[s]);
+    }
+    microCarFee();
+    microTimestamp();
+    for (int s = 0; s < sizeCount; s++) {
+        microParkingSystem(sizes[s]);
+    }
+}
+
+// 把微基准结果写成JSON（操作名称只含ASCII字符，不需要转义）
+static bool writeMicroJson(const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "{\n  \"car_bytes\": %u,\n  \"results\": [", static_cast<unsigned>(sizeof(Car)));
+    for (size_t i = 0; i < g_microResults.size(); i++) {
+        const MicroResult& result = g_microResults[i];
+        fprintf(file, "%s\n    {\"name\": \"%s\", \"size\": %d, \"ops\": %llu, \"ns_per_op\": %.2f, "
+                "\"allocs_per_op\": %.4f, \"bytes_per_op\": %.2f}",
+                i > 0 ? "," : "", result.name.c_str(), result.size, result.ops,
+                result.nsPerOp, result.allocsPerOp, result.bytesPerOp);
+    }
+    fprintf(file, "\n  ]\n}\n");
+    bool ok = !ferror(file);
+    return fclose(file) == 0 && ok;
+}
+
+// ==================== 入口 ====================
+
+struct BenchSuite {
+    const char* name;
+    void (*run)();
+};
+
+static const BenchSuite SUITES[] = {
+    { "car", benchCarLayout },
+    { "queue", benchQueue },
+    { "lot", benchLotFootprint },
+    { "events", benchEventSinks },
+    { "metrics", benchMetrics },
+    { "tracer", benchTracer },
+    { "snapshot", benchSnapshot },
+    { "journal", benchJournal },
+    { "checkpoint", benchCheckpoint },
+    { "gates", benchGates },
+    { "inbox", benchInbox },
+    { "lane", benchLaneScheduling },
+    { "facility", benchFacility },
+    { "spaces", benchSpaces },
+    { "policy", benchAllocationPolicies },
+    { "trace", benchTrace },
+    { "micro", benchMicro }
+};
+
+int main(int argc, char* argv[]) {
+    const int suiteCount = sizeof(SUITES) / sizeof(SUITES[0]);
+    
+    // --json 文件名：运行结束后把微基准结果写入该文件
+    const char* jsonFile = nullptr;
+    vector<const char*> names;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else {
+            names.push_back(argv[i]);
+        }
+    }
+    
+    // 不指定测试组时运行全部测试组，否则只运行指定名称的测试组
+    for (int s = 0; s < suiteCount; s++) {
+        bool selected = names.empty();
+        for (size_t i = 0; i < names.size(); i++) {
+            if (strcmp(names[i], SUITES[s].name) == 0) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            SUITES[s].run();
+        }
+    }
+    
+    if (jsonFile != nullptr) {
+        if (!writeMicroJson(jsonFile)) {
+            cerr << "错误：无法写入 " << jsonFile << endl;
+            return 1;
+        }
+        cout << "\n已写入 " << g_microResults.size() << " 项微基准结果：" << jsonFile << endl;
+    }
+    return 0;
+}
@@ -2,122 +2,174 @@
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <cstring>
+#include <ostream>
 
 using namespace std;
 
-// 캯
-Car::Car() : licensePlate(""), type(SMALL), entryTime(0), exitTime(0), spaceType(SPACE_SMALL) {}
+// 逐字节比较车牌
+bool PlateView::operator==(const PlateView& other) const {
+    return len == other.len && memcmp(ptr, other.ptr, len) == 0;
+}
+
+// 输出车牌（按流的宽度和对齐方式补齐）
+ostream& operator<<(ostream& os, const PlateView& plate) {
+    streamsize width = os.width();
+    streamsize padding = width > static_cast<streamsize>(plate.size())
+                       ? width - static_cast<streamsize>(plate.size()) : 0;
+    bool leftAligned = (os.flags() & ios::adjustfield) == ios::left;
+    os.width(0);
+    
+    if (!leftAligned) {
+        for (streamsize i = 0; i < padding; i++) os.put(os.fill());
+    }
+    os.write(plate.data(), static_cast<streamsize>(plate.size()));
+    if (leftAligned) {
+        for (streamsize i = 0; i < padding; i++) os.put(os.fill());
+    }
+    return os;
+}
+
+// 构造函数
+Car::Car() : entryTime(0), exitTime(0), vehicleId(INVALID_VEHICLE_ID), placement(NO_SPACE_ID) {
+    memset(licensePlate, 0, sizeof(licensePlate));
+}
 
 Car::Car(const string& plate, CarType carType, time_t entry) 
-    : licensePlate(plate), type(carType), entryTime(entry), exitTime(0), spaceType(SPACE_SMALL) {}
+    : entryTime(static_cast<uint32_t>(entry)), exitTime(0), vehicleId(INVALID_VEHICLE_ID),
+      placement(NO_SPACE_ID) {
+    size_t length = plate.size() > static_cast<size_t>(MAX_PLATE_LENGTH)
+                  ? static_cast<size_t>(MAX_PLATE_LENGTH) : plate.size();
+    memset(licensePlate, 0, sizeof(licensePlate));
+    memcpy(licensePlate, plate.data(), length);
+    setField(24, 0x0F, static_cast<uint32_t>(length));
+    setField(28, 0x03, carType);
+}
+
+// 检查车牌能否完整存入车辆记录
+bool Car::isValidPlate(const string& plate) {
+    return !plate.empty() && plate.size() <= static_cast<size_t>(MAX_PLATE_LENGTH);
+}
 
-// ȡƺ
+// 检查车辆记录的各字段是否有效
+bool Car::isValidRecord() const {
+    size_t length = plate().size();
+    return length >= 1 && length <= static_cast<size_t>(MAX_PLATE_LENGTH) &&
+           licensePlate[length] == '\0' &&
+           getType() <= LARGE && getSpaceType() <= SPACE_LARGE;
+}
+
+// 获取车牌号
 string Car::getLicensePlate() const {
-    return licensePlate;
+    return string(licensePlate, plate().size());
 }
 
-// ȡ
+// 获取车型
 CarType Car::getType() const {
-    return type;
+    return static_cast<CarType>(field(28, 0x03));
 }
 
-// ȡַʾ
+// 获取车型字符串表示
 string Car::getTypeString() const {
-    switch(type) {
-        case SMALL: return "Сͳ";
-        case MEDIUM: return "ͳ";
-        case LARGE: return "ͳ";
-        default: return "δ֪";
+    switch(getType()) {
+        case SMALL: return "小型车";
+        case MEDIUM: return "中型车";
+        case LARGE: return "大型车";
+        default: return "未知";
     }
 }
 
-// ȡʱ
+// 获取进入时间
 time_t Car::getEntryTime() const {
     return entryTime;
 }
 
-// 뿪ʱ
+// 设置离开时间
 void Car::setExitTime(time_t exit) {
-    exitTime = exit;
+    exitTime = static_cast<uint32_t>(exit);
 }
 
-// ȡ뿪ʱ
+// 获取离开时间
 time_t Car::getExitTime() const {
     return exitTime;
 }
 
-// óλ
+// 设置车位类型
 void Car::setSpaceType(ParkingSpaceType space) {
-    spaceType = space;
+    setField(30, 0x03, space);
 }
 
-// ȡλ
+// 获取车位类型
 ParkingSpaceType Car::getSpaceType() const {
-    return spaceType;
+    return static_cast<ParkingSpaceType>(field(30, 0x03));
 }
 
-// ȡλַʾ
+// 获取车位类型字符串表示
 string Car::getSpaceTypeString() const {
-    switch(spaceType) {
-        case SPACE_SMALL: return "Сͳλ";
-        case SPACE_MEDIUM: return "ͳλ";
-        case SPACE_LARGE: return "ͳλ";
-        default: return "δ֪";
+    switch(getSpaceType()) {
+        case SPACE_SMALL: return "小型车位";
+        case SPACE_MEDIUM: return "中型车位";
+        case SPACE_LARGE: return "大型车位";
+        default: return "未知";
     }
 }
 
-// ͣʱ룩
-long Car::getParkingDuration() const {
+// 计算停车时长（秒）
+long Car::getParkingDuration(time_t now) const {
     if (exitTime == 0) {
-        // δ뿪ʹõǰʱ
-        time_t now = time(nullptr);
-        return difftime(now, entryTime);
+        // 如果车辆还未离开，使用调用方给出的当前时间
+        return difftime(now, getEntryTime());
     }
-    return difftime(exitTime, entryTime);
+    return difftime(getExitTime(), getEntryTime());
 }
 
-// ãݳͺͳλͣ
-double Car::calculateFee(double hourlyRate) const {
-    // ʣÿСʱhourlyRateԪ
-    // ͬͺͳλвͬķϵ
+// 计算费用（根据车型和车位类型）
+double Car::calculateFee(double hourlyRate, time_t now) const {
+    // 基础费率：每小时hourlyRate元
+    // 不同车型和车位类型有不同的费率系数
     double coefficient = 1.0;
     
-    // ݳ͵ϵ
-    switch(type) {
+    // 根据车型调整系数
+    switch(getType()) {
         case SMALL: coefficient *= 1.0; break;
         case MEDIUM: coefficient *= 1.5; break;
         case LARGE: coefficient *= 2.0; break;
     }
     
-    // ݳλ͵ϵ
-    switch(spaceType) {
+    // 根据车位类型调整系数
+    switch(getSpaceType()) {
         case SPACE_SMALL: coefficient *= 1.0; break;
         case SPACE_MEDIUM: coefficient *= 1.2; break;
         case SPACE_LARGE: coefficient *= 1.5; break;
     }
     
-    // ͣʱСʱ
-    double hours = getParkingDuration() / 3600.0;
+    // 计算停车时长（小时）
+    double hours = getParkingDuration(now) / 3600.0;
     
-    // 1Сʱ1Сʱ
+    // 不足1小时按1小时计算
     if (hours < 1.0) hours = 1.0;
     
-    // 
+    // 计算费用
     return hours * hourlyRate * coefficient;
 }
 
-// 鳵Ƿָͣ͵ĳλ
+// 检查车辆是否可以停放在指定类型的车位
 bool Car::canParkIn(ParkingSpaceType space) const {
-    // һĳһͣλͣ
-    // СͳֻͣСͳλͳͣͺСͳλͳͣССͳλ
+    return canParkIn(getType(), space);
+}
+
+// 检查指定车型是否可以停放在指定类型的车位
+bool Car::canParkIn(CarType carType, ParkingSpaceType space) {
+    // 规则：上一级别的车不能在下一级别的停车位停车
+    // 即：小型车只能停小型车位，中型车可停中型和小型车位，大型车可停大、中、小型车位
     
-    switch(type) {
+    switch(carType) {
         case SMALL:
             return space == SPACE_SMALL;
         case MEDIUM:
             return space == SPACE_SMALL || space == SPACE_MEDIUM;
         case LARGE:
-            return true; // ͳͣκ͵ĳλ
+            return true; // 大型车可以停任何类型的车位
         default:
             return false;
     }
@@ -3,69 +3,151 @@
 
 #include <string>
 #include <ctime>
+#include <cstddef>
+#include <stdint.h>
+#include <iosfwd>
 
-// ö
-enum CarType {
-    SMALL,      // Сͳ
-    MEDIUM,     // ͳ
-    LARGE       // ͳ
+// 车型枚举（1字节存储）
+enum CarType : unsigned char {
+    SMALL,      // 小型车
+    MEDIUM,     // 中型车
+    LARGE       // 大型车
 };
 
-// λö
-enum ParkingSpaceType {
-    SPACE_SMALL,    // Сͳλ
-    SPACE_MEDIUM,   // ͳλ
-    SPACE_LARGE     // ͳλ
+// 车位类型枚举（1字节存储）
+enum ParkingSpaceType : unsigned char {
+    SPACE_SMALL,    // 小型车位
+    SPACE_MEDIUM,   // 中型车位
+    SPACE_LARGE     // 大型车位
 };
 
+// 无效车辆ID（车辆尚未登记车牌）
+const uint32_t INVALID_VEHICLE_ID = 0xFFFFFFFFu;
+
+// 每种车位的最大数量（车位编号以24位存储在车辆记录中，0xFFFFFF表示没有车位）
+const int MAX_SPACES_PER_TYPE = 0xFFFFFF;
+
+// 车牌号只读视图（类似string_view，不拥有内存，不分配堆内存）
+class PlateView {
+private:
+    const char* ptr;    // 指向车牌字符
+    size_t len;         // 车牌长度（字节）
+    
+public:
+    PlateView() : ptr(""), len(0) {}
+    PlateView(const char* p, size_t n) : ptr(p), len(n) {}
+    PlateView(const std::string& s) : ptr(s.data()), len(s.size()) {}
+    
+    const char* data() const { return ptr; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    
+    // 转换为std::string（仅在需要拥有副本时调用）
+    std::string str() const { return std::string(ptr, len); }
+    
+    // 逐字节比较
+    bool operator==(const PlateView& other) const;
+    bool operator!=(const PlateView& other) const { return !(*this == other); }
+};
+
+// 输出车牌（支持setw/left等格式控制）
+std::ostream& operator<<(std::ostream& os, const PlateView& plate);
+
+// 车辆记录
+// 布局紧凑且可平凡复制：车牌内联存储在定长缓冲区中，车位编号、车牌长度、车型和车位类型合用4字节，
+// 时间戳以32位无符号秒数存储（可表示1970~2106年），
+// 因此在停车场和候车道之间移动车辆只是一次memcpy，没有堆分配。
 class Car {
+public:
+    static const int MAX_PLATE_LENGTH = 15;   // 车牌最大字节数（不含结尾'\0'）
+    
 private:
-    std::string licensePlate;  // ƺ
-    CarType type;              // 
-    time_t entryTime;          // ʱ
-    time_t exitTime;           // 뿪ʱ䣨뿪
-    ParkingSpaceType spaceType; // ͣŵĳλ
+    uint32_t entryTime;                         // 进入时间
+    uint32_t exitTime;                          // 离开时间（如果已离开）
+    uint32_t vehicleId;                         // 车辆ID（由PlateRegistry分配）
+    char licensePlate[MAX_PLATE_LENGTH + 1];    // 车牌号（内联存储，'\0'结尾）
+    uint32_t placement;                         // 低24位为停放的车位编号（同类型车位中的序号，未停入停车场时为0xFFFFFF），
+                                                // 24~27位为车牌长度，28~29位为车型，30~31位为停放的车位类型（合用4字节，保持32字节）
+    
+    static const uint32_t NO_SPACE_ID = 0xFFFFFF;   // 没有车位时的车位编号字段
+    
+    // 取得和设置placement中的字段
+    uint32_t field(int shift, uint32_t mask) const { return (placement >> shift) & mask; }
+    void setField(int shift, uint32_t mask, uint32_t value) {
+        placement = (placement & ~(mask << shift)) | ((value & mask) << shift);
+    }
     
 public:
-    // 캯
+    // 构造函数
     Car();
+    // 车牌超过MAX_PLATE_LENGTH字节时会被截断，调用方应先用isValidPlate检查
     Car(const std::string& plate, CarType carType, time_t entry);
     
-    // ȡƺ
+    // 检查车牌能否完整存入车辆记录
+    static bool isValidPlate(const std::string& plate);
+    
+    // 检查车辆记录的各字段是否有效（用于校验从快照文件整块读入的记录）
+    bool isValidRecord() const;
+    
+    // 获取车牌号（返回副本，兼容旧接口）
     std::string getLicensePlate() const;
     
-    // ȡ
+    // 获取车牌号视图（不复制）
+    PlateView plate() const { return PlateView(licensePlate, field(24, 0x0F)); }
+    
+    // 获取车辆ID
+    uint32_t getVehicleId() const { return vehicleId; }
+    
+    // 设置车辆ID
+    void setVehicleId(uint32_t id) { vehicleId = id; }
+    
+    // 获取车型
     CarType getType() const;
     
-    // ȡַʾ
+    // 获取车型字符串表示
     std::string getTypeString() const;
     
-    // ȡʱ
+    // 获取进入时间
     time_t getEntryTime() const;
     
-    // 뿪ʱ
+    // 设置离开时间
     void setExitTime(time_t exit);
     
-    // ȡ뿪ʱ
+    // 获取离开时间
     time_t getExitTime() const;
     
-    // óλ
+    // 设置车位类型
     void setSpaceType(ParkingSpaceType space);
     
-    // ȡλ
+    // 获取车位类型
     ParkingSpaceType getSpaceType() const;
     
-    // ȡλַʾ
+    // 获取车位类型字符串表示
     std::string getSpaceTypeString() const;
     
-    // ͣʱ룩
-    long getParkingDuration() const;
+    // 设置车位编号（-1表示没有车位）
+    void setSpaceId(int id) {
+        setField(0, NO_SPACE_ID, id >= 0 && id < MAX_SPACES_PER_TYPE ? static_cast<uint32_t>(id) : NO_SPACE_ID);
+    }
+    
+    // 获取车位编号（同类型车位中的序号，未停入停车场时为-1）
+    int getSpaceId() const {
+        uint32_t id = field(0, NO_SPACE_ID);
+        return id == NO_SPACE_ID ? -1 : static_cast<int>(id);
+    }
     
-    // ãݳͺͳλͣ
-    double calculateFee(double hourlyRate) const;
+    // 计算停车时长（秒）
+    // 已离开的车辆按离开时间计算；还在场的车辆按调用方给出的当前时间now计算（由ParkingSystem的时钟取得）
+    long getParkingDuration(time_t now) const;
     
-    // 鳵Ƿָͣ͵ĳλ
+    // 计算费用（根据车型和车位类型，停车时长的计算同上）
+    double calculateFee(double hourlyRate, time_t now) const;
+    
+    // 检查车辆是否可以停放在指定类型的车位
     bool canParkIn(ParkingSpaceType space) const;
+    
+    // 检查指定车型是否可以停放在指定类型的车位（车位分配策略使用）
+    static bool canParkIn(CarType carType, ParkingSpaceType space);
 };
 
 #endif // CAR_H
@@ -0,0 +1,65 @@
+#include "CarIndex.h"
+
+using namespace std;
+
+// 确保数组能容纳指定车辆ID
+CarLocation& CarIndex::at(uint32_t vehicleId) {
+    if (vehicleId >= locations.size()) {
+        locations.resize(vehicleId + 1);
+    }
+    return locations[vehicleId];
+}
+
+// 记录车辆停在停车场的指定槽位
+void CarIndex::setLot(uint32_t vehicleId, int slot) {
+    CarLocation& location = at(vehicleId);
+    location.kind = LOCATION_LOT;
+    location.slot = slot;
+    location.node = Queue::NIL;
+    location.lane = 0;
+}
+
+// 记录车辆在候车道指定子队列的指定节点
+void CarIndex::setLane(uint32_t vehicleId, int lane, int node) {
+    CarLocation& location = at(vehicleId);
+    location.kind = LOCATION_LANE;
+    location.slot = -1;
+    location.node = node;
+    location.lane = static_cast<unsigned char>(lane);
+}
+
+// 记录车辆已登记但尚未停入停车场或并入候车道
+void CarIndex::setPending(uint32_t vehicleId) {
+    CarLocation& location = at(vehicleId);
+    location.kind = LOCATION_PENDING;
+    location.slot = -1;
+    location.node = Queue::NIL;
+    location.lane = 0;
+}
+
+// 清除车辆位置
+void CarIndex::erase(uint32_t vehicleId) {
+    if (vehicleId < locations.size()) {
+        locations[vehicleId] = CarLocation();
+    }
+}
+
+// 获取车辆位置
+CarLocation CarIndex::get(uint32_t vehicleId) const {
+    if (vehicleId >= locations.size()) {
+        return CarLocation();
+    }
+    return locations[vehicleId];
+}
+
+// 预先为车辆ID小于idLimit的车辆分配位置记录
+void CarIndex::reserve(uint32_t idLimit) {
+    if (idLimit > locations.size()) {
+        locations.resize(idLimit);
+    }
+}
+
+// 清空索引
+void CarIndex::clear() {
+    locations.clear();
+}
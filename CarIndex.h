@@ -0,0 +1,60 @@
+#ifndef CARINDEX_H
+#define CARINDEX_H
+
+#include "Queue.h"
+#include <vector>
+
+// 车辆所在区域
+enum CarLocationKind : unsigned char {
+    LOCATION_NONE,      // 不在系统中
+    LOCATION_LOT,       // 在停车场
+    LOCATION_LANE,      // 在候车道
+    LOCATION_PENDING    // 已登记，还在候车道入口队列中（或到达操作尚未完成）
+};
+
+// 车辆位置
+struct CarLocation {
+    CarLocationKind kind;       // 所在区域
+    int slot;                   // 停车场槽位（从栈底开始，0表示最北端）
+    int node;                   // 候车道节点下标
+    unsigned char lane;         // 候车道子队列（按车型）
+    
+    CarLocation() : kind(LOCATION_NONE), slot(-1), node(Queue::NIL), lane(0) {}
+};
+
+// 车辆位置索引
+// 与PlateRegistry配合使用：车牌经开放寻址哈希表映射为车辆ID，
+// 再以车辆ID为下标在本索引中取得车辆位置，查找和离开都不再扫描停车场和候车道。
+// 索引由ParkingSystem在每次入栈、出栈、移除、入队和出队时同步更新。
+class CarIndex {
+private:
+    std::vector<CarLocation> locations;     // 车辆ID -> 位置
+    
+public:
+    // 记录车辆停在停车场的指定槽位
+    void setLot(uint32_t vehicleId, int slot);
+    
+    // 记录车辆在候车道指定子队列的指定节点
+    void setLane(uint32_t vehicleId, int lane, int node);
+    
+    // 记录车辆已登记但尚未停入停车场或并入候车道
+    void setPending(uint32_t vehicleId);
+    
+    // 清除车辆位置
+    void erase(uint32_t vehicleId);
+    
+    // 获取车辆位置（未记录的车辆返回LOCATION_NONE）
+    CarLocation get(uint32_t vehicleId) const;
+    
+    // 预先为车辆ID小于idLimit的车辆分配位置记录
+    void reserve(uint32_t idLimit);
+    
+    // 清空索引
+    void clear();
+    
+private:
+    // 确保数组能容纳指定车辆ID
+    CarLocation& at(uint32_t vehicleId);
+};
+
+#endif // CARINDEX_H
@@ -7,11 +7,11 @@
 
 class ConsoleGUI {
 private:
-    // ͼνߴ
+    // 图形界面尺寸
     static const int WIDTH = 80;
     static const int HEIGHT = 24;
     
-    // ɫ루Windows̨
+    // 颜色代码（Windows控制台）
     enum Color {
         BLACK = 0,
         BLUE = 1,
@@ -31,74 +31,74 @@ private:
         BRIGHT_WHITE = 15
     };
     
-    ParkingSystem& parkingSystem; // ͣϵͳ
+    ParkingSystem& parkingSystem; // 停车场系统引用
     
 public:
-    // 캯
+    // 构造函数
     ConsoleGUI(ParkingSystem& system);
     
-    // ʾ
+    // 显示主界面
     void displayMainMenu(const ParkingSystem& system);
     
-    // ʾͣӻ
+    // 显示停车场可视化
     void displayParkingVisualization(const ParkingSystem& system);
     
-    // ʾ򳵵ӻ
+    // 显示候车道可视化
     void displayWaitingLaneVisualization(const ParkingSystem& system);
     
-    // ʾϵͳӻ
+    // 显示完整系统可视化
     void displayFullVisualization(const ParkingSystem& system);
     
-    // ʾ
+    // 显示车辆到达界面
     void displayArrivalInterface();
     
-    // ʾ뿪
+    // 显示车辆离开界面
     void displayDepartureInterface();
     
-    // ʾҳ
+    // 显示查找车辆界面
     void displayFindCarInterface();
     
-    // ʾн
+    // 显示测试数据运行界面
     void displayTestDataInterface();
     
-    // ʾļ
+    // 显示文件操作界面
     void displayFileOperationsInterface();
     
-    // 
+    // 清屏
     void clearScreen();
     
-    // ÿ̨ɫ
+    // 设置控制台颜色
     void setColor(Color foreground, Color background = BLACK);
     
-    // ɫ
+    // 重置颜色
     void resetColor();
     
-    // ָλı
+    // 在指定位置输出文本
     void drawText(int x, int y, const std::string& text);
     
-    // ƾο
+    // 绘制矩形框
     void drawBox(int x, int y, int width, int height, const std::string& title = "");
     
-    // ͣλ
+    // 绘制停车场车位
     void drawParkingSpace(int x, int y, int width, int height, 
                          const std::string& label, 
                          bool occupied, 
                          const std::string& carInfo = "");
     
-    // Ƴ
+    // 绘制车辆
     void drawCar(int x, int y, const std::string& licensePlate, int carType);
     
-    // ƺ򳵵
+    // 绘制候车道
     void drawWaitingLane(int x, int y, int length, const std::vector<std::string>& cars);
     
 private:
-    // ȡɫ
+    // 获取车型颜色
     Color getCarTypeColor(int carType);
     
-    // ȡλɫ
+    // 获取车位类型颜色
     Color getSpaceTypeColor(int spaceType);
     
-    // ȡͷ
+    // 获取车型符号
     std::string getCarTypeSymbol(int carType);
 };
 
@@ -0,0 +1,131 @@
+#include "LockFreeQueue.h"
+
+using namespace std;
+
+// 构造函数
+LockFreeQueue::LockFreeQueue(int capacity) : cells(nullptr), mask(0), enqueuePos(0), dequeuePos(0) {
+    size_t rounded = 2;
+    while (rounded < static_cast<size_t>(capacity)) {
+        rounded <<= 1;
+    }
+    allocate(rounded);
+}
+
+// 复制构造函数
+LockFreeQueue::LockFreeQueue(const LockFreeQueue& other)
+    : cells(nullptr), mask(0), enqueuePos(0), dequeuePos(0) {
+    allocate(other.mask + 1);
+    
+    // 按出队次序复制已写入的单元
+    size_t begin = other.dequeuePos.load(memory_order_relaxed);
+    size_t end = other.enqueuePos.load(memory_order_relaxed);
+    for (size_t pos = begin; pos != end; pos++) {
+        tryEnqueue(other.cells[pos & other.mask].car);
+    }
+}
+
+// 赋值
+LockFreeQueue& LockFreeQueue::operator=(const LockFreeQueue& other) {
+    if (this != &other) {
+        LockFreeQueue copy(other);
+        
+        // 交换缓冲区，原有缓冲区随copy一起释放
+        Cell* oldCells = cells;
+        cells = copy.cells;
+        copy.cells = oldCells;
+        size_t oldMask = mask;
+        mask = copy.mask;
+        copy.mask = oldMask;
+        enqueuePos.store(copy.enqueuePos.load(memory_order_relaxed), memory_order_relaxed);
+        dequeuePos.store(copy.dequeuePos.load(memory_order_relaxed), memory_order_relaxed);
+    }
+    return *this;
+}
+
+// 析构函数
+LockFreeQueue::~LockFreeQueue() {
+    delete[] cells;
+}
+
+// 分配缓冲区并初始化单元序号
+void LockFreeQueue::allocate(size_t capacity) {
+    cells = new Cell[capacity];
+    mask = capacity - 1;
+    for (size_t i = 0; i < capacity; i++) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+// 入队
+bool LockFreeQueue::tryEnqueue(const Car& car) {
+    size_t pos = enqueuePos.load(memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // 单元空闲，领取这个位置（失败时pos被更新为当前的入队位置，重试）
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 单元还没被消费者取走，队列已满
+            return false;
+        } else {
+            // 其他生产者已领取这个位置，重新读取入队位置
+            pos = enqueuePos.load(memory_order_relaxed);
+        }
+    }
+    
+    // 写入车辆后发布单元（顺序一致的写入：随后检查车位的线程与释放车位的线程之间不会互相错过）
+    cell->car = car;
+    cell->sequence.store(pos + 1);
+    return true;
+}
+
+// 出队
+bool LockFreeQueue::tryDequeue(Car& car) {
+    size_t pos = dequeuePos.load(memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        // 顺序一致的读取：与入队时发布单元的写入配合，见入队处的说明
+        cell = &cells[pos & mask];
+        size_t sequence = cell->sequence.load();
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            // 单元已写入，领取这个位置
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // 队列为空，或生产者已领取位置但还没写完
+            return false;
+        } else {
+            // 其他消费者已取走这个位置，重新读取出队位置
+            pos = dequeuePos.load(memory_order_relaxed);
+        }
+    }
+    
+    // 取出车辆后把单元交还给下一轮的生产者
+    car = cell->car;
+    cell->sequence.store(pos + mask + 1, memory_order_release);
+    return true;
+}
+
+// 判断队列是否为空
+bool LockFreeQueue::isEmpty() const {
+    return size() == 0;
+}
+
+// 获取队列中的元素数量
+int LockFreeQueue::size() const {
+    size_t dequeued = dequeuePos.load();
+    size_t enqueued = enqueuePos.load();
+    return enqueued > dequeued ? static_cast<int>(enqueued - dequeued) : 0;
+}
+
+// 获取队列容量
+int LockFreeQueue::capacity() const {
+    return static_cast<int>(mask + 1);
+}
@@ -0,0 +1,71 @@
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include "Car.h"
+#include <atomic>
+#include <cstddef>
+
+// 无锁有界队列（多生产者多消费者，环形缓冲区 + 每个单元的序号）
+// 每个单元带一个序号：序号等于入队位置时单元空闲可写，等于入队位置+1时已写入可读。
+// 入队和出队各自用比较并交换领取位置，然后只读写自己领取的单元，不需要锁。
+//
+// 次序保证：
+// - 队列整体按领取入队位置的次序先进先出，这个次序就是入队操作的线性化次序；
+// - 同一个线程先后入队的两辆车，出队次序与入队次序相同；
+// - 不同线程同时入队的车辆之间，以各自领取到的位置为准，与调用开始的先后无关；
+// - 位置已领取但还没写完的单元会让出队暂时返回"空"，之后的单元不会越过它先出队。
+//
+// 队列满时入队立即返回false（不阻塞、不扩容），由调用方决定退回到加锁的路径。
+class LockFreeQueue {
+private:
+    static const size_t CACHE_LINE = 64;   // 缓存行大小
+    
+    // 缓冲区单元
+    struct Cell {
+        std::atomic<size_t> sequence;   // 单元序号
+        Car car;                        // 车辆数据
+    };
+    
+    Cell* cells;                        // 缓冲区（容量为2的幂）
+    size_t mask;                        // 容量减1（位置对容量取模）
+    
+    // 入队位置和出队位置分别由生产者和消费者修改，用填充隔开放在不同的缓存行中避免伪共享
+    // （C++11不保证动态分配的对象按超过默认值的alignas对齐，这里用显式填充）
+    char headPad[CACHE_LINE];
+    std::atomic<size_t> enqueuePos;
+    char enqueuePad[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePos;
+    char dequeuePad[CACHE_LINE - sizeof(std::atomic<size_t>)];
+    
+public:
+    // 构造函数（容量向上取整为2的幂，至少为2）
+    explicit LockFreeQueue(int capacity = 1024);
+    
+    // 复制构造函数和赋值（复制其中的车辆，只能在没有其他线程访问时调用）
+    LockFreeQueue(const LockFreeQueue& other);
+    LockFreeQueue& operator=(const LockFreeQueue& other);
+    
+    // 析构函数
+    ~LockFreeQueue();
+    
+    // 入队（队列满时返回false）
+    bool tryEnqueue(const Car& car);
+    
+    // 出队（队列为空或队头单元尚未写完时返回false）
+    bool tryDequeue(Car& car);
+    
+    // 判断队列是否为空（其他线程同时入队/出队时只是一个瞬间的近似值）
+    bool isEmpty() const;
+    
+    // 获取队列中的元素数量（近似值，含义同上）
+    int size() const;
+    
+    // 获取队列容量
+    int capacity() const;
+    
+private:
+    // 分配缓冲区并初始化单元序号
+    void allocate(size_t capacity);
+};
+
+#endif // LOCKFREEQUEUE_H
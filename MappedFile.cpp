@@ -0,0 +1,131 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// 构造函数
+MappedFile::MappedFile() : address(nullptr), length(0)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+// 析构函数
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+// 映射指定文件
+bool MappedFile::open(const string& filename) {
+    close();
+    
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    
+    fileHandle = file;
+    mappingHandle = mapping;
+    address = view;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+// 解除映射
+void MappedFile::close() {
+    if (address != nullptr) {
+        UnmapViewOfFile(address);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    address = nullptr;
+    length = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+#else
+
+// 映射指定文件
+bool MappedFile::open(const string& filename) {
+    close();
+    
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后即可关闭文件描述符
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    
+    address = view;
+    length = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+// 解除映射
+void MappedFile::close() {
+    if (address != nullptr) {
+        munmap(const_cast<void*>(address), length);
+    }
+    address = nullptr;
+    length = 0;
+}
+
+#endif
+
+// 判断是否已映射
+bool MappedFile::isOpen() const {
+    return address != nullptr;
+}
+
+// 获取映射的内容
+const void* MappedFile::data() const {
+    return address;
+}
+
+// 获取映射的长度
+size_t MappedFile::size() const {
+    return length;
+}
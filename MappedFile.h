@@ -0,0 +1,45 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+// 只读内存映射文件
+// 把整个文件映射到进程地址空间，读取时直接访问内存，不经过流缓冲和逐字段解析。
+// POSIX平台使用mmap，Windows使用CreateFileMapping/MapViewOfFile。
+class MappedFile {
+private:
+    const void* address;        // 映射起始地址（未打开时为nullptr）
+    size_t length;              // 文件长度（字节）
+#ifdef _WIN32
+    void* fileHandle;           // 文件句柄
+    void* mappingHandle;        // 映射对象句柄
+#endif
+
+public:
+    // 构造函数
+    MappedFile();
+    
+    // 析构函数（自动解除映射）
+    ~MappedFile();
+    
+    // 映射指定文件（空文件或打开失败返回false）
+    bool open(const std::string& filename);
+    
+    // 解除映射
+    void close();
+    
+    // 判断是否已映射
+    bool isOpen() const;
+    
+    // 获取映射的内容和长度
+    const void* data() const;
+    size_t size() const;
+    
+private:
+    // 映射不可复制
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+#endif // MAPPEDFILE_H
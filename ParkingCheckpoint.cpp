@@ -0,0 +1,131 @@
+#include "ParkingCheckpoint.h"
+#include <chrono>
+
+using namespace std;
+
+typedef chrono::steady_clock CheckpointClock;
+
+// 计算从start到现在的毫秒数
+static double elapsedMs(CheckpointClock::time_point start) {
+    return chrono::duration<double, milli>(CheckpointClock::now() - start).count();
+}
+
+// 构造函数
+ParkingCheckpointer::ParkingCheckpointer(const string& snapshotFile)
+    : filename(snapshotFile), source(nullptr), journal(nullptr), finished(false), running(false),
+      written(false), lastResult(true), lastLsn(INVALID_LSN), freezeMs(0), writeMs(0) {
+}
+
+// 析构函数
+ParkingCheckpointer::~ParkingCheckpointer() {
+    wait();
+}
+
+// 开始后台检查点
+bool ParkingCheckpointer::begin(ParkingSystem& system) {
+    poll();
+    if (running) {
+        return false;
+    }
+    
+    // 开始冻结与切换日志段在系统的锁内一起完成，新日志段从冻结时的下一条记录开始
+    CheckpointClock::time_point start = CheckpointClock::now();
+    if (!system.beginFreeze(frozen, true)) {
+        lastResult = false;
+        return false;
+    }
+    source = &system;
+    journal = system.getJournal();
+    freezeMs = elapsedMs(start);
+    
+    finished.store(false);
+    running = true;
+    worker = thread(&ParkingCheckpointer::writeFrozen, this);
+    return true;
+}
+
+// 后台线程：分段复制停车场车辆，重新编号并写入快照
+void ParkingCheckpointer::writeFrozen() {
+    CheckpointClock::time_point start = CheckpointClock::now();
+    for (;;) {
+        CheckpointClock::time_point chunkStart = CheckpointClock::now();
+        bool copied = source->copyFrozenLot(FREEZE_CHUNK_CARS);
+        double chunkMs = elapsedMs(chunkStart);
+        if (chunkMs > freezeMs) {
+            freezeMs = chunkMs;
+        }
+        if (copied) {
+            break;
+        }
+        // 段与段之间释放停车场的锁并让出处理器，等锁的大门线程先拿到锁，不被本线程紧接着的下一段抢先
+        this_thread::yield();
+    }
+    renumberVehicles(frozen);
+    written = writeSnapshot(filename, frozen);
+    writeMs = elapsedMs(start);
+    finished.store(true, memory_order_release);
+}
+
+// 检查后台写入是否已结束
+void ParkingCheckpointer::poll() {
+    if (running && finished.load(memory_order_acquire)) {
+        finish();
+    }
+}
+
+// 等待进行中的检查点结束
+bool ParkingCheckpointer::wait() {
+    if (running) {
+        finish();
+    }
+    return lastResult;
+}
+
+// 写入线程结束后收尾
+void ParkingCheckpointer::finish() {
+    worker.join();
+    running = false;
+    lastResult = written;
+    
+    // 快照已经落盘，旧日志段中的记录都已包含在其中；写入失败时保留旧日志段，恢复时照常重放
+    if (written) {
+        lastLsn = frozen.journalLsn;
+        if (journal != nullptr) {
+            journal->dropRotated();
+        }
+    }
+    journal = nullptr;
+    source = nullptr;
+}
+
+// 同步检查点
+bool ParkingCheckpointer::checkpointNow(ParkingSystem& system) {
+    // 进行中的后台检查点写的是更早的状态，先等它结束，避免它覆盖之后的快照
+    wait();
+    lastResult = system.checkpoint(filename);
+    if (lastResult) {
+        ParkingJournal* current = system.getJournal();
+        lastLsn = current != nullptr ? current->lastLsn() : INVALID_LSN;
+    }
+    return lastResult;
+}
+
+// 判断是否有检查点在进行
+bool ParkingCheckpointer::inProgress() const {
+    return running;
+}
+
+// 获取最近一次成功的检查点包含的最后一条日志记录的序号
+uint32_t ParkingCheckpointer::lastCheckpointLsn() const {
+    return lastLsn;
+}
+
+// 获取最近一次后台检查点冻结状态时最长一次持锁的耗时
+double ParkingCheckpointer::lastFreezeMs() const {
+    return freezeMs;
+}
+
+// 获取最近一次后台检查点复制停车场和写入文件的耗时
+double ParkingCheckpointer::lastWriteMs() const {
+    return writeMs;
+}
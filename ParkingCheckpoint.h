@@ -0,0 +1,77 @@
+#ifndef PARKINGCHECKPOINT_H
+#define PARKINGCHECKPOINT_H
+
+#include "ParkingSystem.h"
+#include <string>
+#include <thread>
+#include <atomic>
+
+// 检查点写入器
+// 后台检查点分两步：在调用线程上开始分段冻结（锁内只复制配置和候车道、记下停车场的车辆数）并切换日志段，
+// 然后由后台线程分段复制冻结的停车场车辆（每段FREEZE_CHUNK_CARS辆，段与段之间释放停车场的锁），
+// 再重新编号、计算校验和、写入并同步快照文件。复制期间离开的车辆让路之前先保存会被挪动的冻结车辆，
+// 快照仍是冻结时刻的状态。写入完成后删除切换出去的旧日志段；冻结之后的变更写在新的日志段中，恢复时接着快照重放。
+// 大门线程最多等待一段的复制（或一次候车道复制），不再等待整个停车场的复制；写文件和fsync都在后台进行。
+// 同一时间只进行一个检查点；冻结缓冲区在多次检查点之间复用，不重新分配。
+class ParkingCheckpointer {
+private:
+    static const int FREEZE_CHUNK_CARS = 4096;     // 后台线程每次持锁复制的停车场车辆数
+    
+    std::string filename;           // 检查点快照文件
+    ParkingSystem* source;          // 进行中的检查点冻结的系统
+    ParkingSnapshot frozen;         // 冻结的状态（后台线程写入期间只由后台线程访问）
+    ParkingJournal* journal;        // 本次检查点切换过日志段的日志（可能为nullptr）
+    std::thread worker;             // 后台写入线程
+    std::atomic<bool> finished;     // 后台写入是否已结束
+    bool running;                   // 是否有检查点在进行
+    bool written;                   // 后台写入结果（写入线程结束后才读取）
+    bool lastResult;                // 最近一次完成的检查点是否成功
+    uint32_t lastLsn;               // 最近一次成功的检查点包含的最后一条日志记录的序号
+    double freezeMs;                // 最近一次冻结状态时最长一次持锁的耗时（开始冻结或复制一段，毫秒）
+    double writeMs;                 // 最近一次后台写入的耗时（毫秒）
+    
+public:
+    // 构造函数
+    explicit ParkingCheckpointer(const std::string& snapshotFile);
+    
+    // 析构函数（等待进行中的检查点结束）
+    ~ParkingCheckpointer();
+    
+    // 开始后台检查点：冻结系统状态、切换日志段，然后立即返回
+    // 已有检查点在进行或切换日志段失败时返回false；检查点结束之前系统不能销毁
+    bool begin(ParkingSystem& system);
+    
+    // 检查后台写入是否已结束（不阻塞），已结束则收尾（删除旧日志段）
+    void poll();
+    
+    // 等待进行中的检查点结束并收尾，返回最近一次检查点是否成功
+    bool wait();
+    
+    // 同步检查点：等待进行中的检查点结束后，把当前状态保存为快照并清空日志
+    // 状态被整体替换（加载文件等）后使用，旧的日志记录不再有效
+    bool checkpointNow(ParkingSystem& system);
+    
+    // 判断是否有检查点在进行
+    bool inProgress() const;
+    
+    // 获取最近一次成功的检查点包含的最后一条日志记录的序号
+    uint32_t lastCheckpointLsn() const;
+    
+    // 获取最近一次后台检查点冻结状态时最长一次持锁（开始冻结或复制一段，大门线程最多等待这么久）
+    // 和后台复制、写入文件的耗时（毫秒，检查点结束后读取）
+    double lastFreezeMs() const;
+    double lastWriteMs() const;
+    
+private:
+    // 后台线程：分段复制停车场车辆，重新编号并写入快照
+    void writeFrozen();
+    
+    // 写入线程结束后收尾
+    void finish();
+    
+    // 检查点写入器不可复制
+    ParkingCheckpointer(const ParkingCheckpointer&);
+    ParkingCheckpointer& operator=(const ParkingCheckpointer&);
+};
+
+#endif // PARKINGCHECKPOINT_H
@@ -0,0 +1,23 @@
+#include "ParkingClock.h"
+
+using namespace std;
+
+// 墙上时钟：读取系统时间
+time_t WallClock::now() const {
+    return time(nullptr);
+}
+
+// 单调时钟：记下创建时的系统时间和单调时钟读数
+MonotonicClock::MonotonicClock() : origin(time(nullptr)), start(chrono::steady_clock::now()) {}
+
+// 单调时钟：创建时的系统时间加上之后流逝的整秒数
+time_t MonotonicClock::now() const {
+    chrono::steady_clock::duration elapsed = chrono::steady_clock::now() - start;
+    return origin + static_cast<time_t>(chrono::duration_cast<chrono::seconds>(elapsed).count());
+}
+
+// 共享的墙上时钟
+Clock& wallClock() {
+    static WallClock clock;
+    return clock;
+}
@@ -0,0 +1,66 @@
+#ifndef PARKINGCLOCK_H
+#define PARKINGCLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+
+// 时钟：ParkingSystem计算在场车辆的停车时长和应收费用时读取“现在”的来源
+// 挂接到ParkingSystem后（setClock），累计费用的查询在开始时读取一次时钟，扫描整个停车场不再逐辆读取系统时间；
+// 命令行界面和图形界面没有输入时间时也从系统的时钟取得当前时间。
+// 轨迹模拟使用手动推进的模拟时钟，查询结果只取决于事件时间，重放可以复现。
+class Clock {
+public:
+    virtual ~Clock() {}
+    
+    // 获取当前时间（与time_t相同的秒数）
+    virtual time_t now() const = 0;
+};
+
+// 墙上时钟：每次读取系统时间（随系统时间的调整而跳变）
+class WallClock : public Clock {
+public:
+    time_t now() const;
+};
+
+// 单调时钟：创建时读取一次系统时间，之后按单调时钟的流逝推进
+// 系统时间被调整（校时、手动修改）时不会倒退，停车时长不会出现负数
+class MonotonicClock : public Clock {
+private:
+    time_t origin;                                  // 创建时的系统时间
+    std::chrono::steady_clock::time_point start;    // 创建时的单调时钟读数
+    
+public:
+    MonotonicClock();
+    
+    time_t now() const;
+};
+
+// 模拟时钟：只在调用set/advance时推进，模拟器按事件时间设置
+// 读取和设置可以在不同线程同时进行
+class SimulationClock : public Clock {
+private:
+    std::atomic<long long> current;     // 当前时间
+    
+public:
+    explicit SimulationClock(time_t start = 0) : current(static_cast<long long>(start)) {}
+    
+    time_t now() const {
+        return static_cast<time_t>(current.load(std::memory_order_relaxed));
+    }
+    
+    // 设置当前时间
+    void set(time_t time) {
+        current.store(static_cast<long long>(time), std::memory_order_relaxed);
+    }
+    
+    // 推进指定的秒数
+    void advance(long long seconds) {
+        current.fetch_add(seconds, std::memory_order_relaxed);
+    }
+};
+
+// 共享的墙上时钟（ParkingSystem的默认时钟）
+Clock& wallClock();
+
+#endif // PARKINGCLOCK_H
@@ -0,0 +1,176 @@
+#include "ParkingEvents.h"
+#include "TimestampFormat.h"
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+
+using namespace std;
+
+// ==================== ConsoleEventSink ====================
+
+ConsoleEventSink::ConsoleEventSink(ostream& stream) : out(stream) {}
+
+// 车辆到达
+void ConsoleEventSink::onArrival(const PlateView& plate, const ArrivalResult& result) {
+    switch (result.outcome) {
+        case ARRIVAL_PARKED: {
+            const char* spaceNames[] = { "小型车位", "中型车位", "大型车位" };
+            out << "车辆 " << plate << " 已停入停车场，车位类型："
+                << spaceNames[result.spaceType] << "，车位编号：" << result.spaceId << "\n";
+            
+            // 新车停在最靠近大门的位置，不会挡住其他车辆，也没有车辆挡住它
+            out << "车辆排列：按到达时间从北向南排列，大门在最南端\n";
+            out << "（新车停在最靠近大门的位置，无需其他车辆让路）\n";
+            break;
+        }
+        case ARRIVAL_WAITING:
+            out << "暂无合适车位，车辆 " << plate << " 已进入候车道等待\n";
+            break;
+        case ARRIVAL_INVALID_PLATE:
+            out << "错误：车牌号长度必须在1到" << Car::MAX_PLATE_LENGTH << "字节之间！\n";
+            break;
+        case ARRIVAL_INVALID_TYPE:
+            out << "错误：车型无效！\n";
+            break;
+        case ARRIVAL_DUPLICATE:
+            out << "错误：车牌号 " << plate << " 已存在！\n";
+            break;
+        case ARRIVAL_NO_SPACE:
+            out << "错误：停车场已满！\n";
+            break;
+    }
+    out.flush();
+}
+
+// 车辆离开
+void ConsoleEventSink::onDeparture(const PlateView& plate, const DepartureResult& result) {
+    if (result.outcome == DEPARTURE_NOT_FOUND) {
+        out << "错误：车牌号 " << plate << " 不存在！\n";
+    } else if (result.outcome == DEPARTURE_FROM_LANE) {
+        // 候车道中的车辆不收费
+        out << "车辆 " << plate << " 从候车道中离开，不收费\n";
+    } else {
+        // 显示费用信息
+        const Car& car = result.car;
+        out << "\n==========================================\n";
+        out << "车辆离开信息：\n";
+        out << "车牌号：" << car.plate() << "\n";
+        out << "车型：" << car.getTypeString() << "\n";
+        out << "车位类型：" << car.getSpaceTypeString() << "\n";
+        out << "车位编号：" << car.getSpaceId() << "\n";
+        char entryTime[TIMESTAMP_BUFFER_SIZE];
+        char exitTime[TIMESTAMP_BUFFER_SIZE];
+        formatTimestamp(car.getEntryTime(), entryTime);
+        formatTimestamp(car.getExitTime(), exitTime);
+        out << "进入时间：" << entryTime << "\n";
+        out << "离开时间：" << exitTime << "\n";
+        out << "停车时长：" << result.duration / 3600 << "小时" << result.duration % 3600 / 60 << "分钟\n";
+        out << "应付费用：" << fixed << setprecision(2) << result.fee << "元\n";
+        out << "==========================================\n";
+        
+        // 显示让路过程
+        writeMakeWay(result);
+    }
+    out.flush();
+}
+
+// 候车道车辆进入停车场
+void ConsoleEventSink::onLaneAdmitted(const Car& car) {
+    out << "提示：候车道车辆 " << car.plate()
+        << " 已进入停车场，车位类型：" << car.getSpaceTypeString()
+        << "，车位编号：" << car.getSpaceId() << "\n";
+    out.flush();
+}
+
+// 显示车辆离开时的让路过程
+void ConsoleEventSink::writeMakeWay(const DepartureResult& result) {
+    const MakeWayMove* moves = result.makeWayMoves;
+    int count = result.makeWayCount;
+    
+    out << "\n=== 车辆离开让路过程 ===\n";
+    
+    // 1. 目标车辆之后的车辆按次序（从靠近大门的车开始）进入临时候车站
+    out << "步骤1: 目标车辆之后的车辆按次序进入临时候车站让路\n";
+    for (int i = 0; i < count; i++) {
+        out << "  - 车辆 " << moves[i].plate << "（在目标车辆之后开入）进入临时候车站让路\n";
+    }
+    
+    // 显示被牵连车辆进出候车道顺序
+    if (count > 0) {
+        out << "被牵连车辆进入候车道顺序（从前往后）：";
+        for (int i = 0; i < count; i++) {
+            out << moves[i].plate;
+            if (i < count - 1) out << " → ";
+        }
+        out << "\n";
+    }
+    
+    // 2. 目标车辆开出
+    out << "步骤2: 目标车辆 " << result.car.plate() << " 开出大门外\n";
+    
+    // 3. 让路车辆按相反次序回到停车场（最后出去的最先回来，保持原有南北次序）
+    out << "步骤3: 让路的车辆按原次序从临时候车站进入车场\n";
+    for (int i = count; i > 0; i--) {
+        out << "  - 车辆 " << moves[i - 1].plate << " 从临时候车站按原次序回到停车场\n";
+    }
+    
+    // 显示被牵连车辆重新进入停车场顺序
+    if (count > 0) {
+        out << "被牵连车辆重新进入停车场顺序（从前往后）：";
+        for (int i = count; i > 0; i--) {
+            out << moves[i - 1].plate;
+            if (i > 1) out << " → ";
+        }
+        out << "\n";
+    }
+    
+    out << "=== 让路过程完成 ===\n";
+}
+
+// ==================== BufferedEventSink ====================
+
+BufferedEventSink::BufferedEventSink() : console(buffer) {}
+
+void BufferedEventSink::onArrival(const PlateView& plate, const ArrivalResult& result) {
+    console.onArrival(plate, result);
+}
+
+void BufferedEventSink::onDeparture(const PlateView& plate, const DepartureResult& result) {
+    console.onDeparture(plate, result);
+}
+
+void BufferedEventSink::onLaneAdmitted(const Car& car) {
+    console.onLaneAdmitted(car);
+}
+
+// 获取缓冲区内容
+string BufferedEventSink::str() const {
+    return buffer.str();
+}
+
+// 把缓冲区内容写到输出流并清空缓冲区
+void BufferedEventSink::flushTo(ostream& stream) {
+    stream << buffer.str();
+    stream.flush();
+    clear();
+}
+
+// 清空缓冲区
+void BufferedEventSink::clear() {
+    buffer.str(string());
+    buffer.clear();
+}
+
+// ==================== 共享接收器 ====================
+
+// 输出到std::cout的共享控制台接收器
+ParkingEventSink& consoleEventSink() {
+    static ConsoleEventSink sink(cout);
+    return sink;
+}
+
+// 共享的空接收器
+ParkingEventSink& nullEventSink() {
+    static NullEventSink sink;
+    return sink;
+}
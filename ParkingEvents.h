@@ -0,0 +1,138 @@
+#ifndef PARKINGEVENTS_H
+#define PARKINGEVENTS_H
+
+#include "Car.h"
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// 让路步骤
+// 车辆离开时，在它之后开入的车辆要先开出大门让路，再按原次序回到停车场。
+// 停车场原地移除目标车辆，让路车辆各向北挪动一个槽位。
+struct MakeWayMove {
+    uint32_t vehicleId;         // 让路车辆ID
+    int fromSlot;               // 让路前的槽位（从栈底开始计数）
+    int toSlot;                 // 回到停车场后的槽位
+    PlateView plate;            // 让路车辆车牌（指向调用线程的暂存区，该线程下一次离开操作前有效）
+};
+
+// 车辆到达结果
+enum ArrivalOutcome : unsigned char {
+    ARRIVAL_PARKED,             // 停入停车场
+    ARRIVAL_WAITING,            // 进入候车道
+    ARRIVAL_INVALID_PLATE,      // 车牌号长度无效
+    ARRIVAL_INVALID_TYPE,       // 车型无效
+    ARRIVAL_DUPLICATE,          // 车牌号已存在
+    ARRIVAL_NO_SPACE            // 无法分配车位
+};
+
+struct ArrivalResult {
+    ArrivalOutcome outcome;         // 到达结果
+    ParkingSpaceType spaceType;     // 分配的车位类型（仅停入停车场时有效）
+    int spaceId;                    // 分配的车位编号（同类型车位中的序号，未停入停车场时为-1）
+    uint32_t vehicleId;             // 车辆ID（失败时为INVALID_VEHICLE_ID）
+    int slot;                       // 停车场槽位（从栈底开始计数，未停入停车场时为-1）
+    
+    ArrivalResult() : outcome(ARRIVAL_NO_SPACE), spaceType(SPACE_SMALL), spaceId(-1),
+                      vehicleId(INVALID_VEHICLE_ID), slot(-1) {}
+    
+    // 车辆是否已进入停车场或候车道
+    bool ok() const { return outcome == ARRIVAL_PARKED || outcome == ARRIVAL_WAITING; }
+};
+
+// 车辆离开结果
+enum DepartureOutcome : unsigned char {
+    DEPARTURE_FROM_LOT,         // 从停车场离开
+    DEPARTURE_FROM_LANE,        // 从候车道离开（不收费）
+    DEPARTURE_NOT_FOUND         // 车辆不存在
+};
+
+struct DepartureResult {
+    DepartureOutcome outcome;           // 离开结果
+    Car car;                            // 离开的车辆记录（已设置离开时间）
+    double fee;                         // 应付费用
+    long duration;                      // 停车时长（秒）
+    const MakeWayMove* makeWayMoves;    // 让路步骤（按开出大门的次序，指向系统内部缓冲区，下一次离开前有效）
+    int makeWayCount;                   // 让路车辆数
+    
+    DepartureResult() : outcome(DEPARTURE_NOT_FOUND), fee(0), duration(0),
+                        makeWayMoves(nullptr), makeWayCount(0) {}
+    
+    // 车辆是否已离开
+    bool ok() const { return outcome != DEPARTURE_NOT_FOUND; }
+};
+
+// 停车场事件接收器
+// 核心操作只产生结构化的结果，显示和记录交给事件接收器：
+// 基准测试和批量模拟使用NullEventSink，命令行和图形界面使用ConsoleEventSink，
+// 需要稍后统一输出（或嵌入其他程序）时使用BufferedEventSink。
+class ParkingEventSink {
+public:
+    virtual ~ParkingEventSink() {}
+    
+    // 车辆到达（包括失败的到达）
+    virtual void onArrival(const PlateView& plate, const ArrivalResult& result) = 0;
+    
+    // 车辆离开（包括失败的离开），在候车道车辆补位之前发出
+    virtual void onDeparture(const PlateView& plate, const DepartureResult& result) = 0;
+    
+    // 候车道车辆进入停车场
+    virtual void onLaneAdmitted(const Car& car) = 0;
+};
+
+// 丢弃所有事件
+class NullEventSink : public ParkingEventSink {
+public:
+    void onArrival(const PlateView&, const ArrivalResult&) {}
+    void onDeparture(const PlateView&, const DepartureResult&) {}
+    void onLaneAdmitted(const Car&) {}
+};
+
+// 按原有的控制台格式输出事件
+// 每个事件只在结束时刷新一次输出流，而不是每行刷新一次
+class ConsoleEventSink : public ParkingEventSink {
+private:
+    std::ostream& out;          // 输出流
+    
+public:
+    explicit ConsoleEventSink(std::ostream& stream);
+    
+    void onArrival(const PlateView& plate, const ArrivalResult& result);
+    void onDeparture(const PlateView& plate, const DepartureResult& result);
+    void onLaneAdmitted(const Car& car);
+    
+private:
+    // 显示车辆离开时的让路过程
+    void writeMakeWay(const DepartureResult& result);
+};
+
+// 把事件按控制台格式写入内存缓冲区，由调用方决定何时输出
+class BufferedEventSink : public ParkingEventSink {
+private:
+    std::ostringstream buffer;  // 缓冲区
+    ConsoleEventSink console;   // 写入缓冲区的格式化器
+    
+public:
+    BufferedEventSink();
+    
+    void onArrival(const PlateView& plate, const ArrivalResult& result);
+    void onDeparture(const PlateView& plate, const DepartureResult& result);
+    void onLaneAdmitted(const Car& car);
+    
+    // 获取缓冲区内容
+    std::string str() const;
+    
+    // 把缓冲区内容写到输出流并清空缓冲区
+    void flushTo(std::ostream& stream);
+    
+    // 清空缓冲区
+    void clear();
+};
+
+// 输出到std::cout的共享控制台接收器（ParkingSystem的默认接收器）
+ParkingEventSink& consoleEventSink();
+
+// 共享的空接收器
+ParkingEventSink& nullEventSink();
+
+#endif // PARKINGEVENTS_H
@@ -0,0 +1,390 @@
+#include "ParkingFacility.h"
+#include <algorithm>
+
+using namespace std;
+
+// 车辆到达：停入停车场时占用计数加一，进入候车道时候车计数加一
+void ParkingFacility::LotStats::onArrival(const PlateView& plate, const ArrivalResult& result) {
+    if (result.outcome == ARRIVAL_PARKED) {
+        parked.add(1);
+        facility->parkedCars.add(1);
+        facility->usedSpaces[result.spaceType].add(1);
+    } else if (result.outcome == ARRIVAL_WAITING) {
+        waiting.add(1);
+        facility->waitingCars.add(1);
+    }
+    facility->sink->onArrival(plate, result);
+}
+
+// 车辆离开：按离开位置减少对应的计数
+void ParkingFacility::LotStats::onDeparture(const PlateView& plate, const DepartureResult& result) {
+    if (result.outcome == DEPARTURE_FROM_LOT) {
+        parked.add(-1);
+        facility->parkedCars.add(-1);
+        facility->usedSpaces[result.car.getSpaceType()].add(-1);
+    } else if (result.outcome == DEPARTURE_FROM_LANE) {
+        waiting.add(-1);
+        facility->waitingCars.add(-1);
+    }
+    facility->sink->onDeparture(plate, result);
+}
+
+// 候车道车辆进入停车场：候车计数减一，占用计数加一
+void ParkingFacility::LotStats::onLaneAdmitted(const Car& car) {
+    waiting.add(-1);
+    parked.add(1);
+    facility->waitingCars.add(-1);
+    facility->parkedCars.add(1);
+    facility->usedSpaces[car.getSpaceType()].add(1);
+    facility->sink->onLaneAdmitted(car);
+}
+
+// 创建停车场
+ParkingFacility::Lot::Lot(const LotConfig& config)
+    : system(config.capacity, config.hourlyRate, config.allocation), distance(config.distance) {
+    system.setParkingSpaces(config.spaces[0], config.spaces[1], config.spaces[2]);
+}
+
+// 构造函数
+ParkingFacility::ParkingFacility(const vector<LotConfig>& configs, RoutingPolicy routing)
+    : policy(routing), sink(&consoleEventSink()) {
+    totals.capacity = 0;
+    for (int t = 0; t < 3; t++) {
+        totals.spaces[t] = 0;
+        totals.used[t] = 0;
+    }
+    totals.parked = 0;
+    totals.waiting = 0;
+    
+    for (size_t i = 0; i < configs.size(); i++) {
+        Lot* lot = new Lot(configs[i]);
+        lot->stats.facility = this;
+        lot->system.setEventSink(&lot->stats);
+        lots.push_back(lot);
+        nearestOrder.push_back(static_cast<int>(i));
+        
+        // 按停车场实际采用的配置统计（车位配置被拒绝时该停车场按容量平均分配）
+        int spaces[3];
+        int used[3];
+        lot->system.getSpaceInfo(spaces[0], spaces[1], spaces[2], used[0], used[1], used[2]);
+        totals.capacity += lot->system.getTotalCapacity();
+        for (int t = 0; t < 3; t++) {
+            totals.spaces[t] += spaces[t];
+        }
+    }
+    
+    // 按距离排序（距离相同时保持配置次序）
+    for (size_t i = 1; i < nearestOrder.size(); i++) {
+        int current = nearestOrder[i];
+        size_t j = i;
+        while (j > 0 && lots[nearestOrder[j - 1]]->distance > lots[current]->distance) {
+            nearestOrder[j] = nearestOrder[j - 1];
+            j--;
+        }
+        nearestOrder[j] = current;
+    }
+}
+
+// 析构函数
+ParkingFacility::~ParkingFacility() {
+    for (size_t i = 0; i < lots.size(); i++) {
+        delete lots[i];
+    }
+}
+
+// 停车场lot中carType车型可用的车位数
+int ParkingFacility::freeSpacesFor(int lot, int carType) const {
+    const Lot& target = *lots[lot];
+    
+    // 按该停车场的分配策略统计（允许停入低一级车位时也计入）
+    int freeOfType = target.system.getFreeSpacesFor(carType);
+    
+    // 车位总数可能超过停车场容量，还要受容量限制
+    int freeOfLot = target.system.getTotalCapacity() - target.stats.parked.load();
+    return min(freeOfType, freeOfLot);
+}
+
+// 选择停车场
+int ParkingFacility::route(int carType) const {
+    int best = -1;
+    int bestFree = 0;
+    for (size_t k = 0; k < nearestOrder.size(); k++) {
+        int lot = nearestOrder[k];
+        int free = freeSpacesFor(lot, carType);
+        if (free <= 0) {
+            continue;
+        }
+        if (policy == ROUTE_NEAREST) {
+            return lot;
+        }
+        if (free > bestFree) {
+            best = lot;
+            bestFree = free;
+        }
+    }
+    if (best != -1) {
+        return best;
+    }
+    
+    // 所有停车场都没有合适的空位：排到候车车辆最少的停车场（相同时取较近的）
+    int fewestWaiting = 0;
+    for (size_t k = 0; k < nearestOrder.size(); k++) {
+        int lot = nearestOrder[k];
+        int waiting = lots[lot]->stats.waiting.load();
+        if (best == -1 || waiting < fewestWaiting) {
+            best = lot;
+            fewestWaiting = waiting;
+        }
+    }
+    return best;
+}
+
+// 车辆到达
+FacilityArrival ParkingFacility::carArrival(const string& licensePlate, int carType, time_t arrivalTime) {
+    FacilityArrival arrival;
+    arrival.lot = -1;
+    PlateView plate(licensePlate);
+    
+    // 车牌和车型先在园区检查，无效的到达不分流
+    if (!Car::isValidPlate(licensePlate)) {
+        arrival.result.outcome = ARRIVAL_INVALID_PLATE;
+        sink->onArrival(plate, arrival.result);
+        return arrival;
+    }
+    if (carType < SMALL || carType > LARGE) {
+        arrival.result.outcome = ARRIVAL_INVALID_TYPE;
+        sink->onArrival(plate, arrival.result);
+        return arrival;
+    }
+    if (lots.empty()) {
+        arrival.result.outcome = ARRIVAL_NO_SPACE;
+        sink->onArrival(plate, arrival.result);
+        return arrival;
+    }
+    
+    // 在园区登记车牌并记下停车场：车牌已在任何一个停车场中即为重复，
+    // 两个大门同时到达同一车牌时只有一个能登记成功
+    int lot = route(carType);
+    uint32_t vehicleId;
+    {
+        lock_guard<mutex> guard(registryLock);
+        if (plates.find(plate) != INVALID_VEHICLE_ID) {
+            vehicleId = INVALID_VEHICLE_ID;
+        } else {
+            vehicleId = plates.intern(plate);
+            if (vehicleId >= lotOfVehicle.size()) {
+                lotOfVehicle.resize(vehicleId + 1, -1);
+            }
+            lotOfVehicle[vehicleId] = lot;
+        }
+    }
+    if (vehicleId == INVALID_VEHICLE_ID) {
+        arrival.result.outcome = ARRIVAL_DUPLICATE;
+        sink->onArrival(plate, arrival.result);
+        return arrival;
+    }
+    
+    arrival.result = lots[lot]->system.carArrival(licensePlate, carType, arrivalTime);
+    if (arrival.result.ok()) {
+        arrival.lot = lot;
+    } else {
+        releasePlate(plate);
+    }
+    return arrival;
+}
+
+// 车辆离开
+FacilityDeparture ParkingFacility::carDeparture(const string& licensePlate, time_t departureTime) {
+    FacilityDeparture departure;
+    departure.lot = -1;
+    PlateView plate(licensePlate);
+    
+    {
+        lock_guard<mutex> guard(registryLock);
+        uint32_t vehicleId = plates.find(plate);
+        if (vehicleId != INVALID_VEHICLE_ID) {
+            departure.lot = lotOfVehicle[vehicleId];
+        }
+    }
+    if (departure.lot == -1) {
+        sink->onDeparture(plate, departure.result);
+        return departure;
+    }
+    
+    // 车辆可能还在到达途中（园区已登记，停车场尚未登记），此时停车场返回未找到
+    departure.result = lots[departure.lot]->system.carDeparture(licensePlate, departureTime);
+    if (departure.result.ok()) {
+        releasePlate(plate);
+    } else {
+        departure.lot = -1;
+    }
+    return departure;
+}
+
+// 注销车牌
+// 按车牌重新查找ID：查找停车场之后到注销之前，同一车牌可能已离开又重新到达，原来的ID已被别的车牌复用
+void ParkingFacility::releasePlate(const PlateView& plate) {
+    lock_guard<mutex> guard(registryLock);
+    uint32_t vehicleId = plates.find(plate);
+    if (vehicleId != INVALID_VEHICLE_ID) {
+        plates.release(vehicleId);
+    }
+}
+
+// 查找车辆
+int ParkingFacility::findCar(const string& licensePlate, int* lot) const {
+    int found = -1;
+    {
+        lock_guard<mutex> guard(registryLock);
+        uint32_t vehicleId = plates.find(PlateView(licensePlate));
+        if (vehicleId != INVALID_VEHICLE_ID) {
+            found = lotOfVehicle[vehicleId];
+        }
+    }
+    
+    int location = found == -1 ? 0 : lots[found]->system.findCar(licensePlate);
+    if (lot != nullptr) {
+        *lot = location == 0 ? -1 : found;
+    }
+    return location;
+}
+
+// 按停车场并行重放已分流的车流
+void ParkingFacility::replay(const vector<FacilityEvent>& events, ThreadPool& pool) {
+    // 按停车场分组，组内保持原有次序
+    vector<vector<const FacilityEvent*> > perLot(lots.size());
+    for (size_t i = 0; i < events.size(); i++) {
+        int lot = events[i].lot;
+        if (lot >= 0 && lot < static_cast<int>(lots.size())) {
+            perLot[lot].push_back(&events[i]);
+        }
+    }
+    
+    // 每个停车场一个任务，直接调用该停车场的到达/离开（不经过园区登记表）
+    for (size_t lot = 0; lot < perLot.size(); lot++) {
+        if (perLot[lot].empty()) {
+            continue;
+        }
+        ParkingSystem* system = &lots[lot]->system;
+        const vector<const FacilityEvent*>* batch = &perLot[lot];
+        pool.submit([system, batch]() {
+            for (size_t i = 0; i < batch->size(); i++) {
+                const FacilityEvent& event = *(*batch)[i];
+                if (event.arrival) {
+                    system->carArrival(event.plate, event.carType, event.time);
+                } else {
+                    system->carDeparture(event.plate, event.time);
+                }
+            }
+        });
+    }
+    pool.wait();
+    
+    rebuildRegistry();
+}
+
+// 按各停车场当前的车辆重建园区登记表
+void ParkingFacility::rebuildRegistry() {
+    lock_guard<mutex> guard(registryLock);
+    plates.clear();
+    lotOfVehicle.clear();
+    
+    for (size_t lot = 0; lot < lots.size(); lot++) {
+        const ParkingSystem& system = lots[lot]->system;
+        for (Stack::const_iterator it = system.getParkingLot().begin(); it != system.getParkingLot().end(); ++it) {
+            uint32_t vehicleId = plates.intern(it->plate());
+            if (vehicleId >= lotOfVehicle.size()) {
+                lotOfVehicle.resize(vehicleId + 1, -1);
+            }
+            lotOfVehicle[vehicleId] = static_cast<int>(lot);
+        }
+        for (WaitingLane::const_iterator it = system.getWaitingLane().begin(); it != system.getWaitingLane().end(); ++it) {
+            uint32_t vehicleId = plates.intern(it->plate());
+            if (vehicleId >= lotOfVehicle.size()) {
+                lotOfVehicle.resize(vehicleId + 1, -1);
+            }
+            lotOfVehicle[vehicleId] = static_cast<int>(lot);
+        }
+    }
+}
+
+// 获取园区整体占用情况
+FacilityOccupancy ParkingFacility::getOccupancy() const {
+    FacilityOccupancy occupancy = totals;
+    for (int t = 0; t < 3; t++) {
+        occupancy.used[t] = usedSpaces[t].load();
+    }
+    occupancy.parked = parkedCars.load();
+    occupancy.waiting = waitingCars.load();
+    return occupancy;
+}
+
+// 设置分流策略
+void ParkingFacility::setRoutingPolicy(RoutingPolicy routing) {
+    policy = routing;
+}
+
+// 获取分流策略
+RoutingPolicy ParkingFacility::getRoutingPolicy() const {
+    return policy;
+}
+
+// 设置事件接收器
+void ParkingFacility::setEventSink(ParkingEventSink* eventSink) {
+    sink = eventSink != nullptr ? eventSink : &nullEventSink();
+}
+
+// 获取停车场数量
+int ParkingFacility::getLotCount() const {
+    return static_cast<int>(lots.size());
+}
+
+// 获取停车场
+ParkingSystem& ParkingFacility::getLot(int lot) {
+    return lots[lot]->system;
+}
+
+const ParkingSystem& ParkingFacility::getLot(int lot) const {
+    return lots[lot]->system;
+}
+
+// 检查园区登记表和占用计数与各停车场是否一致
+bool ParkingFacility::checkConsistency() const {
+    lock_guard<mutex> guard(registryLock);
+    int used[3] = {0, 0, 0};
+    int parked = 0;
+    int waiting = 0;
+    
+    for (size_t lot = 0; lot < lots.size(); lot++) {
+        const Lot& current = *lots[lot];
+        int lotParked = 0;
+        int lotWaiting = 0;
+        for (Stack::const_iterator it = current.system.getParkingLot().begin(); it != current.system.getParkingLot().end(); ++it) {
+            uint32_t vehicleId = plates.find(it->plate());
+            if (vehicleId == INVALID_VEHICLE_ID || lotOfVehicle[vehicleId] != static_cast<int>(lot)) {
+                return false;
+            }
+            used[it->getSpaceType()]++;
+            lotParked++;
+        }
+        for (WaitingLane::const_iterator it = current.system.getWaitingLane().begin(); it != current.system.getWaitingLane().end(); ++it) {
+            uint32_t vehicleId = plates.find(it->plate());
+            if (vehicleId == INVALID_VEHICLE_ID || lotOfVehicle[vehicleId] != static_cast<int>(lot)) {
+                return false;
+            }
+            lotWaiting++;
+        }
+        if (current.stats.parked.load() != lotParked || current.stats.waiting.load() != lotWaiting) {
+            return false;
+        }
+        parked += lotParked;
+        waiting += lotWaiting;
+    }
+    
+    for (int t = 0; t < 3; t++) {
+        if (usedSpaces[t].load() != used[t]) {
+            return false;
+        }
+    }
+    return parkedCars.load() == parked && waitingCars.load() == waiting && plates.size() == parked + waiting;
+}
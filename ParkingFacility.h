@@ -0,0 +1,173 @@
+#ifndef PARKINGFACILITY_H
+#define PARKINGFACILITY_H
+
+#include "ParkingSystem.h"
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+#include <mutex>
+
+// 停车场配置
+struct LotConfig {
+    int capacity;               // 停车场最大容量
+    double hourlyRate;          // 每小时费率
+    int spaces[3];              // 小/中/大型车位数量（超出MAX_SPACES_PER_TYPE或为负时不采用，按容量平均分配）
+    int distance;               // 到园区入口的距离（按最近停车场分流时使用）
+    AllocationPolicyKind allocation;    // 车位分配策略
+    
+    LotConfig(int cap = 10, double rate = 5.0, int small = 3, int medium = 4, int large = 3, int dist = 0,
+              AllocationPolicyKind policy = ALLOCATE_STRICT)
+        : capacity(cap), hourlyRate(rate), distance(dist), allocation(policy) {
+        spaces[0] = small;
+        spaces[1] = medium;
+        spaces[2] = large;
+    }
+};
+
+// 分流策略
+enum RoutingPolicy : unsigned char {
+    ROUTE_NEAREST,              // 最近的有合适空位的停车场
+    ROUTE_LEAST_LOADED          // 合适车位空余最多的停车场（相同时取较近的）
+};
+
+// 园区整体占用情况
+struct FacilityOccupancy {
+    int capacity;               // 各停车场容量之和
+    int spaces[3];              // 小/中/大型车位总数
+    int used[3];                // 已使用的小/中/大型车位
+    int parked;                 // 停车场中的车辆数
+    int waiting;                // 候车道中的车辆数
+};
+
+// 园区到达结果（停车场编号和该停车场的到达结果）
+struct FacilityArrival {
+    int lot;                    // 分流到的停车场编号（没有进入任何停车场时为-1）
+    ArrivalResult result;       // 到达结果
+};
+
+// 园区离开结果
+struct FacilityDeparture {
+    int lot;                    // 车辆所在的停车场编号（未找到时为-1）
+    DepartureResult result;     // 离开结果
+};
+
+// 已分流的车流事件（按停车场重放）
+struct FacilityEvent {
+    int lot;                    // 停车场编号
+    bool arrival;               // true-到达，false-离开
+    int carType;                // 车型（仅到达有效）
+    time_t time;                // 到达/离开时间
+    std::string plate;          // 车牌号
+};
+
+// 停车园区：管理多个停车场
+// 到达的车辆按分流策略送往有合适空位的停车场，所有停车场都没有空位时排到候车车辆最少的停车场。
+// 园区登记表记录每个车牌所在的停车场，查找和离开只访问该停车场，不逐个询问。
+// 每个停车场挂接一个统计接收器，按到达/离开/放行事件增量更新各停车场和园区的占用计数，
+// 分流和整体统计只读取这些原子计数，不加停车场的锁，也不逐个汇总。
+// 多个大门线程可以同时调用到达/离开；分流读取的计数可能已过时，
+// 并发时车辆可能分到刚刚被占满的停车场而进入该停车场的候车道。
+// 事件接收器在各大门线程（重放时为线程池的工作线程）上调用，并发使用时需要自行保证线程安全。
+class ParkingFacility {
+private:
+    // 统计接收器：增量更新占用计数后把事件转发给园区的事件接收器
+    class LotStats : public ParkingEventSink {
+    public:
+        ParkingFacility* facility;  // 所属园区
+        AtomicCounter parked;       // 该停车场中的车辆数
+        AtomicCounter waiting;      // 该停车场候车道中的车辆数
+        
+        LotStats() : facility(nullptr) {}
+        
+        void onArrival(const PlateView& plate, const ArrivalResult& result);
+        void onDeparture(const PlateView& plate, const DepartureResult& result);
+        void onLaneAdmitted(const Car& car);
+    };
+    
+    // 一个停车场
+    struct Lot {
+        ParkingSystem system;       // 停车场管理系统
+        LotStats stats;             // 统计接收器
+        int distance;               // 到园区入口的距离
+        
+        Lot(const LotConfig& config);
+    };
+    
+    std::vector<Lot*> lots;         // 停车场（拥有）
+    std::vector<int> nearestOrder;  // 按距离从近到远排列的停车场编号
+    RoutingPolicy policy;           // 分流策略
+    ParkingEventSink* sink;         // 事件接收器（不拥有，默认输出到控制台）
+    
+    PlateRegistry plates;           // 园区车牌登记表（车牌 -> 园区车辆ID）
+    std::vector<int> lotOfVehicle;  // 园区车辆ID -> 停车场编号
+    mutable std::mutex registryLock;    // 保护园区登记表
+    
+    FacilityOccupancy totals;       // 容量和车位总数（构造后不变）
+    AtomicCounter usedSpaces[3];    // 园区已使用的小/中/大型车位
+    AtomicCounter parkedCars;       // 园区停车场中的车辆数
+    AtomicCounter waitingCars;      // 园区候车道中的车辆数
+    
+public:
+    // 构造函数（按配置创建各停车场）
+    ParkingFacility(const std::vector<LotConfig>& configs, RoutingPolicy routing = ROUTE_NEAREST);
+    
+    // 析构函数
+    ~ParkingFacility();
+    
+    // 车辆到达：分流到一个停车场
+    FacilityArrival carArrival(const std::string& licensePlate, int carType, time_t arrivalTime);
+    
+    // 车辆离开：直接交给车辆所在的停车场
+    FacilityDeparture carDeparture(const std::string& licensePlate, time_t departureTime);
+    
+    // 查找车辆（O(1)：园区登记表给出停车场，再由该停车场的位置索引给出位置）
+    // 返回：0-未找到，1-在停车场，2-在候车道；lot不为nullptr时写入停车场编号（未找到为-1）
+    int findCar(const std::string& licensePlate, int* lot = nullptr) const;
+    
+    // 按停车场并行重放已分流的车流
+    // 事件按停车场分组（保持原有次序），每个停车场在线程池上按次序单独重放，
+    // 不同停车场之间互不影响；全部完成后按各停车场的车辆重建园区登记表。
+    // 只能在没有大门线程运行时调用，事件中的车牌应与园区当前车辆不冲突
+    void replay(const std::vector<FacilityEvent>& events, ThreadPool& pool);
+    
+    // 获取园区整体占用情况（读取增量维护的计数，不访问各停车场）
+    FacilityOccupancy getOccupancy() const;
+    
+    // 设置分流策略
+    void setRoutingPolicy(RoutingPolicy routing);
+    
+    // 获取分流策略
+    RoutingPolicy getRoutingPolicy() const;
+    
+    // 设置事件接收器（不转移所有权；传入nullptr表示丢弃所有事件）
+    void setEventSink(ParkingEventSink* eventSink);
+    
+    // 获取停车场数量
+    int getLotCount() const;
+    
+    // 获取停车场（用于查询和显示；不要替换其事件接收器）
+    ParkingSystem& getLot(int lot);
+    const ParkingSystem& getLot(int lot) const;
+    
+    // 检查园区登记表和占用计数与各停车场是否一致（调试用，需遍历全部车辆，只能在没有大门线程运行时调用）
+    bool checkConsistency() const;
+    
+private:
+    // 选择停车场：有合适空位时按分流策略选择，否则选候车车辆最少的停车场
+    int route(int carType) const;
+    
+    // 停车场lot中carType车型可用的车位数（读取原子计数，不加锁）
+    int freeSpacesFor(int lot, int carType) const;
+    
+    // 从园区登记表注销车牌
+    void releasePlate(const PlateView& plate);
+    
+    // 按各停车场当前的车辆重建园区登记表
+    void rebuildRegistry();
+    
+    // 园区不可复制
+    ParkingFacility(const ParkingFacility&);
+    ParkingFacility& operator=(const ParkingFacility&);
+};
+
+#endif // PARKINGFACILITY_H
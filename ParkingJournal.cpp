@@ -0,0 +1,511 @@
+#include "ParkingJournal.h"
+#include "ParkingSnapshot.h"
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char JOURNAL_MAGIC[8] = { 'P', 'A', 'R', 'K', 'J', 'R', 'N', 'L' };
+static const uint32_t JOURNAL_BYTE_ORDER = 0x01020304u;
+
+static_assert(sizeof(JournalRecord) == 36, "日志记录应为36字节");
+static_assert(sizeof(JournalHeader) % 4 == 0, "日志文件头大小必须是4的倍数");
+
+// ==================== 文件操作（按平台封装） ====================
+
+#ifdef _WIN32
+
+static int openFile(const string& filename, bool readOnly) {
+    if (readOnly) {
+        return _open(filename.c_str(), _O_RDONLY | _O_BINARY);
+    }
+    return _open(filename.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+static void closeFile(int fd) {
+    _close(fd);
+}
+
+static long readSome(int fd, void* data, size_t size) {
+    return _read(fd, data, static_cast<unsigned int>(size));
+}
+
+static long writeSome(int fd, const void* data, size_t size) {
+    return _write(fd, data, static_cast<unsigned int>(size));
+}
+
+static bool syncFile(int fd) {
+    return _commit(fd) == 0;
+}
+
+static bool truncateFile(int fd, long long size) {
+    return _chsize_s(fd, size) == 0;
+}
+
+static long long seekFile(int fd, long long offset, int whence) {
+    return _lseeki64(fd, offset, whence);
+}
+
+#else
+
+static int openFile(const string& filename, bool readOnly) {
+    if (readOnly) {
+        return ::open(filename.c_str(), O_RDONLY);
+    }
+    return ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+}
+
+static void closeFile(int fd) {
+    ::close(fd);
+}
+
+static long readSome(int fd, void* data, size_t size) {
+    return static_cast<long>(::read(fd, data, size));
+}
+
+static long writeSome(int fd, const void* data, size_t size) {
+    return static_cast<long>(::write(fd, data, size));
+}
+
+static bool syncFile(int fd) {
+    return fsync(fd) == 0;
+}
+
+static bool truncateFile(int fd, long long size) {
+    return ftruncate(fd, static_cast<off_t>(size)) == 0;
+}
+
+static long long seekFile(int fd, long long offset, int whence) {
+    return static_cast<long long>(lseek(fd, static_cast<off_t>(offset), whence));
+}
+
+#endif
+
+// 写入全部数据（处理部分写入）
+static bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        long written = writeSome(fd, bytes, size);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// 读取最多size字节，返回实际读到的字节数（到达文件末尾时少于size），出错返回-1
+static long readFully(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    size_t total = 0;
+    while (total < size) {
+        long got = readSome(fd, bytes + total, size - total);
+        if (got < 0) {
+            return -1;
+        }
+        if (got == 0) {
+            break;
+        }
+        total += static_cast<size_t>(got);
+    }
+    return static_cast<long>(total);
+}
+
+// 计算记录的校验和（不含校验和字段本身）
+static uint32_t recordChecksum(const JournalRecord& record) {
+    RecordChecksum checksum;
+    checksum.update(&record, offsetof(JournalRecord, checksum));
+    return checksum.value();
+}
+
+// 写入新日志段的文件头并同步，返回文件头长度（失败返回-1）
+static long long writeHeader(int file) {
+    JournalHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.version = JOURNAL_VERSION;
+    header.byteOrder = JOURNAL_BYTE_ORDER;
+    header.recordSize = sizeof(JournalRecord);
+    if (!writeAll(file, &header, sizeof(header)) || !syncFile(file)) {
+        return -1;
+    }
+    return static_cast<long long>(sizeof(header));
+}
+
+// 读取日志段：校验文件头，按块读出记录，遇到不完整、校验失败或序号不连续的记录即停止
+// 返回有效部分（文件头和完整有效的记录）的长度，不是日志文件或读取失败返回-1
+static long long readSegment(int file, vector<JournalRecord>& records) {
+    JournalHeader header;
+    if (readFully(file, &header, sizeof(header)) != static_cast<long>(sizeof(header)) ||
+        memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != JOURNAL_VERSION ||
+        header.byteOrder != JOURNAL_BYTE_ORDER ||
+        header.recordSize != sizeof(JournalRecord)) {
+        return -1;
+    }
+    
+    long long length = static_cast<long long>(sizeof(header));
+    uint32_t lastLsn = INVALID_LSN;
+    bool intact = true;
+    JournalRecord chunk[256];
+    while (intact) {
+        long got = readFully(file, chunk, sizeof(chunk));
+        if (got < 0) {
+            return -1;
+        }
+        size_t count = static_cast<size_t>(got) / sizeof(JournalRecord);
+        for (size_t i = 0; i < count && intact; i++) {
+            if (!isValidJournalRecord(chunk[i]) ||
+                (lastLsn != INVALID_LSN && chunk[i].lsn != lastLsn + 1)) {
+                intact = false;
+            } else {
+                records.push_back(chunk[i]);
+                lastLsn = chunk[i].lsn;
+                length += static_cast<long long>(sizeof(JournalRecord));
+            }
+        }
+        if (static_cast<size_t>(got) < sizeof(chunk)) {
+            break;
+        }
+    }
+    return length;
+}
+
+// 切换出去的旧日志段文件名
+static string rotatedName(const string& filename) {
+    return filename + ".old";
+}
+
+// ==================== 记录校验 ====================
+
+// 校验日志记录
+bool isValidJournalRecord(const JournalRecord& record) {
+    if (record.checksum != recordChecksum(record) || record.lsn == INVALID_LSN) {
+        return false;
+    }
+    // 到达记录可以停入车位或进入候车道，放行记录必须停入车位，离开记录不占用车位；
+    // 停入车位的记录带有车位编号，不占用车位的记录没有
+    if (record.op == JOURNAL_ARRIVAL) {
+        if (record.spaceType > SPACE_LARGE && record.spaceType != JOURNAL_NO_SPACE) {
+            return false;
+        }
+    } else if (record.op == JOURNAL_ADMIT) {
+        if (record.spaceType > SPACE_LARGE) {
+            return false;
+        }
+    } else if (record.op != JOURNAL_DEPARTURE || record.spaceType != JOURNAL_NO_SPACE) {
+        return false;
+    }
+    if ((record.spaceType == JOURNAL_NO_SPACE) != (record.spaceId == JOURNAL_NO_SPACE_ID) ||
+        (record.spaceId != JOURNAL_NO_SPACE_ID && record.spaceId >= static_cast<uint32_t>(MAX_SPACES_PER_TYPE))) {
+        return false;
+    }
+    if (record.carType > LARGE || record.plateLength == 0 ||
+        record.plateLength > Car::MAX_PLATE_LENGTH || record.plate[record.plateLength] != '\0') {
+        return false;
+    }
+    return true;
+}
+
+// 取得日志记录中的车牌
+PlateView plateOf(const JournalRecord& record) {
+    return PlateView(record.plate, record.plateLength);
+}
+
+// ==================== ParkingJournal ====================
+
+// 构造函数
+ParkingJournal::ParkingJournal()
+    : fd(-1), nextLsn(1), pending(0), failed(false), syncCount(0),
+      lastSync(chrono::steady_clock::now()), stopping(false) {
+}
+
+// 析构函数
+ParkingJournal::~ParkingJournal() {
+    close();
+}
+
+// 打开日志文件
+bool ParkingJournal::open(const string& filename, vector<JournalRecord>& records) {
+    close();
+    lock_guard<mutex> guard(accessMutex);
+    records.clear();
+    
+    // 上次检查点切换出去的旧日志段还在（检查点没有完成），其中的记录排在当前日志段之前
+    string rotated = rotatedName(filename);
+    int oldFile = openFile(rotated, true);
+    if (oldFile >= 0) {
+        long long oldLength = readSegment(oldFile, records);
+        closeFile(oldFile);
+        if (oldLength < 0) {
+            records.clear();
+            return false;
+        }
+    }
+    
+    int file = openFile(filename, false);
+    if (file < 0) {
+        records.clear();
+        return false;
+    }
+    
+    // 新文件（或创建后还没来得及写入文件头的文件）写入文件头，否则读出其中的记录
+    long long fileLength = seekFile(file, 0, SEEK_END);
+    long long validLength = fileLength == 0 ? writeHeader(file)
+                                            : (seekFile(file, 0, SEEK_SET) == 0 ? readSegment(file, records) : -1);
+    if (fileLength < 0 || validLength < 0) {
+        // 不是本程序的日志文件，不能截断或追加
+        closeFile(file);
+        records.clear();
+        return false;
+    }
+    
+    // 截掉有效记录之后的残余部分，从有效部分末尾继续追加
+    if (fileLength > validLength && (!truncateFile(file, validLength) || !syncFile(file))) {
+        closeFile(file);
+        records.clear();
+        return false;
+    }
+    if (seekFile(file, validLength, SEEK_SET) != validLength) {
+        closeFile(file);
+        records.clear();
+        return false;
+    }
+    
+    fd = file;
+    path = filename;
+    nextLsn = records.empty() ? 1 : records.back().lsn + 1;
+    pending = 0;
+    failed = false;
+    lastSync = chrono::steady_clock::now();
+    stopping = false;
+    flusher = thread(&ParkingJournal::flushLoop, this);
+    return true;
+}
+
+// 同步并关闭日志
+void ParkingJournal::close() {
+    stopFlusher();
+    lock_guard<mutex> guard(accessMutex);
+    if (fd >= 0) {
+        syncLocked();
+        closeFile(fd);
+    }
+    fd = -1;
+    pending = 0;
+}
+
+// 判断日志是否已打开
+bool ParkingJournal::isOpen() const {
+    lock_guard<mutex> guard(accessMutex);
+    return fd >= 0;
+}
+
+// 判断日志是否可用
+bool ParkingJournal::good() const {
+    lock_guard<mutex> guard(accessMutex);
+    return fd >= 0 && !failed;
+}
+
+// 设置组提交策略
+void ParkingJournal::setPolicy(const JournalPolicy& newPolicy) {
+    lock_guard<mutex> guard(accessMutex);
+    policy = newPolicy;
+    flusherWake.notify_one();
+}
+
+// 获取组提交策略
+JournalPolicy ParkingJournal::getPolicy() const {
+    lock_guard<mutex> guard(accessMutex);
+    return policy;
+}
+
+// 追加一条记录
+uint32_t ParkingJournal::append(JournalOp op, const PlateView& plate, int carType, int spaceType, int spaceId, time_t time) {
+    lock_guard<mutex> guard(accessMutex);
+    if (fd < 0 || failed) {
+        return INVALID_LSN;
+    }
+    
+    JournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.lsn = nextLsn;
+    record.time = static_cast<uint32_t>(time);
+    record.op = static_cast<uint8_t>(op);
+    record.carType = op == JOURNAL_ARRIVAL ? static_cast<uint8_t>(carType) : 0;
+    record.plateLength = static_cast<uint8_t>(plate.size());
+    record.spaceType = static_cast<uint8_t>(spaceType);
+    record.spaceId = spaceId >= 0 ? static_cast<uint32_t>(spaceId) : JOURNAL_NO_SPACE_ID;
+    memcpy(record.plate, plate.data(), plate.size());
+    record.checksum = recordChecksum(record);
+    
+    // 立即写入操作系统，按策略决定是否落盘
+    if (!writeAll(fd, &record, sizeof(record))) {
+        failed = true;
+        return INVALID_LSN;
+    }
+    nextLsn++;
+    pending++;
+    if (pending == 1 && policy.intervalMs > 0) {
+        // 一批的第一条记录：后台同步线程开始计时
+        flusherWake.notify_one();
+    }
+    
+    bool due = policy.batchSize > 0 && pending >= policy.batchSize;
+    if (!due && policy.intervalMs > 0) {
+        due = chrono::steady_clock::now() - lastSync >= chrono::milliseconds(policy.intervalMs);
+    }
+    if (due && !syncLocked()) {
+        return INVALID_LSN;
+    }
+    return record.lsn;
+}
+
+// 把已写入的记录同步到磁盘
+bool ParkingJournal::sync() {
+    lock_guard<mutex> guard(accessMutex);
+    return syncLocked();
+}
+
+// 同步已写入的记录（调用方已持有锁）
+bool ParkingJournal::syncLocked() {
+    if (fd < 0 || failed) {
+        return false;
+    }
+    if (pending > 0) {
+        if (!syncFile(fd)) {
+            failed = true;
+            return false;
+        }
+        syncCount++;
+        pending = 0;
+    }
+    lastSync = chrono::steady_clock::now();
+    return true;
+}
+
+// 后台同步线程
+void ParkingJournal::flushLoop() {
+    unique_lock<mutex> lock(accessMutex);
+    while (!stopping) {
+        if (pending == 0 || failed || policy.intervalMs <= 0) {
+            // 没有需要按时间同步的记录，等下一批的第一条记录或策略改变
+            flusherWake.wait(lock);
+            continue;
+        }
+        chrono::steady_clock::time_point due = lastSync + chrono::milliseconds(policy.intervalMs);
+        if (chrono::steady_clock::now() >= due) {
+            syncLocked();
+        } else {
+            flusherWake.wait_until(lock, due);
+        }
+    }
+}
+
+// 通知后台同步线程退出
+void ParkingJournal::stopFlusher() {
+    {
+        lock_guard<mutex> guard(accessMutex);
+        stopping = true;
+    }
+    flusherWake.notify_all();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+}
+
+// 清空日志
+bool ParkingJournal::truncate() {
+    lock_guard<mutex> guard(accessMutex);
+    if (fd < 0 || failed) {
+        return false;
+    }
+    long long headerLength = static_cast<long long>(sizeof(JournalHeader));
+    if (!truncateFile(fd, headerLength) || !syncFile(fd) ||
+        seekFile(fd, headerLength, SEEK_SET) != headerLength) {
+        failed = true;
+        return false;
+    }
+    pending = 0;
+    lastSync = chrono::steady_clock::now();
+    
+    // 旧日志段中的记录同样已包含在快照中
+    remove(rotatedName(path).c_str());
+    return true;
+}
+
+// 切换日志段
+bool ParkingJournal::rotate() {
+    lock_guard<mutex> guard(accessMutex);
+    if (!syncLocked()) {
+        return false;
+    }
+    
+    // 上一次切换出去的旧日志段还没有删除（那次检查点没有完成），继续写当前日志段
+    string rotated = rotatedName(path);
+    int oldFile = openFile(rotated, true);
+    if (oldFile >= 0) {
+        closeFile(oldFile);
+        return true;
+    }
+    
+    // 关闭后改名（Windows上不能改名打开着的文件），再创建新的日志段
+    closeFile(fd);
+    fd = -1;
+    if (rename(path.c_str(), rotated.c_str()) != 0) {
+        fd = openFile(path, false);
+        failed = fd < 0 || seekFile(fd, 0, SEEK_END) < 0;
+        return false;
+    }
+    fd = openFile(path, false);
+    if (fd < 0 || writeHeader(fd) < 0) {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+// 删除切换出去的旧日志段
+void ParkingJournal::dropRotated() {
+    lock_guard<mutex> guard(accessMutex);
+    if (!path.empty()) {
+        remove(rotatedName(path).c_str());
+    }
+}
+
+// 保证之后追加的记录序号大于lsn
+void ParkingJournal::advancePast(uint32_t lsn) {
+    lock_guard<mutex> guard(accessMutex);
+    if (nextLsn <= lsn) {
+        nextLsn = lsn + 1;
+    }
+}
+
+// 获取最后一条记录的序号
+uint32_t ParkingJournal::lastLsn() const {
+    lock_guard<mutex> guard(accessMutex);
+    return nextLsn - 1;
+}
+
+// 获取尚未同步的记录数
+int ParkingJournal::pendingCount() const {
+    lock_guard<mutex> guard(accessMutex);
+    return pending;
+}
+
+// 获取同步次数
+unsigned long long ParkingJournal::getSyncCount() const {
+    lock_guard<mutex> guard(accessMutex);
+    return syncCount;
+}
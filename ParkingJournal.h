@@ -0,0 +1,161 @@
+#ifndef PARKINGJOURNAL_H
+#define PARKINGJOURNAL_H
+
+#include "Car.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+// 操作日志（预写日志）文件格式
+// [JournalHeader][JournalRecord][JournalRecord]...
+// 每次成功的车辆到达/离开追加一条36字节的定长记录，记录操作的结果（停入的车位类型和编号，或进入候车道），
+// 候车道车辆进入停车场也单独记录。多个大门线程并发操作时，记录在修改对应结构的临界区内追加，
+// 日志次序就是各结构实际变更的次序，重放时按记录直接还原，不重新决定车位，得到与原来相同的状态。
+// 进入候车道的到达在入口队列并入候车道时才记录（通常在到达操作返回之前，并发时可能稍后）。
+// 记录带有连续递增的日志序号（LSN），快照文件头保存了快照包含的最后一个序号，
+// 恢复时加载快照后只重放序号更大的记录。
+// 版本2在记录中加入了车位类型，并增加了候车道放行记录；版本3加入了车位编号；版本4的车位编号扩展为32位
+const uint32_t JOURNAL_VERSION = 4;
+const uint32_t INVALID_LSN = 0;
+const uint8_t JOURNAL_NO_SPACE = 0xFF;     // 记录中的车位类型：没有占用车位（进入候车道或离开）
+const uint32_t JOURNAL_NO_SPACE_ID = 0xFFFFFFFFu;  // 记录中的车位编号：没有占用车位
+
+enum JournalOp {
+    JOURNAL_ARRIVAL = 1,        // 车辆到达
+    JOURNAL_DEPARTURE = 2,      // 车辆离开
+    JOURNAL_ADMIT = 3           // 候车道车辆进入停车场
+};
+
+struct JournalHeader {
+    char magic[8];              // 文件标识"PARKJRNL"
+    uint32_t version;           // 格式版本
+    uint32_t byteOrder;         // 字节序标记（写入0x01020304）
+    uint32_t recordSize;        // 日志记录大小（sizeof(JournalRecord)）
+    uint32_t reserved;          // 保留（恒为0）
+};
+
+struct JournalRecord {
+    uint32_t lsn;               // 日志序号（从1开始连续递增）
+    uint32_t time;              // 到达/离开时间（与车辆记录一样为32位秒数）
+    uint8_t op;                 // 操作类型（JournalOp）
+    uint8_t carType;            // 车型（仅到达记录有效）
+    uint8_t plateLength;        // 车牌长度
+    uint8_t spaceType;          // 停入的车位类型（进入候车道和离开记录为JOURNAL_NO_SPACE）
+    char plate[Car::MAX_PLATE_LENGTH + 1];  // 车牌号（未用部分填0）
+    uint32_t spaceId;           // 停入的车位编号（不占用车位的记录为JOURNAL_NO_SPACE_ID）
+    uint32_t checksum;          // 校验和（覆盖前面的全部字段）
+};
+
+// 组提交策略
+// 每条记录追加后立即写入操作系统（进程崩溃不会丢失记录），
+// 但只在凑满一批或距上次同步超过一定时间后才调用fsync落盘，掉电时最多丢失最后一批记录。
+// 按时间的同步由日志的后台线程负责，没有后续追加（操作停下来）时最后几条记录同样在间隔内落盘。
+struct JournalPolicy {
+    int batchSize;              // 累计多少条记录同步一次（1表示每条记录都同步，0表示不按条数同步）
+    int intervalMs;             // 记录写入后最多多少毫秒内同步（0表示不按时间同步）
+    
+    JournalPolicy(int batch = 64, int interval = 50) : batchSize(batch), intervalMs(interval) {}
+};
+
+// 只追加的操作日志
+// 各成员函数内部加锁，多个大门线程可以同时追加记录
+class ParkingJournal {
+private:
+    mutable std::mutex accessMutex;     // 保护以下全部状态
+    int fd;                     // 文件描述符（未打开时为-1）
+    std::string path;           // 当前日志段的文件名
+    JournalPolicy policy;       // 组提交策略
+    uint32_t nextLsn;           // 下一条记录的序号
+    int pending;                // 已写入但尚未同步的记录数
+    bool failed;                // 是否发生过写入或同步错误
+    unsigned long long syncCount;                           // 同步次数（统计用）
+    std::chrono::steady_clock::time_point lastSync;         // 上次同步的时间
+    std::thread flusher;        // 后台同步线程（日志打开期间运行，按时间间隔同步）
+    std::condition_variable flusherWake;    // 唤醒后台同步线程（有了待同步记录、策略改变或关闭日志）
+    bool stopping;              // 通知后台同步线程退出
+    
+public:
+    // 构造函数
+    ParkingJournal();
+    
+    // 析构函数（同步并关闭日志）
+    ~ParkingJournal();
+    
+    // 打开日志文件（不存在则创建），读出其中完整有效的记录供重放
+    // 旧日志段（检查点没有完成时留下的"文件名.old"）中的记录排在前面一并读出。
+    // 末尾写了一半或校验失败的记录（崩溃时正在写入）会被截掉，之后的记录从有效部分末尾开始追加。
+    // 文件不是日志文件或读写失败时返回false，不修改文件
+    bool open(const std::string& filename, std::vector<JournalRecord>& records);
+    
+    // 同步并关闭日志
+    void close();
+    
+    // 判断日志是否已打开
+    bool isOpen() const;
+    
+    // 判断日志是否可用（已打开且没有发生过写入错误）
+    bool good() const;
+    
+    // 设置组提交策略
+    void setPolicy(const JournalPolicy& newPolicy);
+    
+    // 获取组提交策略
+    JournalPolicy getPolicy() const;
+    
+    // 追加一条记录，按组提交策略决定是否同步
+    // spaceType和spaceId为停入的车位类型和编号，没有占用车位时为JOURNAL_NO_SPACE和-1
+    // 返回记录的序号，写入失败返回INVALID_LSN（之后的追加都会失败）
+    uint32_t append(JournalOp op, const PlateView& plate, int carType, int spaceType, int spaceId, time_t time);
+    
+    // 把已写入的记录同步到磁盘
+    bool sync();
+    
+    // 清空日志（检查点已把全部记录写入快照后调用），序号继续递增
+    // 切换出去的旧日志段一并删除
+    bool truncate();
+    
+    // 切换日志段：当前日志段改名为"文件名.old"，之后的记录写入新的日志段
+    // 后台检查点冻结状态时调用，快照写完后调用dropRotated删除旧日志段；
+    // 旧日志段还在时（上一次检查点没有完成）不切换，继续写当前日志段
+    bool rotate();
+    
+    // 删除切换出去的旧日志段（其中的记录都已包含在检查点快照中）
+    void dropRotated();
+    
+    // 保证之后追加的记录序号大于lsn（挂接到从快照恢复的系统时调用）
+    void advancePast(uint32_t lsn);
+    
+    // 获取最后一条记录的序号（还没有记录时为下一条记录的序号减1）
+    uint32_t lastLsn() const;
+    
+    // 获取尚未同步的记录数
+    int pendingCount() const;
+    
+    // 获取同步次数
+    unsigned long long getSyncCount() const;
+    
+private:
+    // 同步已写入的记录（调用方已持有锁）
+    bool syncLocked();
+    
+    // 后台同步线程：有待同步的记录时，距上次同步满intervalMs毫秒就同步
+    void flushLoop();
+    
+    // 通知后台同步线程退出并等待其结束（调用方不能持有锁）
+    void stopFlusher();
+    
+    // 日志不可复制
+    ParkingJournal(const ParkingJournal&);
+    ParkingJournal& operator=(const ParkingJournal&);
+};
+
+// 校验日志记录（校验和、操作类型、车型、车位类型和编号、车牌）
+bool isValidJournalRecord(const JournalRecord& record);
+
+// 取得日志记录中的车牌
+PlateView plateOf(const JournalRecord& record);
+
+#endif // PARKINGJOURNAL_H
@@ -0,0 +1,395 @@
+#include "ParkingMetrics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+// 最高的1位的序号（调用方保证值不为0）
+static inline int highestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+// ==================== 分桶规则 ====================
+
+// 获取值所在的桶
+// 值v的最高位为第e位（e >= 4）时，桶号为 16*(e-3) + v的最高位之后的4位
+int HistogramBuckets::indexOf(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+    int exponent = highestBit(value);
+    if (exponent > MAX_EXPONENT) {
+        return COUNT - 1;
+    }
+    int sub = static_cast<int>((value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return SUB_BUCKETS * (exponent - SUB_BUCKET_BITS + 1) + sub;
+}
+
+// 获取桶中的最小值
+uint64_t HistogramBuckets::lowestValue(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    uint64_t sub = static_cast<uint64_t>(index % SUB_BUCKETS);
+    return (static_cast<uint64_t>(1) << exponent) + (sub << (exponent - SUB_BUCKET_BITS));
+}
+
+// 获取桶中的最大值（最后一个桶还包含超出上限的值）
+uint64_t HistogramBuckets::highestValue(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int exponent = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+    return lowestValue(index) + (static_cast<uint64_t>(1) << (exponent - SUB_BUCKET_BITS)) - 1;
+}
+
+// ==================== HistogramSnapshot ====================
+
+HistogramSnapshot::HistogramSnapshot() : count(0), sum(0) {
+    memset(counts, 0, sizeof(counts));
+}
+
+// 获取平均值
+double HistogramSnapshot::mean() const {
+    return count > 0 ? static_cast<double>(sum) / count : 0.0;
+}
+
+// 获取百分位数
+uint64_t HistogramSnapshot::percentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    // 排在第rank位（从1计）的记录所在的桶
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * count + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    if (rank > count) {
+        rank = count;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < HistogramBuckets::COUNT; i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return HistogramBuckets::highestValue(i);
+        }
+    }
+    return HistogramBuckets::highestValue(HistogramBuckets::COUNT - 1);
+}
+
+// 获取最大值
+uint64_t HistogramSnapshot::max() const {
+    for (int i = HistogramBuckets::COUNT - 1; i >= 0; i--) {
+        if (counts[i] > 0) {
+            return HistogramBuckets::highestValue(i);
+        }
+    }
+    return 0;
+}
+
+// ==================== 分片 ====================
+
+// 一个分片：各种结果的次数和各直方图的分桶计数
+// 独占的分片只有一个线程写入，计数用relaxed的读取加写入，不需要加锁的原子加法；共用的分片用原子加法。
+// 分片很大（每个直方图约4.7KB），相邻分片只在边界处共享缓存行，末尾再填充一个缓存行隔开
+struct ParkingMetrics::Shard {
+    struct Histogram {
+        atomic<uint64_t> counts[HistogramBuckets::COUNT];
+        atomic<uint64_t> sum;
+    };
+    
+    atomic<uint64_t> arrivals[ARRIVAL_OUTCOME_COUNT];
+    atomic<uint64_t> departures[DEPARTURE_OUTCOME_COUNT];
+    atomic<uint64_t> admissions;
+    Histogram histograms[METRIC_HISTOGRAM_COUNT];
+    bool shared;                    // 是否由多个线程共用
+    char pad[64];
+    
+    Shard() : shared(false) {
+        clear();
+    }
+    
+    // 计数加上delta
+    void add(atomic<uint64_t>& counter, uint64_t delta) {
+        if (shared) {
+            counter.fetch_add(delta, memory_order_relaxed);
+        } else {
+            counter.store(counter.load(memory_order_relaxed) + delta, memory_order_relaxed);
+        }
+    }
+    
+    void clear() {
+        for (int i = 0; i < ARRIVAL_OUTCOME_COUNT; i++) {
+            arrivals[i].store(0, memory_order_relaxed);
+        }
+        for (int i = 0; i < DEPARTURE_OUTCOME_COUNT; i++) {
+            departures[i].store(0, memory_order_relaxed);
+        }
+        admissions.store(0, memory_order_relaxed);
+        for (int h = 0; h < METRIC_HISTOGRAM_COUNT; h++) {
+            for (int i = 0; i < HistogramBuckets::COUNT; i++) {
+                histograms[h].counts[i].store(0, memory_order_relaxed);
+            }
+            histograms[h].sum.store(0, memory_order_relaxed);
+        }
+    }
+    
+    // 记录一个值（次数由桶计数之和得到，不单独计数）
+    void record(MetricHistogram histogram, uint64_t value) {
+        Histogram& target = histograms[histogram];
+        add(target.counts[HistogramBuckets::indexOf(value)], 1);
+        add(target.sum, value);
+    }
+};
+
+// 线程的分片编号：线程第一次记录时领取一个空闲编号，线程结束时归还，同时存在的线程各用各的编号；
+// 编号用完时领取SHARD_COUNT，即共用的分片。编号对所有指标对象通用
+static mutex slotLock;
+static bool slotUsed[ParkingMetrics::SHARD_COUNT];
+
+struct ThreadSlot {
+    int index;
+    
+    ThreadSlot() : index(ParkingMetrics::SHARD_COUNT) {
+        lock_guard<mutex> guard(slotLock);
+        for (int i = 0; i < ParkingMetrics::SHARD_COUNT; i++) {
+            if (!slotUsed[i]) {
+                slotUsed[i] = true;
+                index = i;
+                break;
+            }
+        }
+    }
+    
+    ~ThreadSlot() {
+        if (index < ParkingMetrics::SHARD_COUNT) {
+            lock_guard<mutex> guard(slotLock);
+            slotUsed[index] = false;
+        }
+    }
+};
+
+static int localThreadSlot() {
+    static thread_local ThreadSlot slot;
+    return slot.index;
+}
+
+// ==================== ParkingMetrics ====================
+
+// 构造函数
+ParkingMetrics::ParkingMetrics()
+    : shards(new Shard[SHARD_COUNT + 1]), laneDepth(0), peakLaneDepth(0) {
+    shards[SHARD_COUNT].shared = true;
+}
+
+// 析构函数
+ParkingMetrics::~ParkingMetrics() {
+    delete[] shards;
+}
+
+// 取得单调时钟的当前时间
+uint64_t ParkingMetrics::now() {
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// 取得调用线程的分片
+ParkingMetrics::Shard& ParkingMetrics::localShard() {
+    return shards[localThreadSlot()];
+}
+
+// 记录一次到达
+void ParkingMetrics::recordArrival(ArrivalOutcome outcome, uint64_t latencyNs) {
+    Shard& shard = localShard();
+    shard.add(shard.arrivals[outcome], 1);
+    shard.record(METRIC_ARRIVAL_LATENCY, latencyNs);
+}
+
+// 记录一次离开
+void ParkingMetrics::recordDeparture(DepartureOutcome outcome, int makeWayCount, uint64_t latencyNs) {
+    Shard& shard = localShard();
+    shard.add(shard.departures[outcome], 1);
+    shard.record(METRIC_DEPARTURE_LATENCY, latencyNs);
+    if (outcome == DEPARTURE_FROM_LOT) {
+        shard.record(METRIC_MAKE_WAY_MOVES, static_cast<uint64_t>(makeWayCount));
+    }
+}
+
+// 记录一辆候车车辆进入停车场
+void ParkingMetrics::recordLaneAdmission(uint64_t waitSeconds) {
+    Shard& shard = localShard();
+    shard.add(shard.admissions, 1);
+    shard.record(METRIC_LANE_WAIT, waitSeconds);
+}
+
+// 调整候车道长度，同时更新峰值
+void ParkingMetrics::addLaneDepth(int delta) {
+    int depth = laneDepth.fetch_add(delta, memory_order_relaxed) + delta;
+    int peak = peakLaneDepth.load(memory_order_relaxed);
+    while (depth > peak && !peakLaneDepth.compare_exchange_weak(peak, depth, memory_order_relaxed)) {
+    }
+}
+
+// 获取各种到达结果的次数
+uint64_t ParkingMetrics::getArrivals(ArrivalOutcome outcome) const {
+    uint64_t total = 0;
+    for (int s = 0; s <= SHARD_COUNT; s++) {
+        total += shards[s].arrivals[outcome].load(memory_order_relaxed);
+    }
+    return total;
+}
+
+// 获取各种离开结果的次数
+uint64_t ParkingMetrics::getDepartures(DepartureOutcome outcome) const {
+    uint64_t total = 0;
+    for (int s = 0; s <= SHARD_COUNT; s++) {
+        total += shards[s].departures[outcome].load(memory_order_relaxed);
+    }
+    return total;
+}
+
+// 获取候车车辆进入停车场的次数
+uint64_t ParkingMetrics::getLaneAdmissions() const {
+    uint64_t total = 0;
+    for (int s = 0; s <= SHARD_COUNT; s++) {
+        total += shards[s].admissions.load(memory_order_relaxed);
+    }
+    return total;
+}
+
+// 获取候车道长度
+int ParkingMetrics::getLaneDepth() const {
+    return laneDepth.load(memory_order_relaxed);
+}
+
+// 获取候车道长度的峰值
+int ParkingMetrics::getPeakLaneDepth() const {
+    return peakLaneDepth.load(memory_order_relaxed);
+}
+
+// 合并各分片的直方图
+void ParkingMetrics::snapshot(MetricHistogram histogram, HistogramSnapshot& result) const {
+    result = HistogramSnapshot();
+    for (int s = 0; s <= SHARD_COUNT; s++) {
+        const Shard::Histogram& source = shards[s].histograms[histogram];
+        for (int i = 0; i < HistogramBuckets::COUNT; i++) {
+            uint64_t count = source.counts[i].load(memory_order_relaxed);
+            result.counts[i] += count;
+            result.count += count;
+        }
+        result.sum += source.sum.load(memory_order_relaxed);
+    }
+}
+
+// 清零全部计数和直方图
+void ParkingMetrics::reset() {
+    for (int s = 0; s <= SHARD_COUNT; s++) {
+        shards[s].clear();
+    }
+    peakLaneDepth.store(laneDepth.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+// 输出一个直方图：只列出有记录的桶（累计次数），scale把记录值换算为导出的单位
+static void writeHistogram(ostream& out, const char* name, const char* help,
+                           const HistogramSnapshot& histogram, double scale) {
+    char number[32];
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " histogram\n";
+    uint64_t cumulative = 0;
+    for (int i = 0; i < HistogramBuckets::COUNT; i++) {
+        if (histogram.counts[i] == 0) {
+            continue;
+        }
+        cumulative += histogram.counts[i];
+        snprintf(number, sizeof(number), "%.9g", HistogramBuckets::highestValue(i) * scale);
+        out << name << "_bucket{le=\"" << number << "\"} " << cumulative << "\n";
+    }
+    out << name << "_bucket{le=\"+Inf\"} " << histogram.count << "\n";
+    snprintf(number, sizeof(number), "%.17g", histogram.sum * scale);
+    out << name << "_sum " << number << "\n";
+    out << name << "_count " << histogram.count << "\n";
+}
+
+// 按Prometheus文本格式输出全部指标
+void ParkingMetrics::writePrometheus(ostream& out) const {
+    static const char* arrivalNames[ARRIVAL_OUTCOME_COUNT] = {
+        "parked", "waiting", "invalid_plate", "invalid_type", "duplicate", "no_space"
+    };
+    static const char* departureNames[DEPARTURE_OUTCOME_COUNT] = { "lot", "lane", "not_found" };
+    
+    out << "# HELP parking_arrivals_total Car arrivals by outcome (waiting = diverted to the lane).\n";
+    out << "# TYPE parking_arrivals_total counter\n";
+    for (int i = 0; i < ARRIVAL_OUTCOME_COUNT; i++) {
+        out << "parking_arrivals_total{outcome=\"" << arrivalNames[i] << "\"} "
+            << getArrivals(static_cast<ArrivalOutcome>(i)) << "\n";
+    }
+    out << "# HELP parking_departures_total Car departures by outcome.\n";
+    out << "# TYPE parking_departures_total counter\n";
+    for (int i = 0; i < DEPARTURE_OUTCOME_COUNT; i++) {
+        out << "parking_departures_total{outcome=\"" << departureNames[i] << "\"} "
+            << getDepartures(static_cast<DepartureOutcome>(i)) << "\n";
+    }
+    out << "# HELP parking_lane_admissions_total Waiting cars moved from the lane into the lot.\n";
+    out << "# TYPE parking_lane_admissions_total counter\n";
+    out << "parking_lane_admissions_total " << getLaneAdmissions() << "\n";
+    
+    out << "# HELP parking_lane_depth Cars currently in the waiting lane.\n";
+    out << "# TYPE parking_lane_depth gauge\n";
+    out << "parking_lane_depth " << getLaneDepth() << "\n";
+    out << "# HELP parking_lane_depth_peak Highest waiting lane length since start or reset.\n";
+    out << "# TYPE parking_lane_depth_peak gauge\n";
+    out << "parking_lane_depth_peak " << getPeakLaneDepth() << "\n";
+    
+    HistogramSnapshot histogram;
+    snapshot(METRIC_ARRIVAL_LATENCY, histogram);
+    writeHistogram(out, "parking_arrival_latency_seconds", "Time spent in carArrival.", histogram, 1e-9);
+    snapshot(METRIC_DEPARTURE_LATENCY, histogram);
+    writeHistogram(out, "parking_departure_latency_seconds", "Time spent in carDeparture.", histogram, 1e-9);
+    snapshot(METRIC_MAKE_WAY_MOVES, histogram);
+    writeHistogram(out, "parking_make_way_moves", "Cars moved out of the way per departure from the lot.",
+                   histogram, 1.0);
+    snapshot(METRIC_LANE_WAIT, histogram);
+    writeHistogram(out, "parking_lane_wait_seconds", "Time a car waited in the lane before entering the lot.",
+                   histogram, 1.0);
+}
+
+// 按Prometheus文本格式写入文件
+bool ParkingMetrics::exportToFile(const string& filename) const {
+    string tempName = filename + ".tmp";
+    {
+        ofstream out(tempName.c_str(), ios::trunc);
+        if (!out) {
+            return false;
+        }
+        writePrometheus(out);
+        out.close();
+        if (out.fail()) {
+            remove(tempName.c_str());
+            return false;
+        }
+    }
+    
+    // 改名替换原有文件（Windows上rename不能覆盖已有文件，先删除）
+#ifdef _WIN32
+    remove(filename.c_str());
+#endif
+    if (rename(tempName.c_str(), filename.c_str()) != 0) {
+        remove(tempName.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+#ifndef PARKINGMETRICS_H
+#define PARKINGMETRICS_H
+
+#include "ParkingEvents.h"
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// 运行指标：到达/离开的耗时分布、各种结果的次数、让路车辆数、候车时间和候车道长度
+// 挂接到ParkingSystem后（setMetrics），每次到达和离开记录一次；没有挂接时不计时、不记录。
+// 记录只写调用线程自己的分片（线程结束后分片交给之后的线程），不加锁、不用原子加法；
+// 同时记录的线程超过SHARD_COUNT个时，其余线程共用一个分片，改用原子加法，计数也不会丢失。
+// 读取时把全部分片相加；读取可以与记录同时进行，得到的是某个瞬间附近的近似值（与记录同时清零时可能有少量计数残留）。
+// 多个停车场可以挂接同一个指标对象，得到的是合计值（候车道长度为各停车场之和）。
+
+// 对数分桶直方图的分桶规则（与HdrHistogram相同的思路）
+// 小于16的值各占一个桶；此后每个2的幂区间等分为16个桶，相对误差不超过1/16。
+// 超出上限的值计入最后一个桶
+struct HistogramBuckets {
+    static const int SUB_BUCKET_BITS = 4;                       // 每个2的幂区间的分桶数为2^4
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 39;                         // 可区分的最大值约为2^40
+    static const int COUNT = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+    
+    // 获取值所在的桶
+    static int indexOf(uint64_t value);
+    
+    // 获取桶中的最小值和最大值
+    static uint64_t lowestValue(int index);
+    static uint64_t highestValue(int index);
+};
+
+// 合并后的直方图（读取时由各分片相加得到）
+struct HistogramSnapshot {
+    uint64_t counts[HistogramBuckets::COUNT];   // 各桶的次数
+    uint64_t count;                             // 总次数
+    uint64_t sum;                               // 记录值之和
+    
+    HistogramSnapshot();
+    
+    // 获取平均值
+    double mean() const;
+    
+    // 获取百分位数（percentile为0到100，返回所在桶的最大值；没有记录时返回0）
+    uint64_t percentile(double percentile) const;
+    
+    // 获取最大值（所在桶的最大值）
+    uint64_t max() const;
+};
+
+// 直方图种类
+enum MetricHistogram : unsigned char {
+    METRIC_ARRIVAL_LATENCY,     // 到达操作耗时（纳秒）
+    METRIC_DEPARTURE_LATENCY,   // 离开操作耗时（纳秒）
+    METRIC_MAKE_WAY_MOVES,      // 每次从停车场离开的让路车辆数
+    METRIC_LANE_WAIT,           // 候车车辆进入停车场前的候车时间（秒，按操作时间计）
+    METRIC_HISTOGRAM_COUNT
+};
+
+const int ARRIVAL_OUTCOME_COUNT = ARRIVAL_NO_SPACE + 1;
+const int DEPARTURE_OUTCOME_COUNT = DEPARTURE_NOT_FOUND + 1;
+
+// 运行指标登记表
+class ParkingMetrics {
+public:
+    static const int SHARD_COUNT = 16;      // 线程独占的分片数（另有一个共用的分片）
+    
+private:
+    struct Shard;
+    Shard* shards;                          // 各线程独占的分片和最后一个共用的分片
+    std::atomic<int> laneDepth;             // 候车道长度
+    std::atomic<int> peakLaneDepth;         // 候车道长度的峰值
+    
+public:
+    // 构造函数
+    ParkingMetrics();
+    
+    // 析构函数
+    ~ParkingMetrics();
+    
+    // 取得单调时钟的当前时间（纳秒，用于计时）
+    static uint64_t now();
+    
+    // 记录一次到达（结果和耗时）
+    void recordArrival(ArrivalOutcome outcome, uint64_t latencyNs);
+    
+    // 记录一次离开（结果、让路车辆数和耗时；让路车辆数只对从停车场离开有意义）
+    void recordDeparture(DepartureOutcome outcome, int makeWayCount, uint64_t latencyNs);
+    
+    // 记录一辆候车车辆进入停车场及其候车时间（秒）
+    void recordLaneAdmission(uint64_t waitSeconds);
+    
+    // 调整候车道长度（ParkingSystem在候车车辆数变化时调用）
+    void addLaneDepth(int delta);
+    
+    // 获取各种结果的次数（各分片之和）
+    uint64_t getArrivals(ArrivalOutcome outcome) const;
+    uint64_t getDepartures(DepartureOutcome outcome) const;
+    uint64_t getLaneAdmissions() const;
+    
+    // 获取候车道长度及其峰值
+    int getLaneDepth() const;
+    int getPeakLaneDepth() const;
+    
+    // 合并各分片的直方图
+    void snapshot(MetricHistogram histogram, HistogramSnapshot& result) const;
+    
+    // 清零全部计数和直方图（候车道长度保留，峰值重置为当前长度）
+    void reset();
+    
+    // 按Prometheus文本格式输出全部指标
+    void writePrometheus(std::ostream& out) const;
+    
+    // 按Prometheus文本格式写入文件（先写临时文件再改名，读取方不会看到写了一半的文件）
+    bool exportToFile(const std::string& filename) const;
+    
+private:
+    // 取得调用线程的分片
+    Shard& localShard();
+    
+    // 指标登记表不可复制
+    ParkingMetrics(const ParkingMetrics&);
+    ParkingMetrics& operator=(const ParkingMetrics&);
+};
+
+#endif // PARKINGMETRICS_H
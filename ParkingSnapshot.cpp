@@ -0,0 +1,200 @@
+#include "ParkingSnapshot.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char SNAPSHOT_MAGIC[8] = { 'P', 'A', 'R', 'K', 'S', 'N', 'A', 'P' };
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304u;
+
+static_assert(sizeof(SnapshotHeader) % 4 == 0 && sizeof(Car) % 4 == 0,
+              "快照按32位字计算校验和，文件头和车辆记录大小必须是4的倍数");
+
+// 计算快照校验和（文件头的校验和字段按0计算）
+static uint32_t computeChecksum(const SnapshotHeader& header, const Car* lot, const Car* lane) {
+    SnapshotHeader copy = header;
+    copy.checksum = 0;
+    
+    RecordChecksum checksum;
+    checksum.update(&copy, sizeof(copy));
+    checksum.update(lot, header.lotCount * sizeof(Car));
+    checksum.update(lane, header.laneCount * sizeof(Car));
+    return checksum.value();
+}
+
+// 把文件内容同步到磁盘（改名替换前调用，保证掉电后不会留下内容不完整的快照）
+static bool syncFile(const string& filename) {
+#ifdef _WIN32
+    int fd = _open(filename.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = _commit(fd) == 0;
+    _close(fd);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return synced;
+}
+
+// 同步文件所在目录（POSIX上改名本身要同步目录才能落盘，Windows不需要）
+static void syncDirectory(const string& filename) {
+#ifndef _WIN32
+    size_t slash = filename.find_last_of('/');
+    string directory = slash == string::npos ? "." : filename.substr(0, slash + 1);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)filename;
+#endif
+}
+
+// 获取内存中快照的视图
+SnapshotView viewOf(const ParkingSnapshot& snapshot) {
+    SnapshotView view;
+    view.maxCapacity = snapshot.maxCapacity;
+    view.hourlyRate = snapshot.hourlyRate;
+    for (int i = 0; i < 3; i++) {
+        view.spaces[i] = snapshot.spaces[i];
+    }
+    view.lot = snapshot.lot.empty() ? nullptr : &snapshot.lot[0];
+    view.lotCount = static_cast<int>(snapshot.lot.size());
+    view.lane = snapshot.lane.empty() ? nullptr : &snapshot.lane[0];
+    view.laneCount = static_cast<int>(snapshot.lane.size());
+    view.journalLsn = snapshot.journalLsn;
+    return view;
+}
+
+// 按存放次序重新编号快照中的车辆ID
+void renumberVehicles(ParkingSnapshot& snapshot) {
+    uint32_t id = 0;
+    for (size_t i = 0; i < snapshot.lot.size(); i++) {
+        snapshot.lot[i].setVehicleId(id++);
+    }
+    for (size_t i = 0; i < snapshot.lane.size(); i++) {
+        snapshot.lane[i].setVehicleId(id++);
+    }
+}
+
+// 把快照写入文件
+bool writeSnapshot(const string& filename, const ParkingSnapshot& snapshot) {
+    SnapshotView view = viewOf(snapshot);
+    
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.carSize = sizeof(Car);
+    header.maxCapacity = view.maxCapacity;
+    for (int i = 0; i < 3; i++) {
+        header.spaces[i] = view.spaces[i];
+    }
+    header.hourlyRate = view.hourlyRate;
+    header.lotCount = static_cast<uint32_t>(view.lotCount);
+    header.laneCount = static_cast<uint32_t>(view.laneCount);
+    header.journalLsn = view.journalLsn;
+    header.checksum = computeChecksum(header, view.lot, view.lane);
+    
+    // 写入临时文件
+    string tempName = filename + ".tmp";
+    {
+        ofstream out(tempName.c_str(), ios::binary | ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (view.lotCount > 0) {
+            out.write(reinterpret_cast<const char*>(view.lot), view.lotCount * sizeof(Car));
+        }
+        if (view.laneCount > 0) {
+            out.write(reinterpret_cast<const char*>(view.lane), view.laneCount * sizeof(Car));
+        }
+        out.close();
+        if (out.fail() || !syncFile(tempName)) {
+            remove(tempName.c_str());
+            return false;
+        }
+    }
+    
+    // 改名替换原有快照（Windows上rename不能覆盖已有文件，先删除）
+#ifdef _WIN32
+    remove(filename.c_str());
+#endif
+    if (rename(tempName.c_str(), filename.c_str()) != 0) {
+        remove(tempName.c_str());
+        return false;
+    }
+    syncDirectory(filename);
+    return true;
+}
+
+// 解析内存中的快照文件内容
+bool parseSnapshot(const void* data, size_t size, SnapshotView& view) {
+    if (data == nullptr || size < sizeof(SnapshotHeader)) {
+        return false;
+    }
+    
+    // 文件头逐字节复制出来，不依赖映射地址的对齐
+    SnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SNAPSHOT_VERSION ||
+        header.byteOrder != SNAPSHOT_BYTE_ORDER ||
+        header.carSize != sizeof(Car)) {
+        return false;
+    }
+    
+    // 车辆数量必须与文件长度一致
+    uint64_t expected = sizeof(SnapshotHeader) +
+                        (static_cast<uint64_t>(header.lotCount) + header.laneCount) * sizeof(Car);
+    if (expected != size || header.maxCapacity < 0 ||
+        header.lotCount > static_cast<uint32_t>(header.maxCapacity)) {
+        return false;
+    }
+    
+    const Car* lot = reinterpret_cast<const Car*>(static_cast<const char*>(data) + sizeof(SnapshotHeader));
+    const Car* lane = lot + header.lotCount;
+    if (computeChecksum(header, lot, lane) != header.checksum) {
+        return false;
+    }
+    
+    view.maxCapacity = header.maxCapacity;
+    view.hourlyRate = header.hourlyRate;
+    for (int i = 0; i < 3; i++) {
+        view.spaces[i] = header.spaces[i];
+    }
+    view.lot = lot;
+    view.lotCount = static_cast<int>(header.lotCount);
+    view.lane = lane;
+    view.laneCount = static_cast<int>(header.laneCount);
+    view.journalLsn = header.journalLsn;
+    return true;
+}
+
+// 检查文件是否以快照文件标识开头
+bool isSnapshotFile(const string& filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    if (!in.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
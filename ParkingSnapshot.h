@@ -0,0 +1,100 @@
+#ifndef PARKINGSNAPSHOT_H
+#define PARKINGSNAPSHOT_H
+
+#include "Car.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+
+// 二进制快照文件格式
+// [SnapshotHeader][停车场车辆 lotCount × Car][候车道车辆 laneCount × Car]
+// 车辆记录按内存布局原样写入（Car可平凡复制），加载时映射文件后整块复制，不逐字段解析。
+// 文件头记录了Car的大小和字节序标记，快照只能在布局相同的平台之间交换；
+// 校验和覆盖文件头（校验和字段按0计算）和全部车辆记录。
+// 版本2在文件头中加入了快照包含的最后一条日志记录的序号；
+// 版本3的车辆记录加入了车位编号（车型和车位类型合为1字节，记录大小不变）；
+// 版本4的车位编号扩展为24位（与车牌长度、车型和车位类型合为4字节，记录大小不变）
+const uint32_t SNAPSHOT_VERSION = 4;
+
+struct SnapshotHeader {
+    char magic[8];              // 文件标识"PARKSNAP"
+    uint32_t version;           // 格式版本
+    uint32_t byteOrder;         // 字节序标记（写入0x01020304）
+    uint32_t carSize;           // 车辆记录大小（sizeof(Car)）
+    uint32_t checksum;          // 校验和
+    int32_t maxCapacity;        // 停车场最大容量
+    int32_t spaces[3];          // 小/中/大型车位数量
+    double hourlyRate;          // 每小时费率
+    uint32_t lotCount;          // 停车场车辆数（从栈底开始存放）
+    uint32_t laneCount;         // 候车道车辆数（按到达次序存放）
+    uint32_t journalLsn;        // 快照包含的最后一条日志记录的序号（没有日志时为0）
+    uint32_t reserved;          // 保留（恒为0）
+};
+
+// 停车场状态快照（内存中的一份完整副本）
+// 车辆ID已按存放次序重新编号：停车场车辆为0..lotCount-1，候车道车辆紧随其后，
+// 加载时按同样次序登记车牌即可得到相同的ID。
+struct ParkingSnapshot {
+    int maxCapacity;            // 停车场最大容量
+    double hourlyRate;          // 每小时费率
+    int spaces[3];              // 小/中/大型车位数量
+    std::vector<Car> lot;       // 停车场车辆（从栈底开始）
+    std::vector<Car> lane;      // 候车道车辆（按到达次序）
+    uint32_t journalLsn;        // 快照包含的最后一条日志记录的序号
+};
+
+// 快照内容视图（指向映射的文件或内存中的车辆记录，不拥有内存）
+struct SnapshotView {
+    int maxCapacity;            // 停车场最大容量
+    double hourlyRate;          // 每小时费率
+    int spaces[3];              // 小/中/大型车位数量
+    const Car* lot;             // 停车场车辆（从栈底开始）
+    int lotCount;               // 停车场车辆数
+    const Car* lane;            // 候车道车辆（按到达次序）
+    int laneCount;              // 候车道车辆数
+    uint32_t journalLsn;        // 快照包含的最后一条日志记录的序号
+};
+
+// Fletcher式校验和（按32位字累加，两个64位累加器；快照文件和日志记录共用）
+// 数据长度应为4的倍数，末尾不足4字节的部分不参与计算
+class RecordChecksum {
+private:
+    uint64_t sum1;
+    uint64_t sum2;
+    
+public:
+    RecordChecksum() : sum1(0), sum2(0) {}
+    
+    void update(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i + 4 <= size; i += 4) {
+            uint32_t word;
+            memcpy(&word, bytes + i, 4);
+            sum1 += word;
+            sum2 += sum1;
+        }
+    }
+    
+    uint32_t value() const {
+        return static_cast<uint32_t>(sum1 ^ sum2 ^ (sum2 >> 32));
+    }
+};
+
+// 按存放次序重新编号快照中的车辆ID（停车场在前，候车道在后）
+void renumberVehicles(ParkingSnapshot& snapshot);
+
+// 把快照写入文件
+// 先写入临时文件并同步到磁盘，再改名替换，写入中途失败或掉电不会破坏原有的快照
+bool writeSnapshot(const std::string& filename, const ParkingSnapshot& snapshot);
+
+// 解析内存中的快照文件内容，校验通过后填写视图（视图指向data内部）
+bool parseSnapshot(const void* data, size_t size, SnapshotView& view);
+
+// 获取内存中快照的视图
+SnapshotView viewOf(const ParkingSnapshot& snapshot);
+
+// 检查文件是否以快照文件标识开头（用于区分二进制快照和文本导出文件）
+bool isSnapshotFile(const std::string& filename);
+
+#endif // PARKINGSNAPSHOT_H
@@ -1,550 +1,1499 @@
 #include "ParkingSystem.h"
+#include "MappedFile.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <cstdlib>
+#include <utility>
+#include <cstring>
 
 using namespace std;
 
-// 캯
-ParkingSystem::ParkingSystem(int capacity, double rate) 
-    : maxCapacity(capacity), hourlyRate(rate),
+// 每个线程一份的操作暂存区：多个大门线程同时处理离开时各用各的，互不干扰
+struct OperationScratch {
+    vector<MakeWayMove> moves;      // 本次离开的让路步骤
+    vector<char> plateText;         // 让路车辆车牌的副本（让路步骤中的车牌指向这里）
+    vector<Car> admitted;           // 本次操作放行的候车道车辆
+};
+
+// 取得调用线程的暂存区
+static OperationScratch& localScratch() {
+    static thread_local OperationScratch scratch;
+    return scratch;
+}
+
+// 停车场容量不能超过三种车位数量上限之和（默认配置按容量平均分配车位）
+static int supportedCapacity(int capacity) {
+    return capacity < 3 * MAX_SPACES_PER_TYPE ? capacity : 3 * MAX_SPACES_PER_TYPE;
+}
+
+// 候车道入口队列的容量：按停车场容量取，至少16、至多1024（由队列向上取整为2的幂）
+// 入口队列只暂存停满后同时到达的车辆，队列满时退回加锁入队，小停车场不需要预先分配大缓冲区
+static int inboxCapacity(int capacity) {
+    const int minimum = 16;
+    const int maximum = 1024;
+    return capacity < minimum ? minimum : (capacity > maximum ? maximum : capacity);
+}
+
+// 构造函数
+ParkingSystem::ParkingSystem(int capacity, double rate, AllocationPolicyKind policy) 
+    : parkingLot(supportedCapacity(capacity)),
+      inbox(inboxCapacity(capacity)),
+      sink(&consoleEventSink()), journal(nullptr), metrics(nullptr), tracer(nullptr), clock(&wallClock()), appliedLsn(INVALID_LSN),
+      maxCapacity(supportedCapacity(capacity)), hourlyRate(rate),
       smallSpaces(0), mediumSpaces(0), largeSpaces(0),
-      usedSmallSpaces(0), usedMediumSpaces(0), usedLargeSpaces(0) {
-    // Ĭϳλãͳλ
-    int eachType = capacity / 3;
+      allocationPolicy(policy) {
+    for (int i = 0; i < 3; i++) {
+        spaceReserve[i] = 0;
+    }
+    
+    // 默认车位配置：各类型车位数量相等
+    int eachType = maxCapacity / 3;
     smallSpaces = eachType;
     mediumSpaces = eachType;
-    largeSpaces = capacity - 2 * eachType; // ȷȷ
+    largeSpaces = maxCapacity - 2 * eachType; // 确保总数正确
+    resetSpaces();
 }
 
-// óλ
-void ParkingSystem::setParkingSpaces(int small, int medium, int large) {
+// 设置车位配置（数量超出范围时拒绝，原配置不变）
+bool ParkingSystem::setParkingSpaces(int small, int medium, int large) {
+    int counts[3] = { small, medium, large };
+    for (int i = 0; i < 3; i++) {
+        if (counts[i] < 0 || counts[i] > MAX_SPACES_PER_TYPE) {
+            return false;
+        }
+    }
     smallSpaces = small;
     mediumSpaces = medium;
     largeSpaces = large;
     
-    // ʹóλ
-    usedSmallSpaces = 0;
-    usedMediumSpaces = 0;
-    usedLargeSpaces = 0;
+    // 重置已使用车位计数和占用位图
+    resetSpaces();
+    return true;
+}
+
+// 设置各类型车位的保留量
+void ParkingSystem::setSpaceReserve(int small, int medium, int large) {
+    spaceReserve[SPACE_SMALL] = small > 0 ? small : 0;
+    spaceReserve[SPACE_MEDIUM] = medium > 0 ? medium : 0;
+    spaceReserve[SPACE_LARGE] = large > 0 ? large : 0;
 }
 
-// Ƿкʵĳλ
+// 获取车位分配策略
+AllocationPolicyKind ParkingSystem::getAllocationPolicy() const {
+    return allocationPolicy;
+}
+
+// 按车位数量重建空的占用位图并清零计数
+void ParkingSystem::resetSpaces() {
+    // 车位数量已由调用方检查，不超过MAX_SPACES_PER_TYPE
+    int counts[3] = { smallSpaces, mediumSpaces, largeSpaces };
+    for (int i = 0; i < 3; i++) {
+        spaceMaps[i].reset(counts[i]);
+        usedSpaces[i].store(0);
+    }
+}
+
+// 检查是否有合适的车位可用
 bool ParkingSystem::hasSuitableSpace(int carType) const {
-    switch(carType) {
-        case 0: // Сͳ
-            return usedSmallSpaces < smallSpaces;
-        case 1: // ͳ
-            return usedMediumSpaces < mediumSpaces;
-        case 2: // ͳ
-            return usedLargeSpaces < largeSpaces;
-        default:
-            return false;
+    return chooseSpace(carType) != -1;
+}
+
+// 按策略选择车位类型：按候选次序取第一个占用数低于上限的类型
+// 交接的车位已经计入占用数，车辆接手它不会增加占用，所以该类型的占用数等于上限时也可以接手
+template <class Policy>
+int ParkingSystem::chooseSpaceWith(const Policy& policy, int carType, int heldType) const {
+    for (int index = 0; ; index++) {
+        int spaceType = Policy::candidate(carType, index);
+        if (spaceType == -1) {
+            return -1;
+        }
+        int limit = policy.limit(carType, spaceType, spaceMaps[spaceType].size());
+        int used = usedSpaces[spaceType].load();
+        if (limit > 0 && (spaceType == heldType ? used <= limit : used < limit)) {
+            return spaceType;
+        }
     }
 }
 
-// 䳵λ
-int ParkingSystem::allocateParkingSpace(int carType) {
-    switch(carType) {
-        case 0: // Сͳ
-            if (usedSmallSpaces < smallSpaces) {
-                usedSmallSpaces++;
-                return 0; // SPACE_SMALL
-            }
-            break;
-        case 1: // ͳ
-            if (usedMediumSpaces < mediumSpaces) {
-                usedMediumSpaces++;
-                return 1; // SPACE_MEDIUM
-            }
-            break;
-        case 2: // ͳ
-            if (usedLargeSpaces < largeSpaces) {
-                usedLargeSpaces++;
-                return 2; // SPACE_LARGE
-            }
+// 按策略分配车位：按候选次序依次尝试，上限在占计数时检查，多个大门线程同时分配也不会超出
+template <class Policy>
+int ParkingSystem::allocateWith(const Policy& policy, int carType, int& spaceId) {
+    for (int index = 0; ; index++) {
+        int spaceType = Policy::candidate(carType, index);
+        if (spaceType == -1) {
             break;
+        }
+        int limit = policy.limit(carType, spaceType, spaceMaps[spaceType].size());
+        if (limit > 0 && (spaceId = takeSpace(spaceType, limit)) != -1) {
+            return spaceType;
+        }
     }
-    return -1; // ޷
+    spaceId = -1;
+    return -1; // 无法分配
 }
 
-// ͷųλ
-void ParkingSystem::releaseParkingSpace(int spaceType) {
-    switch(spaceType) {
-        case 0: // SPACE_SMALL
-            if (usedSmallSpaces > 0) usedSmallSpaces--;
-            break;
-        case 1: // SPACE_MEDIUM
-            if (usedMediumSpaces > 0) usedMediumSpaces--;
-            break;
-        case 2: // SPACE_LARGE
-            if (usedLargeSpaces > 0) usedLargeSpaces--;
-            break;
+// 按策略统计空位：各候选类型低于上限的部分之和
+template <class Policy>
+int ParkingSystem::countFreeWith(const Policy& policy, int carType) const {
+    int free = 0;
+    for (int index = 0; ; index++) {
+        int spaceType = Policy::candidate(carType, index);
+        if (spaceType == -1) {
+            return free;
+        }
+        int room = policy.limit(carType, spaceType, spaceMaps[spaceType].size()) - usedSpaces[spaceType].load();
+        if (room > 0) {
+            free += room;
+        }
     }
 }
 
-// 
-int ParkingSystem::carArrival(const string& licensePlate, int carType, time_t arrivalTime) {
-    // 鳵ǷѴ
-    if (findCar(licensePlate) != 0) {
-        cout << "󣺳ƺ " << licensePlate << " Ѵڣ" << endl;
+// 按分配策略选择车位类型
+int ParkingSystem::chooseSpace(int carType, int heldType) const {
+    switch(allocationPolicy) {
+        case ALLOCATE_BEST_FIT:
+            return chooseSpaceWith(BestFitPolicy(), carType, heldType);
+        case ALLOCATE_RESERVE_AWARE:
+            return chooseSpaceWith(ReserveAwarePolicy(spaceReserve), carType, heldType);
+        default:
+            return chooseSpaceWith(StrictPolicy(), carType, heldType);
+    }
+}
+
+// 占用一个指定类型的车位
+// 先占计数（比较并交换，多个大门线程同时分配也不会超出车位数量），再在位图中取编号最小的空位。
+// 释放时先清位图再减计数，占到计数后位图中一定有空位；
+// 但其他大门同时占用和释放时空位可能在字之间移动，一遍扫描没有找到就重新扫描
+int ParkingSystem::takeSpace(int spaceType, int limit) {
+    if (spaceType < SPACE_SMALL || spaceType > SPACE_LARGE) {
         return -1;
     }
-    
-    // 
-    Car car(licensePlate, static_cast<CarType>(carType), arrivalTime);
-    
-    // ͣǷпλ
-    if (hasSuitableSpace(carType)) {
-        // 䳵λ
-        int spaceType = allocateParkingSpace(carType);
-        if (spaceType == -1) {
-            cout << "޷䳵λ" << endl;
-            return -1;
-        }
-        
-        // óλ
-        car.setSpaceType(static_cast<ParkingSpaceType>(spaceType));
-        
-        // ǷгҪ·򻯰汾
-        // ʵϵͳУҪĿ공λǷ赲
-        // ǼͣΪգгҪ·
-        if (!parkingLot.isEmpty()) {
-            // ʾ·
-            cout << "\n=== · ===" << endl;
-            
-            // 1: Ƿг赲
-            cout << "1: Ŀ공λǷг赲" << endl;
-            
-            // ȡͣеĳϢ
-            // ע⣺Stackûṩ򻯴
-            // ʵϵͳУҪЩ赲Ŀ공λ
-            
-            // гҪ·
-            // ʵϵͳУҪĿ공λλȷЩҪ·
-            vector<string> movedCars;
-            
-            // ͣǷгҪ·
-            // 򻯣ͣгҪ·³
-            // ʵϵͳУҪĿ공λλȷ
-            int parkingSize = parkingLot.size();
-            if (parkingSize > 0) {
-                cout << "  -  " << parkingSize << " 赲Ŀ공λ" << endl;
-                
-                // ģ·
-                // ʵϵͳУҪ赲ĳƵ򳵵
-                cout << "  - ģ·赲򳵵ȴ" << endl;
-                
-                // ¼ǣ
-                for (int i = 1; i <= parkingSize; i++) {
-                    // ȡϢ򻯴
-                    // ʵϵͳУҪȡʵ赲ĳ
-                    string fakeLicense = "赲" + to_string(i);
-                    movedCars.push_back(fakeLicense);
-                }
-                
-                // ʾǣ򳵵˳
-                if (!movedCars.empty()) {
-                    cout << "ǣ򳵵˳򣨴ǰ󣩣";
-                    for (size_t i = 0; i < movedCars.size(); i++) {
-                        cout << movedCars[i];
-                        if (i < movedCars.size() - 1) cout << "  ";
-                    }
-                    cout << endl;
-                }
-            } else {
-                cout << "  - ޳赲ֱͣ" << endl;
-            }
-            
-            // 2: ³ͣĿ공λ
-            cout << "2:  " << licensePlate << " ͣĿ공λ" << endl;
-            
-            // ͣͣ
-            if (parkingLot.push(car)) {
-                cout << "  -  " << licensePlate << " ѳɹͣ복λ" << endl;
-                
-                // 3: ·ĳԭӺ򳵵복
-                cout << "3: ·ĳԭӺ򳵵복" << endl;
-                
-                if (!movedCars.empty()) {
-                    // ģ·½
-                    for (size_t i = 0; i < movedCars.size(); i++) {
-                        cout << "  -  " << movedCars[i] << " Ӻ򳵵ԭصͣ" << endl;
-                    }
-                    
-                    // ʾǣ½ͣ˳
-                    cout << "ǣ½ͣ˳򣨴ǰ󣩣";
-                    for (size_t i = 0; i < movedCars.size(); i++) {
-                        cout << movedCars[i];
-                        if (i < movedCars.size() - 1) cout << "  ";
-                    }
-                    cout << endl;
-                } else {
-                    cout << "  - ·" << endl;
-                }
-                
-                cout << "=== · ===" << endl;
-                
-                // ʾϢ
-                cout << "\nУʱӱУ϶" << endl;
-                
-                return 0;
-            } else {
-                // pushʧܣͷѷĳλ
-                releaseParkingSpace(spaceType);
-                cout << "ͣ" << endl;
-                return -1;
+    if (limit > spaceMaps[spaceType].size()) {
+        limit = spaceMaps[spaceType].size();
+    }
+    if (!usedSpaces[spaceType].tryAcquire(limit)) {
+        return -1;
+    }
+    int spaceId;
+    while ((spaceId = spaceMaps[spaceType].acquireFirstFree()) == -1) {
+    }
+    return spaceId;
+}
+
+// 占用指定编号的车位
+bool ParkingSystem::takeSpaceAt(int spaceType, int spaceId) {
+    switch(spaceType) {
+        case SPACE_SMALL:
+        case SPACE_MEDIUM:
+        case SPACE_LARGE:
+            if (!usedSpaces[spaceType].tryAcquire(spaceMaps[spaceType].size())) {
+                return false;
             }
-        } else {
-            // ͣΪգֱͣ
-            // ͣͣ
-            if (parkingLot.push(car)) {
-                cout << " " << licensePlate << " ͣͣλͣ" 
-                     << car.getSpaceTypeString() << endl;
-                
-                // ʾϢ
-                cout << "УʱӱУ϶" << endl;
-                cout << "ͣΪգ·" << endl;
-                
-                return 0;
-            } else {
-                // pushʧܣͷѷĳλ
-                releaseParkingSpace(spaceType);
-                cout << "ͣ" << endl;
-                return -1;
+            if (!spaceMaps[spaceType].acquire(spaceId)) {
+                usedSpaces[spaceType].release();
+                return false;
             }
-        }
-    } else {
-        // ͣͣ򳵵
-        waitingLane.enqueue(car);
-        cout << "ͣ " << licensePlate << " ѽ򳵵ȴ" << endl;
-        return 1;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 分配车位（按构造时选定的策略调用对应的模板实例）
+int ParkingSystem::allocateParkingSpace(int carType, int& spaceId) {
+    switch(allocationPolicy) {
+        case ALLOCATE_BEST_FIT:
+            return allocateWith(BestFitPolicy(), carType, spaceId);
+        case ALLOCATE_RESERVE_AWARE:
+            return allocateWith(ReserveAwarePolicy(spaceReserve), carType, spaceId);
+        default:
+            return allocateWith(StrictPolicy(), carType, spaceId);
+    }
+}
+
+// 释放车位（先清位图再减计数，计数始终不少于位图中已占用的车位）
+void ParkingSystem::releaseParkingSpace(int spaceType, int spaceId) {
+    if (spaceType >= SPACE_SMALL && spaceType <= SPACE_LARGE) {
+        spaceMaps[spaceType].release(spaceId);
+        usedSpaces[spaceType].release();
+    }
+}
+
+// 车辆到达
+ArrivalResult ParkingSystem::carArrival(const string& licensePlate, int carType, time_t arrivalTime) {
+    if (metrics == nullptr && tracer == nullptr) {
+        return arrive(licensePlate, carType, arrivalTime);
+    }
+    // 到达之后放行的候车车辆记在暂存区中（没有放行时保持为空）
+    localScratch().admitted.clear();
+    TraceScope span(tracer, "carArrival");
+    uint64_t start = metrics != nullptr ? ParkingMetrics::now() : 0;
+    ArrivalResult result = arrive(licensePlate, carType, arrivalTime);
+    span.setValue(result.outcome);
+    if (metrics != nullptr) {
+        metrics->recordArrival(result.outcome, ParkingMetrics::now() - start);
+        recordAdmissions(arrivalTime);
+    }
+    return result;
+}
+
+// 车辆离开
+DepartureResult ParkingSystem::carDeparture(const string& licensePlate, time_t departureTime) {
+    if (metrics == nullptr && tracer == nullptr) {
+        return depart(licensePlate, departureTime);
+    }
+    TraceScope span(tracer, "carDeparture");
+    uint64_t start = metrics != nullptr ? ParkingMetrics::now() : 0;
+    DepartureResult result = depart(licensePlate, departureTime);
+    span.setValue(result.outcome);
+    if (metrics != nullptr) {
+        metrics->recordDeparture(result.outcome, result.makeWayCount, ParkingMetrics::now() - start);
+        recordAdmissions(departureTime);
+    }
+    return result;
+}
+
+// 记录本次操作放行的候车车辆的候车时间
+void ParkingSystem::recordAdmissions(time_t operationTime) {
+    const vector<Car>& admitted = localScratch().admitted;
+    for (size_t i = 0; i < admitted.size(); i++) {
+        time_t waited = operationTime - admitted[i].getEntryTime();
+        metrics->recordLaneAdmission(waited > 0 ? static_cast<uint64_t>(waited) : 0);
+    }
+}
+
+// 更新候车车辆数
+void ParkingSystem::storeWaitingCount(int count) {
+    int previous = waitingCount.load();
+    waitingCount.store(count);
+    if (metrics != nullptr && count != previous) {
+        metrics->addLaneDepth(count - previous);
     }
 }
 
-// 뿪
-bool ParkingSystem::carDeparture(const string& licensePlate, time_t departureTime) {
-    // ͣ
-    int position = parkingLot.findCar(licensePlate);
+// 处理车辆到达
+ArrivalResult ParkingSystem::arrive(const string& licensePlate, int carType, time_t arrivalTime) {
+    ArrivalResult result;
+    PlateView plate(licensePlate);
     
-    if (position > 0) {
-        // ͣ
-        Car car = parkingLot.getCarAt(position);
-        
-        // 뿪ʱ
-        car.setExitTime(departureTime);
-        
-        // 
-        double fee = car.calculateFee(hourlyRate);
-        long duration = car.getParkingDuration();
-        
-        // ʾϢ
-        cout << "\n==========================================" << endl;
-        cout << "뿪Ϣ" << endl;
-        cout << "ƺţ" << car.getLicensePlate() << endl;
-        cout << "ͣ" << car.getTypeString() << endl;
-        cout << "λͣ" << car.getSpaceTypeString() << endl;
-        cout << "ʱ䣺" << timeToString(car.getEntryTime()) << endl;
-        cout << "뿪ʱ䣺" << timeToString(departureTime) << endl;
-        cout << "ͣʱ" << duration / 3600 << "Сʱ" << duration % 3600 / 60 << "" << endl;
-        cout << "Ӧã" << fixed << setprecision(2) << fee << "Ԫ" << endl;
-        cout << "==========================================" << endl;
-        
-        // ͷųλ
-        releaseParkingSpace(car.getSpaceType());
-        
-        // ƳҪʱƶ
-        cout << "\n=== 뿪· ===" << endl;
-        
-        // 1. Ŀ공֮ĳƵʱջЩĿ공֮룬Ҫ·
-        cout << "1: Ŀ공֮ĳʱվ·" << endl;
-        vector<string> movedCars; // ¼ǣĳ˳
-        for (int i = 1; i < position; i++) {
-            Car tempCar = parkingLot.peek(); // ȡջŵĳ
-            cout << "  -  " << tempCar.getLicensePlate() << "Ŀ공֮룩ʱվ·" << endl;
-            movedCars.push_back(tempCar.getLicensePlate()); // ¼ƺ
-            parkingLot.pop();
-            // ʱջ·˳
-            tempStack.push(tempCar);
+    // 检查车牌长度（车辆记录内联存储车牌，不能超过定长缓冲区）和车型
+    if (!Car::isValidPlate(licensePlate)) {
+        result.outcome = ARRIVAL_INVALID_PLATE;
+        sink->onArrival(plate, result);
+        return result;
+    }
+    if (carType < SMALL || carType > LARGE) {
+        result.outcome = ARRIVAL_INVALID_TYPE;
+        sink->onArrival(plate, result);
+        return result;
+    }
+    
+    // 检查车辆是否已存在（车牌已登记即表示车辆在停车场或候车道中），
+    // 不存在则在大门处登记车牌并分配车辆ID；两个大门同时到达同一车牌时只有一个能登记成功
+    Car car(licensePlate, static_cast<CarType>(carType), arrivalTime);
+    bool duplicate = false;
+    {
+        TraceScope span(tracer, "register");
+        lock_guard<mutex> guard(locks.registry);
+        if (plates.find(plate) != INVALID_VEHICLE_ID) {
+            duplicate = true;
+        } else {
+            car.setVehicleId(plates.intern(plate));
+            carIndex.setPending(car.getVehicleId());
         }
+    }
+    if (duplicate) {
+        result.outcome = ARRIVAL_DUPLICATE;
+        sink->onArrival(plate, result);
+        return result;
+    }
+    
+    // 分配车位（原子操作），分配成功的车辆停入停车场，否则进入候车道
+    int spaceId;
+    TraceScope allocateSpan(tracer, "allocate");
+    int spaceType = allocateParkingSpace(carType, spaceId);
+    allocateSpan.finish();
+    if (spaceType != -1) {
+        // 设置车位类型和编号
+        car.setSpaceType(static_cast<ParkingSpaceType>(spaceType));
+        car.setSpaceId(spaceId);
         
-        // ʾǣ򳵵˳
-        if (!movedCars.empty()) {
-            cout << "ǣ򳵵˳򣨴ǰ󣩣";
-            for (size_t i = 0; i < movedCars.size(); i++) {
-                cout << movedCars[i];
-                if (i < movedCars.size() - 1) cout << "  ";
+        // 新车停在栈顶（最靠近大门的位置），不会被其他车辆阻挡，无需让路
+        bool parked;
+        {
+            TraceScope waitSpan(allocateSpan, "wait lot lock");
+            lock_guard<mutex> lotGuard(locks.lot);
+            waitSpan.finish();
+            TraceScope parkSpan(waitSpan, "park", car.getVehicleId());
+            parked = parkInLot(car);
+            if (parked) {
+                result.slot = parkingLot.size() - 1;
+                logOperation(JOURNAL_ARRIVAL, plate, carType, spaceType, spaceId, arrivalTime);
             }
-            cout << endl;
         }
-        
-        // 2. ƳĿ공
-        cout << "2: Ŀ공 " << car.getLicensePlate() << " " << endl;
-        parkingLot.pop();
-        
-        // 3. ʱջеĳƻͣԭ
-        cout << "3: ·ĳԭʱվ복" << endl;
-        // ע⣺ʱջLIFOĳջ
-        // ҪԭŻأֱӰ˳tempStackȡŻͣ
-        vector<string> reenteredCars; // ¼½ĳ˳
-        while (!tempStack.isEmpty()) {
-            Car tempCar = tempStack.peek();
-            tempStack.pop();
-            parkingLot.push(tempCar);
-            cout << "  -  " << tempCar.getLicensePlate() << " ʱվԭصͣ" << endl;
-            reenteredCars.push_back(tempCar.getLicensePlate()); // ¼ƺ
+        if (!parked) {
+            // 如果push失败，释放已分配的车位
+            releaseParkingSpace(spaceType, spaceId);
+            releaseVehicleId(car.getVehicleId());
+            result.outcome = ARRIVAL_NO_SPACE;
+            sink->onArrival(plate, result);
+            return result;
         }
         
-        // ʾǣ½ͣ˳
-        if (!reenteredCars.empty()) {
-            cout << "ǣ½ͣ˳򣨴ǰ󣩣";
-            for (size_t i = 0; i < reenteredCars.size(); i++) {
-                cout << reenteredCars[i];
-                if (i < reenteredCars.size() - 1) cout << "  ";
-            }
-            cout << endl;
+        result.outcome = ARRIVAL_PARKED;
+        result.spaceType = car.getSpaceType();
+        result.spaceId = spaceId;
+    } else {
+        // 没有合适的车位，放入候车道入口队列，不等候车道的锁；
+        // 能立即拿到候车道的锁时顺便并入候车道（单线程使用时总是如此），否则由下一个持有候车道锁的操作并入
+        if (!inbox.tryEnqueue(car)) {
+            // 入口队列已满，退回加锁入队（先并入入口队列中较早到达的车辆，保持到达次序）
+            lock_guard<mutex> laneGuard(locks.lane);
+            drainInbox();
+            enqueueWaiting(car);
+            logOperation(JOURNAL_ARRIVAL, plate, carType, JOURNAL_NO_SPACE, -1, arrivalTime);
+        } else if (locks.lane.try_lock()) {
+            drainInbox();
+            locks.lane.unlock();
         }
-        
-        cout << "=== · ===" << endl;
-        
-        // 4. Ƿк򳵵Խͣпλ
+        result.outcome = ARRIVAL_WAITING;
+    }
+    
+    result.vehicleId = car.getVehicleId();
+    sink->onArrival(plate, result);
+    
+    // 入队之后再检查一次车位：离开时先释放车位再检查候车车辆，两边至少有一边会看到对方，
+    // 分配失败之后其他大门腾出的车位不会被错过
+    if (result.outcome == ARRIVAL_WAITING && hasSuitableSpace(carType)) {
         moveFromWaitingLaneToParkingLot();
+    }
+    verifyIndex();
+    return result;
+}
+
+// 处理车辆离开
+DepartureResult ParkingSystem::depart(const string& licensePlate, time_t departureTime) {
+    DepartureResult result;
+    PlateView plate(licensePlate);
+    OperationScratch& scratch = localScratch();
+    scratch.moves.clear();
+    scratch.admitted.clear();
+    
+    // 车牌只在登记表中比较一次，之后按车辆ID通过位置索引直接定位车辆
+    // （未登记的车牌得到INVALID_VEHICLE_ID，索引返回LOCATION_NONE）。
+    // 查找和加锁之间车辆可能被其他大门放行（候车道 -> 停车场），加锁后再确认一次，位置变了就重新查找
+    bool drained = false;
+    for (;;) {
+        uint32_t vehicleId;
+        TraceScope lookupSpan(tracer, "lookup");
+        CarLocation location = locate(plate, vehicleId);
+        lookupSpan.finish();
         
-        return true;
-    } else {
-        // ں򳵵
-        position = waitingLane.findCar(licensePlate);
-        if (position > 0) {
-            // ں򳵵УֱƳ
-            // ע⣺򳵵еĳշ
-            cout << " " << licensePlate << " Ӻ򳵵뿪շ" << endl;
+        if (location.kind == LOCATION_LOT) {
+            TraceScope waitSpan(lookupSpan, "wait lot lock");
+            lock_guard<mutex> lotGuard(locks.lot);
+            waitSpan.finish();
+            location = locate(plate, vehicleId);
+            if (location.kind != LOCATION_LOT) {
+                continue;
+            }
+            
+            // 车辆在停车场中，设置离开时间并计算费用
+            result.car = parkingLot.at(location.slot);
+            result.car.setExitTime(departureTime);
+            result.fee = result.car.calculateFee(hourlyRate, departureTime);
+            result.duration = result.car.getParkingDuration(departureTime);
             
-            // ڶв֧мɾҪؽ
-            Queue newQueue;
-            bool found = false;
+            // 先写日志再移除并注销车辆ID：同一车牌再次到达的记录一定排在这条离开记录之后
+            logOperation(JOURNAL_DEPARTURE, plate, 0, JOURNAL_NO_SPACE, -1, departureTime);
             
-            // ԭУҪɾĳ
-            while (!waitingLane.isEmpty()) {
-                Car car = waitingLane.getFront();
-                waitingLane.dequeue();
+            // 原地移除目标车辆：在目标车辆之后开入的车辆整体向北挪动一个车位
+            int targetSlot = location.slot;
+            TraceScope removeSpan(tracer, "remove", static_cast<uint32_t>(parkingLot.size() - 1 - targetSlot));
+            removeFromLot(vehicleId, targetSlot);
+            removeSpan.finish();
+            
+            // 记录让路步骤，按离开大门的次序（从栈顶往下）；车牌复制到线程自己的暂存区
+            const size_t plateStride = Car::MAX_PLATE_LENGTH + 1;
+            int moveCount = parkingLot.size() - targetSlot;
+            TraceScope makeWaySpan(removeSpan, "make-way", static_cast<uint32_t>(moveCount));
+            scratch.plateText.resize(static_cast<size_t>(moveCount) * plateStride);
+            for (int i = 0; i < moveCount; i++) {
+                const Car& moved = parkingLot.at(parkingLot.size() - 1 - i);
+                PlateView movedPlate = moved.plate();
+                char* text = &scratch.plateText[static_cast<size_t>(i) * plateStride];
+                memcpy(text, movedPlate.data(), movedPlate.size());
                 
-                if (car.getLicensePlate() != licensePlate) {
-                    newQueue.enqueue(car);
-                } else {
-                    found = true;
+                MakeWayMove move;
+                move.vehicleId = moved.getVehicleId();
+                move.fromSlot = parkingLot.size() - i;
+                move.toSlot = parkingLot.size() - 1 - i;
+                move.plate = PlateView(text, movedPlate.size());
+                scratch.moves.push_back(move);
+            }
+            makeWaySpan.finish();
+            
+            // 腾出的车位轮到的候车车辆按分配策略正好选它时直接交给这辆车（不经过车位计数，其他大门新到的车辆不能插队），
+            // 否则释放车位；然后放行其他能找到车位的候车车辆。
+            // 没有候车车辆时不加候车道的锁；释放车位后再检查一次，期间入队的车辆也不会错过这个车位
+            int spaceType = result.car.getSpaceType();
+            int spaceId = result.car.getSpaceId();
+            TraceScope handoverSpan(makeWaySpan, "hand over space");
+            if (!hasWaitingCars()) {
+                releaseParkingSpace(spaceType, spaceId);
+                if (hasWaitingCars()) {
+                    lock_guard<mutex> laneGuard(locks.lane);
+                    admitWaiting(scratch.admitted);
                 }
+            } else {
+                lock_guard<mutex> laneGuard(locks.lane);
+                drainInbox();
+                bool eligible[WaitingLane::LANE_COUNT];
+                for (int lane = 0; lane < WaitingLane::LANE_COUNT; lane++) {
+                    eligible[lane] = chooseSpace(lane, spaceType) != -1;
+                }
+                int lane = waitingLane.pickEarliest(eligible);
+                if (lane == -1 || chooseSpace(lane, spaceType) != spaceType ||
+                    !admitFront(lane, spaceType, spaceId, scratch.admitted)) {
+                    releaseParkingSpace(spaceType, spaceId);
+                }
+                admitWaiting(scratch.admitted);
             }
+            handoverSpan.setValue(static_cast<uint32_t>(scratch.admitted.size()));
+            handoverSpan.finish();
             
-            // ¶иֵԭ
-            waitingLane = newQueue;
+            result.outcome = DEPARTURE_FROM_LOT;
+            result.makeWayMoves = scratch.moves.empty() ? nullptr : &scratch.moves[0];
+            result.makeWayCount = static_cast<int>(scratch.moves.size());
+        } else if (location.kind == LOCATION_LANE) {
+            TraceScope waitSpan(lookupSpan, "wait lane lock");
+            lock_guard<mutex> laneGuard(locks.lane);
+            waitSpan.finish();
+            location = locate(plate, vehicleId);
+            if (location.kind != LOCATION_LANE) {
+                continue;
+            }
+            TraceScope removeSpan(tracer, "remove from lane", vehicleId);
             
-            return found;
+            // 车辆在候车道中，直接移除（候车道中的车辆不收费）
+            result.car = waitingLane.getLane(location.lane).getNode(location.node).car;
+            result.car.setExitTime(departureTime);
+            
+            // 位置索引记录了车辆所在子队列和节点，直接从双向链表中摘下（O(1)），其余车辆次序不变
+            logOperation(JOURNAL_DEPARTURE, plate, 0, JOURNAL_NO_SPACE, -1, departureTime);
+            removeFromLane(vehicleId, location);
+            
+            result.outcome = DEPARTURE_FROM_LANE;
+        } else if (location.kind == LOCATION_PENDING && !drained) {
+            // 车辆还在候车道入口队列中，并入候车道后重新查找
+            // （并入后仍未找到说明到达操作还没有完成，按未找到处理）
+            lock_guard<mutex> laneGuard(locks.lane);
+            drainInbox();
+            drained = true;
+            continue;
         } else {
-            cout << "󣺳ƺ " << licensePlate << " ڣ" << endl;
-            return false;
+            result.outcome = DEPARTURE_NOT_FOUND;
         }
+        break;
     }
+    
+    // 释放全部锁之后再通知事件接收器：先是离开事件，然后是因此进入停车场的候车车辆
+    sink->onDeparture(plate, result);
+    for (size_t i = 0; i < scratch.admitted.size(); i++) {
+        sink->onLaneAdmitted(scratch.admitted[i]);
+    }
+    verifyIndex();
+    return result;
 }
 
-// ѯͣ״̬
+// 查询停车场状态
 void ParkingSystem::displayParkingStatus() const {
-    cout << "\n=== ͣ״̬ ===" << endl;
-    cout << "" << maxCapacity << " " << endl;
-    cout << "ǰͣ" << parkingLot.size() << " " << endl;
-    cout << "óλ" << getAvailableSpaces() << " " << endl;
-    cout << "\nλʹ" << endl;
-    cout << "Сͳλ" << usedSmallSpaces << "/" << smallSpaces << endl;
-    cout << "ͳλ" << usedMediumSpaces << "/" << mediumSpaces << endl;
-    cout << "ͳλ" << usedLargeSpaces << "/" << largeSpaces << endl;
+    int small, medium, large, usedSmall, usedMedium, usedLarge;
+    getSpaceInfo(small, medium, large, usedSmall, usedMedium, usedLarge);
+    
+    lock_guard<mutex> guard(locks.lot);
+    cout << "\n=== 停车场状态 ===" << endl;
+    cout << "总容量：" << maxCapacity << " 辆车" << endl;
+    cout << "当前停车数量：" << parkingLot.size() << " 辆车" << endl;
+    cout << "可用车位：" << maxCapacity - parkingLot.size() << " 个" << endl;
+    cout << "\n车位使用情况：" << endl;
+    cout << "小型车位：" << usedSmall << "/" << small << endl;
+    cout << "中型车位：" << usedMedium << "/" << medium << endl;
+    cout << "大型车位：" << usedLarge << "/" << large << endl;
     
     parkingLot.display();
 }
 
-// ѯ򳵵״̬
+// 查询候车道状态
 void ParkingSystem::displayWaitingLaneStatus() const {
-    cout << "\n=== 򳵵״̬ ===" << endl;
-    cout << "򳵵ȣ" << waitingLane.size() << " " << endl;
+    lock_guard<mutex> guard(locks.lane);
+    cout << "\n=== 候车道状态 ===" << endl;
+    cout << "候车道长度：" << waitingLane.size() << " 辆车" << endl;
     
     waitingLane.display();
 }
 
-// ѯ״̬
+// 查询所有状态
 void ParkingSystem::displayAllStatus() const {
     displayParkingStatus();
     displayWaitingLaneStatus();
 }
 
-// ҳ
+// 查找车辆
 int ParkingSystem::findCar(const string& licensePlate) const {
-    if (parkingLot.findCar(licensePlate) > 0) {
-        return 1; // ͣ
-    } else if (waitingLane.findCar(licensePlate) > 0) {
-        return 2; // ں򳵵
+    // 车牌 -> 车辆ID -> 位置，不扫描停车场和候车道
+    uint32_t vehicleId;
+    CarLocation location = locate(PlateView(licensePlate), vehicleId);
+    
+    if (location.kind == LOCATION_LOT) {
+        return 1; // 在停车场
+    } else if (location.kind == LOCATION_LANE || location.kind == LOCATION_PENDING) {
+        return 2; // 在候车道（含入口队列）
     } else {
-        return 0; // δҵ
+        return 0; // 未找到
     }
 }
 
-// ȡͣóλ
+// 获取停车场可用车位数量
 int ParkingSystem::getAvailableSpaces() const {
+    lock_guard<mutex> guard(locks.lot);
     return maxCapacity - parkingLot.size();
 }
 
-// ȡͣ
+// 获取指定车型按分配策略还能停入的车位数量（只读取计数，不加锁）
+int ParkingSystem::getFreeSpacesFor(int carType) const {
+    switch(allocationPolicy) {
+        case ALLOCATE_BEST_FIT:
+            return countFreeWith(BestFitPolicy(), carType);
+        case ALLOCATE_RESERVE_AWARE:
+            return countFreeWith(ReserveAwarePolicy(spaceReserve), carType);
+        default:
+            return countFreeWith(StrictPolicy(), carType);
+    }
+}
+
+// 获取停车场总容量
 int ParkingSystem::getTotalCapacity() const {
     return maxCapacity;
 }
 
-// ȡ򳵵
+// 获取候车道长度
 int ParkingSystem::getWaitingLaneLength() const {
-    return waitingLane.size();
+    lock_guard<mutex> guard(locks.lane);
+    return waitingLane.size() + inbox.size();
 }
 
-// Ƿпλ
+// 检查是否有空位
 bool ParkingSystem::hasAvailableSpace() const {
+    lock_guard<mutex> guard(locks.lot);
     return parkingLot.size() < maxCapacity;
 }
 
-// ͣǷ
+// 检查停车场是否已满
 bool ParkingSystem::isParkingLotFull() const {
+    lock_guard<mutex> guard(locks.lot);
     return parkingLot.size() >= maxCapacity;
 }
 
-// Ӻ򳵵ƶͣͣпλʱ
-bool ParkingSystem::moveFromWaitingLaneToParkingLot() {
-    if (waitingLane.isEmpty() || isParkingLotFull()) {
-        return false;
+// 从候车道移动车辆到停车场（当停车场有空位时）
+int ParkingSystem::moveFromWaitingLaneToParkingLot() {
+    vector<Car>& admitted = localScratch().admitted;
+    admitted.clear();
+    int moved;
+    {
+        TraceScope waitSpan(tracer, "wait lot and lane locks");
+        lock_guard<mutex> lotGuard(locks.lot);
+        lock_guard<mutex> laneGuard(locks.lane);
+        waitSpan.finish();
+        TraceScope admitSpan(waitSpan, "admit waiting");
+        moved = admitWaiting(admitted);
+        admitSpan.setValue(static_cast<uint32_t>(moved));
     }
     
-    // ȡ򳵵һ
-    Car car = waitingLane.getFront();
+    for (size_t i = 0; i < admitted.size(); i++) {
+        sink->onLaneAdmitted(admitted[i]);
+    }
+    verifyIndex();
+    return moved;
+}
+
+// 按到达次序放行能找到合适车位的候车车辆
+int ParkingSystem::admitWaiting(vector<Car>& admitted) {
+    drainInbox();
+    int moved = 0;
     
-    // Ƿкʵĳλ
-    if (hasSuitableSpace(car.getType())) {
-        // 䳵λ
-        int spaceType = allocateParkingSpace(car.getType());
+    // 每次在有合适车位的车型中放行最早到达的车辆，直到没有车辆可以停入
+    // 队头车辆等不到车位时不会挡住其他车型的车辆
+    while (!waitingLane.isEmpty() && parkingLot.size() < maxCapacity) {
+        bool eligible[WaitingLane::LANE_COUNT];
+        for (int lane = 0; lane < WaitingLane::LANE_COUNT; lane++) {
+            eligible[lane] = hasSuitableSpace(lane);
+        }
+        
+        int lane = waitingLane.pickEarliest(eligible);
+        if (lane == -1) {
+            break;
+        }
+        
+        // 分配车位
+        int spaceId;
+        int spaceType = allocateParkingSpace(waitingLane.front(lane).getType(), spaceId);
         if (spaceType == -1) {
+            break;
+        }
+        if (!admitFront(lane, spaceType, spaceId, admitted)) {
+            releaseParkingSpace(spaceType, spaceId);
+            break;
+        }
+        moved++;
+    }
+    
+    return moved;
+}
+
+// 把入口队列中的车辆并入候车道
+void ParkingSystem::drainInbox() {
+    // 入口队列先进先出，并入的次序就是各大门入队的次序，候车道按这个次序编排到达序号
+    // 入口队列为空时直接返回，不记录跟踪阶段
+    Car car;
+    if (!inbox.tryDequeue(car)) {
+        return;
+    }
+    TraceScope span(tracer, "drain inbox");
+    uint32_t drained = 0;
+    do {
+        span.setValue(++drained);
+        enqueueWaiting(car);
+        logOperation(JOURNAL_ARRIVAL, car.plate(), car.getType(), JOURNAL_NO_SPACE, -1, car.getEntryTime());
+    } while (inbox.tryDequeue(car));
+}
+
+// 判断候车道或入口队列中是否有车辆
+bool ParkingSystem::hasWaitingCars() const {
+    return waitingCount.load() > 0 || !inbox.isEmpty();
+}
+
+// 把候车道队头车辆停入停车场
+bool ParkingSystem::admitFront(int lane, int spaceType, int spaceId, vector<Car>& admitted) {
+    // 设置车位类型和编号
+    Car car = waitingLane.front(lane);
+    TraceScope span(tracer, "lane promotion", car.getVehicleId());
+    car.setSpaceType(static_cast<ParkingSpaceType>(spaceType));
+    car.setSpaceId(spaceId);
+    
+    // 先停入停车场（同时把位置索引改为停车场槽位），成功后再从候车道移除
+    if (!parkInLot(car)) {
+        return false;
+    }
+    waitingLane.dequeue(lane);
+    storeWaitingCount(waitingLane.size());
+    logOperation(JOURNAL_ADMIT, car.plate(), car.getType(), spaceType, spaceId, car.getEntryTime());
+    
+    admitted.push_back(car);
+    return true;
+}
+
+// 写入一条车辆记录：车牌号 车型 车位类型 进入时间 车位编号
+static void writeCarRecord(ostream& out, const Car& car) {
+    out << car.plate() << " " << static_cast<int>(car.getType()) << " "
+        << static_cast<int>(car.getSpaceType()) << " " << car.getEntryTime() << " "
+        << car.getSpaceId() << "\n";
+}
+
+// 读取一组车辆记录（先是数量，然后每行一辆车）
+static bool readCarRecords(istream& in, vector<Car>& cars) {
+    int count;
+    if (!(in >> count) || count < 0) {
+        return false;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        string plate;
+        int type, spaceType;
+        long long entryTime;
+        if (!(in >> plate >> type >> spaceType >> entryTime)) {
+            return false;
+        }
+        if (!Car::isValidPlate(plate) || type < 0 || type > 2 || spaceType < 0 || spaceType > 2) {
             return false;
         }
         
-        // óλ
-        car.setSpaceType(static_cast<ParkingSpaceType>(spaceType));
-        
-        // Ӻ򳵵Ƴ
-        waitingLane.dequeue();
+        // 车位编号在行末（旧版本的文件没有），没有时为-1，加载时再分配
+        string rest;
+        getline(in, rest);
+        istringstream extra(rest);
+        int spaceId;
+        if (!(extra >> spaceId)) {
+            spaceId = -1;
+        }
         
-        // ͣͣ
-        if (parkingLot.push(car)) {
-            cout << "ʾ򳵵 " << car.getLicensePlate() 
-                 << " ѽͣλͣ" << car.getSpaceTypeString() << endl;
-            return true;
-        } else {
-            // pushʧܣŻغ򳵵ͷųλ
-            waitingLane.enqueue(car);
-            releaseParkingSpace(spaceType);
-            return false;
+        Car car(plate, static_cast<CarType>(type), static_cast<time_t>(entryTime));
+        car.setSpaceType(static_cast<ParkingSpaceType>(spaceType));
+        car.setSpaceId(spaceId);
+        cars.push_back(car);
+    }
+    return true;
+}
+
+// 判断文件余下的内容是否为旧版本的格式：停车场和候车道的车辆数各一行，之后就是文件结尾，没有车辆记录
+// 两个数量都是0时新旧格式相同（都表示没有车辆），按新格式处理。判断后恢复读取位置
+static bool isCountsOnly(istream& in) {
+    istream::pos_type start = in.tellg();
+    int lotCount, laneCount;
+    bool countsOnly = (in >> lotCount >> laneCount) && lotCount >= 0 && laneCount >= 0 &&
+                      (lotCount > 0 || laneCount > 0) && (in >> ws).eof();
+    in.clear();
+    in.seekg(start);
+    return countsOnly;
+}
+
+// 给没有车位编号的停车场车辆（旧版本的文件）按次序分配编号最小的空闲车位
+static void assignMissingSpaceIds(ParkingSnapshot& snapshot) {
+    SpaceBitmap maps[3];
+    for (int i = 0; i < 3; i++) {
+        maps[i].reset(snapshot.spaces[i]);
+    }
+    for (size_t i = 0; i < snapshot.lot.size(); i++) {
+        const Car& car = snapshot.lot[i];
+        maps[car.getSpaceType()].acquire(car.getSpaceId());
+    }
+    for (size_t i = 0; i < snapshot.lot.size(); i++) {
+        Car& car = snapshot.lot[i];
+        if (car.getSpaceId() == -1) {
+            car.setSpaceId(maps[car.getSpaceType()].acquireFirstFree());
         }
     }
-    
-    return false;
 }
 
-// ݵļ
+// 保存数据到文件
 bool ParkingSystem::saveToFile(const string& filename) const {
     ofstream outFile(filename);
     if (!outFile) {
         return false;
     }
+    lock_guard<mutex> lotGuard(locks.lot);
+    lock_guard<mutex> laneGuard(locks.lane);
     
-    // ϵͳ
+    // 保存系统配置
     outFile << maxCapacity << " " << hourlyRate << endl;
     outFile << smallSpaces << " " << mediumSpaces << " " << largeSpaces << endl;
-    outFile << usedSmallSpaces << " " << usedMediumSpaces << " " << usedLargeSpaces << endl;
+    outFile << usedSpaces[SPACE_SMALL].load() << " " << usedSpaces[SPACE_MEDIUM].load() << " "
+            << usedSpaces[SPACE_LARGE].load() << endl;
     
-    // ͣ
+    // 保存停车场车辆（从栈底开始，加载时按同样次序入栈即可还原）
     outFile << parkingLot.size() << endl;
-    // ע⣺ջҪӵײʼ
-    // 򻯴ʵҪջ
+    for (Stack::const_iterator it = parkingLot.begin(); it != parkingLot.end(); ++it) {
+        writeCarRecord(outFile, *it);
+    }
     
-    // 򳵵
+    // 保存候车道车辆（按到达次序）
     outFile << waitingLane.size() << endl;
-    // пԴӶͷʼ
+    for (WaitingLane::const_iterator it = waitingLane.begin(); it != waitingLane.end(); ++it) {
+        writeCarRecord(outFile, *it);
+    }
     
     outFile.close();
-    return true;
+    return !outFile.fail();
 }
 
-// ļ
+// 从文件加载数据
 bool ParkingSystem::loadFromFile(const string& filename) {
     ifstream inFile(filename);
     if (!inFile) {
         return false;
     }
     
-    // ϵͳ
-    inFile >> maxCapacity >> hourlyRate;
-    inFile >> smallSpaces >> mediumSpaces >> largeSpaces;
-    inFile >> usedSmallSpaces >> usedMediumSpaces >> usedLargeSpaces;
+    // 加载系统配置
+    int capacity;
+    double rate;
+    int small, medium, large;
+    int usedSmall, usedMedium, usedLarge;
+    if (!(inFile >> capacity >> rate >> small >> medium >> large
+                 >> usedSmall >> usedMedium >> usedLarge) || capacity < 0) {
+        return false;
+    }
+    int counts[3] = { small, medium, large };
+    for (int i = 0; i < 3; i++) {
+        if (counts[i] < 0 || counts[i] > MAX_SPACES_PER_TYPE) {
+            return false;
+        }
+    }
     
-    // ע⣺ļأʵҪʵ
+    // 旧版本的文件只有车辆数量，没有车辆记录，此时只恢复配置（保留当前的车辆）
+    if (isCountsOnly(inFile)) {
+        inFile.close();
+        return loadConfigOnly(capacity, rate, small, medium, large);
+    }
     
+    // 新格式：车辆记录必须完整，之后就是文件结尾；损坏或截断时返回false，当前状态不变
+    ParkingSnapshot snapshot;
+    snapshot.maxCapacity = capacity;
+    snapshot.hourlyRate = rate;
+    snapshot.spaces[0] = small;
+    snapshot.spaces[1] = medium;
+    snapshot.spaces[2] = large;
+    snapshot.journalLsn = INVALID_LSN;
+    bool complete = readCarRecords(inFile, snapshot.lot) && readCarRecords(inFile, snapshot.lane) &&
+                    (inFile >> ws).eof();
     inFile.close();
+    if (!complete) {
+        return false;
+    }
+    
+    // 按文件中的次序编号后整体重建（已使用车位按车辆记录重新统计）
+    assignMissingSpaceIds(snapshot);
+    renumberVehicles(snapshot);
+    return restoreFrom(viewOf(snapshot));
+}
+
+// 只加载配置（旧版本的文件）
+bool ParkingSystem::loadConfigOnly(int capacity, double rate, int small, int medium, int large) {
+    // 停车场中车辆的车位编号必须在新的车位数量之内
+    int spaces[3] = { small, medium, large };
+    for (Stack::const_iterator it = parkingLot.begin(); it != parkingLot.end(); ++it) {
+        if (it->getSpaceId() >= spaces[it->getSpaceType()]) {
+            return false;
+        }
+    }
+    
+    // 停车场容量随配置调整（不能小于已停放的车辆数）
+    if (!parkingLot.setCapacity(capacity)) {
+        return false;
+    }
+    
+    maxCapacity = capacity;
+    hourlyRate = rate;
+    smallSpaces = small;
+    mediumSpaces = medium;
+    largeSpaces = large;
+    
+    // 已使用车位按停车场中的车辆重新标记（文件中的已使用数量没有对应的车辆，不再采用）
+    resetSpaces();
+    for (Stack::const_iterator it = parkingLot.begin(); it != parkingLot.end(); ++it) {
+        takeSpaceAt(it->getSpaceType(), it->getSpaceId());
+    }
+    
+    verifyIndex();
+    return true;
+}
+
+// 取得当前状态的快照
+void ParkingSystem::captureSnapshot(ParkingSnapshot& snapshot) const {
+    freezeSnapshot(snapshot);
+    renumberVehicles(snapshot);
+}
+
+// 冻结当前状态
+bool ParkingSystem::freezeSnapshot(ParkingSnapshot& snapshot, bool rotateJournal) const {
+    // 持有停车场和候车道的锁：日志记录都在这两把锁内追加，冻结的状态正好包含到当前最后一条记录为止
+    lock_guard<mutex> lotGuard(locks.lot);
+    lock_guard<mutex> laneGuard(locks.lane);
+    copyState(snapshot);
+    
+    // 在锁内切换日志段，冻结与切换之间没有其他变更，新日志段从冻结时的下一条记录开始
+    return !rotateJournal || journal == nullptr || journal->rotate();
+}
+
+// 开始分段冻结
+bool ParkingSystem::beginFreeze(ParkingSnapshot& snapshot, bool rotateJournal) {
+    // 先在锁外按当前车辆数准备好缓冲区，锁内只需补上冻结前新停入的少数车辆
+    int lotSize;
+    {
+        lock_guard<mutex> lotGuard(locks.lot);
+        if (frozenLot.target != nullptr) {
+            return false;
+        }
+        lotSize = parkingLot.size();
+    }
+    snapshot.lot.resize(lotSize);
+    
+    lock_guard<mutex> lotGuard(locks.lot);
+    lock_guard<mutex> laneGuard(locks.lane);
+    if (frozenLot.target != nullptr) {
+        return false;
+    }
+    if (rotateJournal && journal != nullptr && !journal->rotate()) {
+        return false;
+    }
+    copyConfigAndLane(snapshot);
+    snapshot.lot.resize(parkingLot.size());
+    frozenLot.target = &snapshot;
+    frozenLot.copied = 0;
+    frozenLot.limit = parkingLot.size();
+    return true;
+}
+
+// 分段复制冻结的停车场车辆
+bool ParkingSystem::copyFrozenLot(int maxCars) {
+    lock_guard<mutex> lotGuard(locks.lot);
+    if (frozenLot.target == nullptr) {
+        return true;
+    }
+    int end = frozenLot.limit - frozenLot.copied > maxCars ? frozenLot.copied + maxCars : frozenLot.limit;
+    if (end > frozenLot.copied) {
+        memcpy(&frozenLot.target->lot[frozenLot.copied], &parkingLot.at(frozenLot.copied),
+               (end - frozenLot.copied) * sizeof(Car));
+    }
+    frozenLot.copied = end;
+    if (frozenLot.copied < frozenLot.limit) {
+        return false;
+    }
+    frozenLot.target = nullptr;
+    return true;
+}
+
+// 保存将被挪动的冻结车辆
+void ParkingSystem::preserveFrozenLot(int slot) {
+    if (frozenLot.target == nullptr) {
+        return;
+    }
+    // [slot, limit)中尚未分段复制的部分在挪动之前写入；之后停入的车辆位于limit及以上，不属于冻结的状态
+    int start = slot > frozenLot.copied ? slot : frozenLot.copied;
+    if (start < frozenLot.limit) {
+        memcpy(&frozenLot.target->lot[start], &parkingLot.at(start), (frozenLot.limit - start) * sizeof(Car));
+        frozenLot.limit = start;
+    }
+}
+
+// 复制当前状态
+void ParkingSystem::copyState(ParkingSnapshot& snapshot) const {
+    copyConfigAndLane(snapshot);
+    
+    // 停车场是连续存储的车辆记录，整块复制
+    snapshot.lot.assign(parkingLot.begin(), parkingLot.end());
+}
+
+// 复制配置和候车道
+void ParkingSystem::copyConfigAndLane(ParkingSnapshot& snapshot) const {
+    snapshot.maxCapacity = maxCapacity;
+    snapshot.hourlyRate = hourlyRate;
+    snapshot.spaces[0] = smallSpaces;
+    snapshot.spaces[1] = mediumSpaces;
+    snapshot.spaces[2] = largeSpaces;
+    
+    // 挂接日志时，日志中已有的记录都已反映在当前状态中（状态被整体替换时也以当前状态为准）
+    snapshot.journalLsn = journal != nullptr ? journal->lastLsn() : appliedLsn;
+    
+    // 候车道按到达次序逐辆复制
+    snapshot.lane.clear();
+    snapshot.lane.reserve(waitingLane.size());
+    for (WaitingLane::const_iterator it = waitingLane.begin(); it != waitingLane.end(); ++it) {
+        snapshot.lane.push_back(*it);
+    }
+}
+
+// 保存二进制快照
+bool ParkingSystem::saveSnapshot(const string& filename) const {
+    ParkingSnapshot snapshot;
+    captureSnapshot(snapshot);
+    return writeSnapshot(filename, snapshot);
+}
+
+// 加载二进制快照
+bool ParkingSystem::loadSnapshot(const string& filename) {
+    // 映射整个文件，校验后直接从映射的内存整块构造停车场和候车道
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    
+    SnapshotView view;
+    if (!parseSnapshot(file.data(), file.size(), view)) {
+        return false;
+    }
+    return restoreFrom(view);
+}
+
+// 从快照视图整体恢复停车场、候车道、登记表和位置索引
+bool ParkingSystem::restoreFrom(const SnapshotView& view) {
+    if (view.maxCapacity < 0 || view.lotCount < 0 || view.laneCount < 0 || view.lotCount > view.maxCapacity) {
+        return false;
+    }
+    
+    for (int i = 0; i < 3; i++) {
+        if (view.spaces[i] < 0 || view.spaces[i] > MAX_SPACES_PER_TYPE) {
+            return false;
+        }
+    }
+    
+    // 校验车辆记录并登记车牌：新登记表按次序分配ID，车牌重复时会返回已有的ID；
+    // 停车场车辆的车位编号必须在范围内且互不相同，候车道车辆没有车位编号
+    int total = view.lotCount + view.laneCount;
+    int used[3] = { 0, 0, 0 };
+    SpaceBitmap newMaps[3];
+    for (int i = 0; i < 3; i++) {
+        newMaps[i].reset(view.spaces[i]);
+    }
+    PlateRegistry newPlates;
+    newPlates.reserve(total);
+    for (int i = 0; i < total; i++) {
+        const Car& car = i < view.lotCount ? view.lot[i] : view.lane[i - view.lotCount];
+        if (!car.isValidRecord() || car.getVehicleId() != static_cast<uint32_t>(i)) {
+            return false;
+        }
+        if (newPlates.intern(car.plate()) != static_cast<uint32_t>(i)) {
+            return false;
+        }
+        if (i < view.lotCount) {
+            if (!newMaps[car.getSpaceType()].acquire(car.getSpaceId())) {
+                return false;
+            }
+            used[car.getSpaceType()]++;
+        } else if (car.getSpaceId() != -1) {
+            return false;
+        }
+    }
+    
+    // 停车场整块复制，候车道按到达次序入队
+    Stack newLot(view.maxCapacity);
+    newLot.assign(view.lot, view.lotCount);
+    WaitingLane newLane;
+    CarIndex newIndex;
+    newIndex.reserve(total);
+    for (int i = 0; i < view.lotCount; i++) {
+        newIndex.setLot(i, i);
+    }
+    for (int i = 0; i < view.laneCount; i++) {
+        const Car& car = view.lane[i];
+        newIndex.setLane(car.getVehicleId(), car.getType(), newLane.enqueue(car));
+    }
+    
+    // 全部校验通过后才替换当前状态（进行中的分段冻结先保存被替换的停车场）
+    {
+        lock_guard<mutex> lotGuard(locks.lot);
+        preserveFrozenLot(0);
+    }
+    parkingLot = std::move(newLot);
+    waitingLane = std::move(newLane);
+    plates = std::move(newPlates);
+    carIndex = std::move(newIndex);
+    
+    maxCapacity = view.maxCapacity;
+    hourlyRate = view.hourlyRate;
+    smallSpaces = view.spaces[0];
+    mediumSpaces = view.spaces[1];
+    largeSpaces = view.spaces[2];
+    for (int i = 0; i < 3; i++) {
+        spaceMaps[i] = newMaps[i];
+        usedSpaces[i].store(used[i]);
+    }
+    storeWaitingCount(view.laneCount);
+    Car pending;
+    while (inbox.tryDequeue(pending)) {
+        // 入口队列中的车辆属于被替换的状态，一并丢弃
+    }
+    appliedLsn = view.journalLsn;
+    if (journal != nullptr) {
+        journal->advancePast(appliedLsn);
+    }
+    
+    verifyIndex();
+    return true;
+}
+
+// 设置事件接收器
+void ParkingSystem::setEventSink(ParkingEventSink* eventSink) {
+    sink = eventSink != nullptr ? eventSink : &nullEventSink();
+}
+
+// 获取事件接收器
+ParkingEventSink* ParkingSystem::getEventSink() const {
+    return sink;
+}
+
+// 挂接操作日志
+void ParkingSystem::setJournal(ParkingJournal* operationJournal) {
+    journal = operationJournal;
+    if (journal != nullptr) {
+        journal->advancePast(appliedLsn);
+    }
+}
+
+// 获取操作日志
+ParkingJournal* ParkingSystem::getJournal() const {
+    return journal;
+}
+
+// 挂接运行指标（候车道中已有的车辆从旧的指标对象移到新的指标对象）
+void ParkingSystem::setMetrics(ParkingMetrics* operationMetrics) {
+    int waiting = waitingCount.load();
+    if (metrics != nullptr) {
+        metrics->addLaneDepth(-waiting);
+    }
+    metrics = operationMetrics;
+    if (metrics != nullptr) {
+        metrics->addLaneDepth(waiting);
+    }
+}
+
+// 获取运行指标
+ParkingMetrics* ParkingSystem::getMetrics() const {
+    return metrics;
+}
+
+// 挂接操作阶段跟踪
+void ParkingSystem::setTracer(ParkingTracer* phaseTracer) {
+    tracer = phaseTracer;
+}
+
+// 获取操作阶段跟踪
+ParkingTracer* ParkingSystem::getTracer() const {
+    return tracer;
+}
+
+// 设置时钟（nullptr表示恢复为共享的墙上时钟）
+void ParkingSystem::setClock(Clock* timeSource) {
+    clock = timeSource != nullptr ? timeSource : &wallClock();
+}
+
+// 获取时钟
+Clock& ParkingSystem::getClock() const {
+    return *clock;
+}
+
+// 重放日志记录
+int ParkingSystem::replayJournal(const vector<JournalRecord>& records) {
+    // 重放的操作已经在日志中，不再重复记录，也不输出事件
+    int replayed = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        const JournalRecord& record = records[i];
+        if (record.lsn <= appliedLsn) {
+            continue;   // 已包含在快照中
+        }
+        
+        // 日志序号必须紧接当前状态，否则中间缺少的操作无法补回
+        if (record.lsn != appliedLsn + 1 || !applyRecord(record)) {
+            replayed = -1;
+            break;
+        }
+        appliedLsn = record.lsn;
+        replayed++;
+    }
+    
+    if (journal != nullptr) {
+        journal->advancePast(appliedLsn);
+    }
+    verifyIndex();
+    return replayed;
+}
+
+// 应用一条日志记录
+// 记录中保存了操作的结果，直接按结果修改停车场和候车道，不重新分配车位；
+// 任何一步与当前状态不符时返回false，并且不修改状态
+bool ParkingSystem::applyRecord(const JournalRecord& record) {
+    PlateView plate = plateOf(record);
+    uint32_t vehicleId;
+    CarLocation location = locate(plate, vehicleId);
+    bool toLot = record.spaceType != JOURNAL_NO_SPACE;
+    
+    if (record.op == JOURNAL_ARRIVAL) {
+        if (location.kind != LOCATION_NONE) {
+            return false;
+        }
+        if (toLot && (parkingLot.isFull() || !takeSpaceAt(record.spaceType, record.spaceId))) {
+            return false;
+        }
+        
+        Car car(plate.str(), static_cast<CarType>(record.carType), static_cast<time_t>(record.time));
+        car.setVehicleId(plates.intern(plate));
+        if (toLot) {
+            car.setSpaceType(static_cast<ParkingSpaceType>(record.spaceType));
+            car.setSpaceId(record.spaceId);
+            parkInLot(car);
+        } else {
+            enqueueWaiting(car);
+        }
+        return true;
+    }
+    
+    if (record.op == JOURNAL_ADMIT) {
+        if (location.kind != LOCATION_LANE || parkingLot.isFull() ||
+            !takeSpaceAt(record.spaceType, record.spaceId)) {
+            return false;
+        }
+        
+        // 放行的总是子队列队头车辆，这里按位置索引摘下，不依赖队头次序
+        Car car = waitingLane.getLane(location.lane).getNode(location.node).car;
+        car.setSpaceType(static_cast<ParkingSpaceType>(record.spaceType));
+        car.setSpaceId(record.spaceId);
+        parkInLot(car);
+        waitingLane.remove(location.lane, location.node);
+        storeWaitingCount(waitingLane.size());
+        return true;
+    }
+    
+    // 离开：停车场中的车辆同时释放车位
+    if (location.kind == LOCATION_LOT) {
+        const Car& car = parkingLot.at(location.slot);
+        int spaceType = car.getSpaceType();
+        int spaceId = car.getSpaceId();
+        removeFromLot(vehicleId, location.slot);
+        releaseParkingSpace(spaceType, spaceId);
+    } else if (location.kind == LOCATION_LANE) {
+        removeFromLane(vehicleId, location);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// 检查点
+bool ParkingSystem::checkpoint(const string& snapshotFile) {
+    // 写入期间持有停车场和候车道的锁，快照与清空日志之间没有其他变更
+    lock_guard<mutex> lotGuard(locks.lot);
+    lock_guard<mutex> laneGuard(locks.lane);
+    ParkingSnapshot snapshot;
+    copyState(snapshot);
+    renumberVehicles(snapshot);
+    if (!writeSnapshot(snapshotFile, snapshot)) {
+        return false;
+    }
+    appliedLsn = snapshot.journalLsn;
+    
+    // 快照已经落盘，其中包含了日志中的全部记录
+    return journal == nullptr || journal->truncate();
+}
+
+// 把成功的操作追加到日志
+void ParkingSystem::logOperation(JournalOp op, const PlateView& plate, int carType, int spaceType, int spaceId, time_t time) {
+    if (journal != nullptr) {
+        TraceScope span(tracer, "journal");
+        journal->append(op, plate, carType, spaceType, spaceId, time);
+    }
+}
+
+// 按车牌查找车辆ID和位置
+CarLocation ParkingSystem::locate(const PlateView& plate, uint32_t& vehicleId) const {
+    lock_guard<mutex> guard(locks.registry);
+    vehicleId = plates.find(plate);
+    return carIndex.get(vehicleId);
+}
+
+// 注销车辆ID
+void ParkingSystem::releaseVehicleId(uint32_t vehicleId) {
+    lock_guard<mutex> guard(locks.registry);
+    plates.release(vehicleId);
+}
+
+// 获取最近一次车辆离开的让路步骤
+const vector<MakeWayMove>& ParkingSystem::getLastMakeWayMoves() const {
+    return localScratch().moves;
+}
+
+// 车辆停入停车场并更新位置索引
+bool ParkingSystem::parkInLot(const Car& car) {
+    if (!parkingLot.push(car)) {
+        return false;
+    }
+    lock_guard<mutex> guard(locks.registry);
+    carIndex.setLot(car.getVehicleId(), parkingLot.size() - 1);
     return true;
 }
 
-// ʱתΪַ
-string ParkingSystem::timeToString(time_t time) const {
-    char buffer[20];
-    struct tm* timeinfo = localtime(&time);
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
-    return string(buffer);
+// 车辆进入候车道并更新位置索引
+void ParkingSystem::enqueueWaiting(const Car& car) {
+    int node = waitingLane.enqueue(car);
+    storeWaitingCount(waitingLane.size());
+    lock_guard<mutex> guard(locks.registry);
+    carIndex.setLane(car.getVehicleId(), car.getType(), node);
+}
+
+// 从停车场原地移除车辆
+void ParkingSystem::removeFromLot(uint32_t vehicleId, int slot) {
+    // 车辆记录可平凡复制，相当于一次memmove，不再经过临时栈逐辆复制
+    // 槽位从栈底计数，换算为从栈顶计数的位置；进行中的分段冻结先保存将被挪动的车辆
+    preserveFrozenLot(slot);
+    parkingLot.removeCarAt(parkingLot.size() - slot);
+    
+    // 让路车辆各向栈底挪动一个槽位
+    lock_guard<mutex> guard(locks.registry);
+    carIndex.erase(vehicleId);
+    for (int moved = slot; moved < parkingLot.size(); moved++) {
+        carIndex.setLot(parkingLot.at(moved).getVehicleId(), moved);
+    }
+    plates.release(vehicleId);
+}
+
+// 从候车道移除车辆
+void ParkingSystem::removeFromLane(uint32_t vehicleId, const CarLocation& location) {
+    waitingLane.remove(location.lane, location.node);
+    storeWaitingCount(waitingLane.size());
+    lock_guard<mutex> guard(locks.registry);
+    carIndex.erase(vehicleId);
+    plates.release(vehicleId);
+}
+
+// 调试模式下校验位置索引
+void ParkingSystem::verifyIndex() const {
+#ifdef PARKING_DEBUG_INDEX
+    if (!checkIndexConsistency()) {
+        cerr << "位置索引与停车场/候车道不一致！" << endl;
+        abort();
+    }
+#endif
+}
+
+// 检查位置索引与停车场、候车道是否一致
+bool ParkingSystem::checkIndexConsistency() const {
+    lock_guard<mutex> lotGuard(locks.lot);
+    lock_guard<mutex> laneGuard(locks.lane);
+    lock_guard<mutex> registryGuard(locks.registry);
+    
+    // 停车场中每辆车的槽位都应与索引一致，车位在占用位图中已标记
+    int lotSize = parkingLot.size();
+    int used[3] = { 0, 0, 0 };
+    for (int slot = 0; slot < lotSize; slot++) {
+        Car car = parkingLot.getCarAt(lotSize - slot);
+        CarLocation location = carIndex.get(car.getVehicleId());
+        if (location.kind != LOCATION_LOT || location.slot != slot) {
+            return false;
+        }
+        if (!plates.isLive(car.getVehicleId())) {
+            return false;
+        }
+        if (!spaceMaps[car.getSpaceType()].isOccupied(car.getSpaceId())) {
+            return false;
+        }
+        used[car.getSpaceType()]++;
+    }
+    
+    // 位图中已占用的车位数应与车辆数和计数都相同（车辆的车位互不重复）
+    for (int i = 0; i < 3; i++) {
+        if (spaceMaps[i].countOccupied() != used[i] || usedSpaces[i].load() != used[i]) {
+            return false;
+        }
+    }
+    
+    // 候车道中每辆车的子队列和节点都应与索引一致，且到达序号严格递增
+    int laneSize = 0;
+    uint64_t lastSeq = 0;
+    for (WaitingLane::const_iterator it = waitingLane.begin(); it != waitingLane.end(); ++it) {
+        uint32_t vehicleId = it->getVehicleId();
+        CarLocation location = carIndex.get(vehicleId);
+        if (location.kind != LOCATION_LANE || location.lane != it.laneIndex() || location.node != it.index()) {
+            return false;
+        }
+        if (it.laneIndex() != it->getType() || !plates.isLive(vehicleId)) {
+            return false;
+        }
+        uint64_t seq = waitingLane.sequenceOf(it.laneIndex(), it.index());
+        if (laneSize > 0 && seq <= lastSeq) {
+            return false;
+        }
+        lastSeq = seq;
+        laneSize++;
+    }
+    
+    // 登记表中不应有多余的车辆（入口队列中的车辆已登记，尚未并入候车道）
+    return laneSize == waitingLane.size() && plates.size() == lotSize + laneSize + inbox.size();
 }
 
-// ȡͣгϢͼν棩
+// 获取停车场中所有车辆的信息（用于图形界面）
 vector<string> ParkingSystem::getParkingLotInfo() const {
+    lock_guard<mutex> guard(locks.lot);
     vector<string> info;
-    // ע⣺Stackûṩ򻯴
-    // ʵӦУҪΪStackӱ
-    info.push_back("ͣ " + to_string(parkingLot.size()) + " ");
+    
+    // 从大门一侧（栈顶）开始读取，最多显示10辆车
+    int count = 0;
+    for (Stack::const_reverse_iterator it = parkingLot.rbegin(); it != parkingLot.rend() && count < 10; ++it) {
+        // 创建车辆信息字符串：车牌号 + 车型 + 车位类型
+        string carInfo = "车牌: " + it->getLicensePlate() +
+                        " | 车型: " + it->getTypeString() +
+                        " | 车位: " + it->getSpaceTypeString() + " " + to_string(it->getSpaceId()) + "号";
+        info.push_back(carInfo);
+        count++;
+    }
+    
+    if (parkingLot.size() > 10) {
+        info.push_back("... 还有 " + to_string(parkingLot.size() - 10) + " 辆车");
+    }
+    
     return info;
 }
 
-// ȡ򳵵гϢͼν棩
+// 查询在场车辆的累计应收费用
+// 开始时读取一次时钟，所有车辆按同一时刻计算
+double ParkingSystem::getAccruedFees(long* totalDuration) const {
+    time_t now = clock->now();
+    lock_guard<mutex> guard(locks.lot);
+    double total = 0;
+    long duration = 0;
+    for (Stack::const_iterator it = parkingLot.begin(); it != parkingLot.end(); ++it) {
+        total += it->calculateFee(hourlyRate, now);
+        duration += it->getParkingDuration(now);
+    }
+    if (totalDuration != nullptr) {
+        *totalDuration = duration;
+    }
+    return total;
+}
+
+// 查询一辆车到现在为止的应收费用
+bool ParkingSystem::getAccruedFee(const string& licensePlate, double& fee, long& duration) const {
+    PlateView plate(licensePlate);
+    time_t now = clock->now();
+    lock_guard<mutex> guard(locks.lot);
+    uint32_t vehicleId;
+    CarLocation location = locate(plate, vehicleId);
+    if (location.kind != LOCATION_LOT) {
+        return false;
+    }
+    const Car& car = parkingLot.at(location.slot);
+    fee = car.calculateFee(hourlyRate, now);
+    duration = car.getParkingDuration(now);
+    return true;
+}
+
+// 获取候车道中所有车辆的信息（用于图形界面）
 vector<string> ParkingSystem::getWaitingLaneInfo() const {
+    lock_guard<mutex> guard(locks.lane);
     vector<string> info;
     
-    // ȡ򳵵еĳϢ
-    // ע⣺Queueûṩʹһʱ
-    Queue tempQueue = waitingLane;
+    // 按到达次序直接读取候车道中的车辆信息
     int count = 0;
-    
-    while (!tempQueue.isEmpty() && count < 10) { // ʾ10
-        Car car = tempQueue.getFront();
-        tempQueue.dequeue();
-        
-        // Ϣַƺ + 
-        string carInfo = ": " + car.getLicensePlate() + 
-                        " | : " + car.getTypeString();
+    for (WaitingLane::const_iterator it = waitingLane.begin(); it != waitingLane.end() && count < 10; ++it) { // 最多显示10辆车
+        // 创建车辆信息字符串：车牌号 + 车型
+        string carInfo = "车牌: " + it->getLicensePlate() + 
+                        " | 车型: " + it->getTypeString();
         info.push_back(carInfo);
         count++;
     }
     
     if (waitingLane.size() > 10) {
-        info.push_back("...  " + to_string(waitingLane.size() - 10) + " ");
+        info.push_back("... 还有 " + to_string(waitingLane.size() - 10) + " 辆车");
     }
     
     return info;
 }
 
-// ȡλϢ
+// 获取停车场（只读）
+const Stack& ParkingSystem::getParkingLot() const {
+    return parkingLot;
+}
+
+// 获取候车道（只读）
+const WaitingLane& ParkingSystem::getWaitingLane() const {
+    return waitingLane;
+}
+
+// 获取车位配置信息
 void ParkingSystem::getSpaceInfo(int& small, int& medium, int& large, 
                                 int& usedSmall, int& usedMedium, int& usedLarge) const {
     small = smallSpaces;
     medium = mediumSpaces;
     large = largeSpaces;
-    usedSmall = usedSmallSpaces;
-    usedMedium = usedMediumSpaces;
-    usedLarge = usedLargeSpaces;
+    usedSmall = usedSpaces[SPACE_SMALL].load();
+    usedMedium = usedSpaces[SPACE_MEDIUM].load();
+    usedLarge = usedSpaces[SPACE_LARGE].load();
+}
+
+// 判断指定车位是否已被占用
+bool ParkingSystem::isSpaceOccupied(int spaceType, int spaceId) const {
+    if (spaceType < SPACE_SMALL || spaceType > SPACE_LARGE) {
+        return false;
+    }
+    return spaceMaps[spaceType].isOccupied(spaceId);
 }
@@ -2,104 +2,395 @@
 #define PARKINGSYSTEM_H
 
 #include "Stack.h"
-#include "Queue.h"
+#include "WaitingLane.h"
+#include "PlateRegistry.h"
+#include "CarIndex.h"
+#include "ParkingEvents.h"
+#include "ParkingSnapshot.h"
+#include "ParkingJournal.h"
+#include "ParkingMetrics.h"
+#include "ParkingTracer.h"
+#include "ParkingClock.h"
+#include "LockFreeQueue.h"
+#include "SpaceBitmap.h"
+#include "AllocationPolicy.h"
 #include <string>
 #include <vector>
+#include <atomic>
+#include <mutex>
 
+// 原子计数（车位占用数、候车车辆数），多个大门线程不加锁即可读取和分配
+// 全部使用顺序一致的原子操作：释放车位后检查候车车辆、车辆入队后检查车位，两边至少有一边会看到对方。
+// 复制时复制当前值，ParkingSystem仍可整体复制和赋值
+class AtomicCounter {
+private:
+    std::atomic<int> value;
+    
+public:
+    AtomicCounter(int initial = 0) : value(initial) {}
+    AtomicCounter(const AtomicCounter& other) : value(other.load()) {}
+    AtomicCounter& operator=(const AtomicCounter& other) {
+        value.store(other.load());
+        return *this;
+    }
+    
+    int load() const {
+        return value.load();
+    }
+    
+    void store(int count) {
+        value.store(count);
+    }
+    
+    // 计数小于limit时加一并返回true，否则返回false
+    bool tryAcquire(int limit) {
+        int current = value.load();
+        while (current < limit) {
+            if (value.compare_exchange_weak(current, current + 1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // 计数加上delta（可为负数，不检查上下限）
+    void add(int delta) {
+        value.fetch_add(delta);
+    }
+    
+    // 计数大于0时减一
+    void release() {
+        int current = value.load();
+        while (current > 0) {
+            if (value.compare_exchange_weak(current, current - 1)) {
+                return;
+            }
+        }
+    }
+};
+
+// ParkingSystem的锁（复制系统时不复制锁，副本有自己的一组锁）
+// 需要同时持有多个锁时按 停车场 -> 候车道 -> 登记表 的次序加锁，日志的锁在最内层
+struct ParkingLocks {
+    std::mutex lot;             // 保护停车场
+    std::mutex lane;            // 保护候车道
+    std::mutex registry;        // 保护车牌登记表和位置索引
+    
+    ParkingLocks() {}
+    ParkingLocks(const ParkingLocks&) {}
+    ParkingLocks& operator=(const ParkingLocks&) { return *this; }
+};
+
+// 后台检查点分段冻结停车场的进度（在停车场的锁内读写；复制系统时不复制，副本没有进行中的冻结）
+// 冻结时刻停车场[0, total)的车辆要写入target->lot：[0, copied)已分段复制，
+// [limit, total)在被让路挪动之前已写入（写时复制），[copied, limit)自冻结以来未被改动。
+struct FrozenLotCopy {
+    ParkingSnapshot* target;    // 冻结的快照（nullptr表示没有进行中的冻结）
+    int copied;                 // 已分段复制的车辆数（从栈底起）
+    int limit;                  // 写时复制已保存部分的起点
+    
+    FrozenLotCopy() : target(nullptr), copied(0), limit(0) {}
+    FrozenLotCopy(const FrozenLotCopy&) : target(nullptr), copied(0), limit(0) {}
+    FrozenLotCopy& operator=(const FrozenLotCopy&) { return *this; }
+};
+
+// 停车场管理系统
+// 车辆到达/离开可以由多个大门线程同时调用：车位用原子计数分配，停车场、候车道、登记表各有一把锁，
+// 只在修改对应结构时持有；让路步骤等临时数据放在调用线程自己的暂存区中。
+// 没有车位的车辆放入候车道入口队列（无锁队列），不等候车道的锁；持有候车道锁的操作
+// （放行、候车道车辆离开）先把入口队列按入队次序并入候车道，再记入日志。
+// 并发时候车道的查询（显示、长度以外的信息、保存文本文件、快照）只包含已并入的车辆。
+// 事件在释放全部锁之后发出，并发使用时事件接收器需要自行保证线程安全（NullEventSink可以共享）。
+// 设置车位、加载文件/快照、重放日志等整体替换状态的操作只能在没有大门线程运行时调用。
+// 车位分配策略在构造时选定（见AllocationPolicy.h），到达、放行和离开时的车位交接都按同一策略决定车位。
 class ParkingSystem {
 private:
-    Stack parkingLot;           // ͣջ
-    Queue waitingLane;          // 򳵵У
-    Stack tempStack;            // ʱջڳ뿪ʱʱţ
+    Stack parkingLot;           // 停车场（栈）
+    WaitingLane waitingLane;    // 候车道（按车型分子队列）
+    LockFreeQueue inbox;        // 候车道入口队列（大门线程无锁入队，持有候车道锁时并入候车道；容量随停车场容量，16到1024）
+    PlateRegistry plates;       // 车牌登记表（车牌 -> 车辆ID）
+    CarIndex carIndex;          // 位置索引（车辆ID -> 停车场槽位/候车道节点）
+    ParkingEventSink* sink;     // 事件接收器（不拥有，默认输出到控制台）
+    ParkingJournal* journal;    // 操作日志（不拥有，nullptr表示不记录）
+    ParkingMetrics* metrics;    // 运行指标（不拥有，nullptr表示不记录）
+    ParkingTracer* tracer;      // 操作阶段跟踪（不拥有，nullptr表示不记录）
+    Clock* clock;               // 时钟（不拥有，默认为共享的墙上时钟；在场车辆的时长和费用按它计算）
+    uint32_t appliedLsn;        // 当前状态包含的最后一条日志记录的序号（从快照或重放得到）
+    mutable ParkingLocks locks; // 停车场、候车道、登记表的锁
+    FrozenLotCopy frozenLot;    // 进行中的分段冻结（由停车场的锁保护）
     
-    int maxCapacity;            // ͣ
-    double hourlyRate;          // ÿСʱ
+    int maxCapacity;            // 停车场最大容量
+    double hourlyRate;          // 每小时费率
     
-    // λ
-    int smallSpaces;           // Сͳλ
-    int mediumSpaces;          // ͳλ
-    int largeSpaces;           // ͳλ
+    // 车位配置
+    int smallSpaces;           // 小型车位数量
+    int mediumSpaces;          // 中型车位数量
+    int largeSpaces;           // 大型车位数量
     
-    int usedSmallSpaces;       // ʹõСͳλ
-    int usedMediumSpaces;      // ʹõͳλ
-    int usedLargeSpaces;       // ʹõĴͳλ
+    AllocationPolicyKind allocationPolicy;  // 车位分配策略
+    int spaceReserve[3];        // 小/中/大型车位的保留量（保留感知策略使用）
+    
+    AtomicCounter usedSpaces[3];    // 已使用的小/中/大型车位（分配时先占计数，车位已满时不必扫描位图）
+    SpaceBitmap spaceMaps[3];       // 小/中/大型车位的占用位图（占到计数后在位图中取编号最小的空位）
+    AtomicCounter waitingCount;     // 候车道车辆数（在候车道的锁内更新，离开时不加锁判断是否需要放行）
     
 public:
-    // 캯
-    ParkingSystem(int capacity = 10, double rate = 5.0);
+    // 构造函数（车位按容量平均分配；容量超过3*MAX_SPACES_PER_TYPE时按该上限计）
+    ParkingSystem(int capacity = 10, double rate = 5.0, AllocationPolicyKind policy = ALLOCATE_STRICT);
+    
+    // 设置车位配置（不能与大门线程同时调用）
+    // 每种车位最多MAX_SPACES_PER_TYPE个；数量为负或超出上限时返回false，原配置保持不变
+    bool setParkingSpaces(int small, int medium, int large);
     
-    // óλ
-    void setParkingSpaces(int small, int medium, int large);
+    // 设置各类型车位的保留量（只有保留感知策略使用，默认为0；不能与大门线程同时调用）
+    void setSpaceReserve(int small, int medium, int large);
     
-    // 
-    // أ0-ɹͣͣ1-ͣ򳵵-1-ʧ
-    int carArrival(const std::string& licensePlate, int carType, time_t arrivalTime);
+    // 获取车位分配策略
+    AllocationPolicyKind getAllocationPolicy() const;
     
-    // 뿪
-    // أtrue-ɹ뿪false-ʧܣڣ
-    bool carDeparture(const std::string& licensePlate, time_t departureTime);
+    // 车辆到达
+    // 返回到达结果：停入停车场、进入候车道或失败原因，以及分配的车位类型
+    ArrivalResult carArrival(const std::string& licensePlate, int carType, time_t arrivalTime);
     
-    // ѯͣ״̬
+    // 车辆离开
+    // 返回离开结果：离开位置、费用、停车时长和让路步骤
+    DepartureResult carDeparture(const std::string& licensePlate, time_t departureTime);
+    
+    // 设置事件接收器（不转移所有权；传入nullptr表示丢弃所有事件）
+    void setEventSink(ParkingEventSink* eventSink);
+    
+    // 获取事件接收器
+    ParkingEventSink* getEventSink() const;
+    
+    // 挂接操作日志（不转移所有权；传入nullptr表示不再记录）
+    // 之后每次成功的到达/离开/放行都会在修改停车场或候车道的同时追加到日志
+    void setJournal(ParkingJournal* operationJournal);
+    
+    // 获取操作日志
+    ParkingJournal* getJournal() const;
+    
+    // 挂接运行指标（不转移所有权；传入nullptr表示不再记录；不能与大门线程同时调用）
+    // 之后每次到达/离开记录耗时和结果，离开时记录让路车辆数，随之放行的候车车辆记录候车时间
+    void setMetrics(ParkingMetrics* operationMetrics);
+    
+    // 获取运行指标
+    ParkingMetrics* getMetrics() const;
+    
+    // 挂接操作阶段跟踪（不转移所有权；传入nullptr表示不再记录；不能与大门线程同时调用）
+    // 之后到达、离开和放行的各阶段（查找、等锁、让路、放行候车车辆、写日志等）记录起止时间
+    void setTracer(ParkingTracer* phaseTracer);
+    
+    // 获取操作阶段跟踪
+    ParkingTracer* getTracer() const;
+    
+    // 设置时钟（不转移所有权；传入nullptr表示恢复为共享的墙上时钟；不能与大门线程同时调用）
+    // 在场车辆的停车时长和应收费用按这个时钟计算；模拟和重放使用模拟时钟，结果与运行时的系统时间无关
+    void setClock(Clock* timeSource);
+    
+    // 获取时钟（界面没有输入时间时也用它取得当前时间）
+    Clock& getClock() const;
+    
+    // 重放日志记录（启动恢复时在加载快照之后调用）
+    // 只重放序号大于当前状态的记录，按记录的结果直接还原，不输出事件、不写日志。
+    // 返回重放的记录数；记录与当前状态衔接不上（序号有缺口或操作失败）时返回-1，已重放的部分保留
+    int replayJournal(const std::vector<JournalRecord>& records);
+    
+    // 检查点：把当前状态保存为快照并清空日志
+    // 快照同步到磁盘后才清空日志，中途掉电时恢复仍能得到完整的状态；
+    // 写入期间持有停车场和候车道的锁，大门线程暂停
+    bool checkpoint(const std::string& snapshotFile);
+    
+    // 查询停车场状态
     void displayParkingStatus() const;
     
-    // ѯ򳵵״̬
+    // 查询候车道状态
     void displayWaitingLaneStatus() const;
     
-    // ѯ״̬
+    // 查询所有状态
     void displayAllStatus() const;
     
-    // ҳ
-    // أ0-δҵ1-ͣ2-ں򳵵
+    // 查找车辆
+    // 返回：0-未找到，1-在停车场，2-在候车道
     int findCar(const std::string& licensePlate) const;
     
-    // ȡͣóλ
+    // 获取停车场可用车位数量
     int getAvailableSpaces() const;
     
-    // ȡͣ
+    // 获取指定车型按分配策略还能停入的车位数量（不计停车场容量的限制）
+    int getFreeSpacesFor(int carType) const;
+    
+    // 获取停车场总容量
     int getTotalCapacity() const;
     
-    // ȡ򳵵
+    // 获取候车道长度
     int getWaitingLaneLength() const;
     
-    // Ƿпλ
+    // 检查是否有空位
     bool hasAvailableSpace() const;
     
-    // ͣǷ
+    // 检查停车场是否已满
     bool isParkingLotFull() const;
     
-    // Ӻ򳵵ƶͣͣпλʱ
-    bool moveFromWaitingLaneToParkingLot();
+    // 从候车道移动车辆到停车场（当停车场有空位时）
+    // 按到达次序放行所有能找到合适车位的候车车辆，返回进入停车场的车辆数
+    int moveFromWaitingLaneToParkingLot();
     
-    // ݵļ
+    // 保存数据到文本文件（调试用导出格式，每行一辆车）
     bool saveToFile(const std::string& filename) const;
     
-    // ļ
+    // 从文本文件加载数据（车辆记录损坏或不完整时返回false，当前状态保持不变；
+    // 只有车辆数量、没有车辆记录的旧版本文件只恢复配置）
     bool loadFromFile(const std::string& filename);
     
-    // ȡͣгϢͼν棩
-    // һͣгϢַ
+    // 保存二进制快照（停车场次序、候车道次序、车位类型和进入时间）
+    bool saveSnapshot(const std::string& filename) const;
+    
+    // 加载二进制快照（映射文件后整块构造停车场和候车道）
+    // 文件损坏或与当前平台的记录布局不符时返回false，当前状态保持不变
+    bool loadSnapshot(const std::string& filename);
+    
+    // 取得当前状态的完整快照（车辆ID按存放次序重新编号）
+    void captureSnapshot(ParkingSnapshot& snapshot) const;
+    
+    // 冻结当前状态：只复制车辆记录和配置，不重新编号（写入前需调用renumberVehicles）
+    // 用于后台检查点，调用线程上只做内存复制；snapshot的缓冲区可以在多次冻结之间复用。
+    // rotateJournal为true时在冻结的同时切换日志段（两者之间没有其他变更），切换失败返回false
+    bool freezeSnapshot(ParkingSnapshot& snapshot, bool rotateJournal = false) const;
+    
+    // 开始分段冻结：在锁内只复制配置和候车道、记下停车场的车辆数（并按rotateJournal切换日志段），
+    // 停车场车辆之后由copyFrozenLot每次持锁复制一段；期间离开的车辆让路之前，先把会被挪动的冻结车辆写入snapshot，
+    // 复制完成后snapshot与freezeSnapshot得到的相同。同一时间只能有一个分段冻结，已有冻结或切换日志段失败时返回false。
+    // snapshot在复制完成之前必须保持有效，系统在复制完成之前不能销毁
+    bool beginFreeze(ParkingSnapshot& snapshot, bool rotateJournal = false);
+    
+    // 复制最多maxCars辆冻结的停车场车辆（只在复制期间持有停车场的锁），全部复制完成（或没有进行中的冻结）时返回true
+    bool copyFrozenLot(int maxCars);
+    
+    // 查询停车场中所有车辆到现在为止的应收费用之和（totalDuration不为nullptr时写入停车时长之和，秒）
+    // 只读取一次时钟，车辆多时不会逐辆读取系统时间
+    double getAccruedFees(long* totalDuration = nullptr) const;
+    
+    // 查询停车场中一辆车到现在为止的应收费用和停车时长，车辆不在停车场中时返回false
+    bool getAccruedFee(const std::string& licensePlate, double& fee, long& duration) const;
+    
+    // 获取停车场中所有车辆的信息（用于图形界面）
+    // 返回一个向量，包含停车场中所有车辆的信息字符串
     std::vector<std::string> getParkingLotInfo() const;
     
-    // ȡ򳵵гϢͼν棩
+    // 获取候车道中所有车辆的信息（用于图形界面）
     std::vector<std::string> getWaitingLaneInfo() const;
     
-    // ȡλϢ
+    // 获取停车场和候车道的只读视图（可用迭代器遍历，不复制；不加锁，不能与大门线程同时使用）
+    const Stack& getParkingLot() const;
+    const WaitingLane& getWaitingLane() const;
+    
+    // 获取车位配置信息
     void getSpaceInfo(int& small, int& medium, int& large, 
                      int& usedSmall, int& usedMedium, int& usedLarge) const;
     
+    // 判断指定车位是否已被占用（读取占用位图，不加锁）
+    bool isSpaceOccupied(int spaceType, int spaceId) const;
+    
+    // 获取调用线程最近一次车辆离开的让路步骤（按开出大门的次序，回到停车场的次序与之相反）
+    // 让路步骤保存在线程自己的暂存区中，到该线程下一次离开操作之前有效
+    const std::vector<MakeWayMove>& getLastMakeWayMoves() const;
+    
+    // 检查位置索引与停车场、候车道是否一致（调试用，需遍历全部车辆）
+    bool checkIndexConsistency() const;
+    
 private:
-    // Ƿкʵĳλ
+    // 车辆到达和离开的实际处理（carArrival/carDeparture在挂接了运行指标或阶段跟踪时在外面计时）
+    ArrivalResult arrive(const std::string& licensePlate, int carType, time_t arrivalTime);
+    DepartureResult depart(const std::string& licensePlate, time_t departureTime);
+    
+    // 记录本次操作放行的候车车辆的候车时间（按操作时间计）
+    void recordAdmissions(time_t operationTime);
+    
+    // 更新候车车辆数，挂接了运行指标时同步调整候车道长度（调用方持有候车道的锁）
+    void storeWaitingCount(int count);
+    
+    // 检查是否有合适的车位可用
     bool hasSuitableSpace(int carType) const;
     
-    // 䳵λ
-    // طĳλͣ޷䷵-1
-    int allocateParkingSpace(int carType);
+    // 按分配策略为carType型车辆选择车位类型（只读取计数，不占用），没有可停的车位时返回-1
+    // heldType为调用方已占用、准备交给这辆车的车位类型（离开时交接车位），没有时为-1
+    int chooseSpace(int carType, int heldType = -1) const;
+    
+    // 按策略选择、分配车位和统计空位的模板实例（在ParkingSystem.cpp中按选定的策略调用）
+    template <class Policy> int chooseSpaceWith(const Policy& policy, int carType, int heldType) const;
+    template <class Policy> int allocateWith(const Policy& policy, int carType, int& spaceId);
+    template <class Policy> int countFreeWith(const Policy& policy, int carType) const;
+    
+    // 占用一个指定类型的车位（原子操作），返回车位编号，该类型已占用的车位达到limit时返回-1
+    int takeSpace(int spaceType, int limit);
+    
+    // 占用指定编号的车位（重放日志时使用），车位已满或该车位已被占用时返回false
+    bool takeSpaceAt(int spaceType, int spaceId);
+    
+    // 分配车位（原子操作）
+    // 返回分配的车位类型并写入车位编号，如果无法分配返回-1
+    int allocateParkingSpace(int carType, int& spaceId);
+    
+    // 释放车位
+    void releaseParkingSpace(int spaceType, int spaceId);
+    
+    // 按车位数量重建空的占用位图并清零计数
+    void resetSpaces();
     
-    // ͷųλ
-    void releaseParkingSpace(int spaceType);
+    // 车辆停入停车场并更新位置索引（调用方持有停车场的锁）
+    bool parkInLot(const Car& car);
     
-    // ʱתΪַ
-    std::string timeToString(time_t time) const;
+    // 车辆进入候车道并更新位置索引（调用方持有候车道的锁）
+    void enqueueWaiting(const Car& car);
+    
+    // 从停车场原地移除车辆，更新让路车辆的槽位并注销车辆ID（调用方持有停车场的锁；不释放车位）
+    void removeFromLot(uint32_t vehicleId, int slot);
+    
+    // 从候车道移除车辆并注销车辆ID（调用方持有候车道的锁）
+    void removeFromLane(uint32_t vehicleId, const CarLocation& location);
+    
+    // 把候车道lane的队头车辆停入spaceType类型、spaceId号车位（调用方持有停车场和候车道的锁，车位已分配）
+    bool admitFront(int lane, int spaceType, int spaceId, std::vector<Car>& admitted);
+    
+    // 按到达次序放行能找到合适车位的候车车辆（调用方持有停车场和候车道的锁）
+    int admitWaiting(std::vector<Car>& admitted);
+    
+    // 把入口队列中的车辆按入队次序并入候车道并记入日志（调用方持有候车道的锁）
+    void drainInbox();
+    
+    // 判断候车道或入口队列中是否有车辆（不加锁）
+    bool hasWaitingCars() const;
+    
+    // 按车牌查找车辆ID和位置
+    CarLocation locate(const PlateView& plate, uint32_t& vehicleId) const;
+    
+    // 注销车辆ID
+    void releaseVehicleId(uint32_t vehicleId);
+    
+    // 把成功的操作追加到日志（在修改对应结构的临界区内调用）
+    void logOperation(JournalOp op, const PlateView& plate, int carType, int spaceType, int spaceId, time_t time);
+    
+    // 应用一条日志记录
+    bool applyRecord(const JournalRecord& record);
+    
+    // 复制当前状态（调用方持有停车场和候车道的锁）
+    void copyState(ParkingSnapshot& snapshot) const;
+    
+    // 复制配置和候车道，不复制停车场（调用方持有停车场和候车道的锁）
+    void copyConfigAndLane(ParkingSnapshot& snapshot) const;
+    
+    // 停车场slot号及以上的槽位将被挪动之前，把其中尚未保存的冻结车辆写入冻结的快照（调用方持有停车场的锁）
+    void preserveFrozenLot(int slot);
+    
+    // 只恢复配置，保留当前的车辆（加载旧版本的文本文件）
+    bool loadConfigOnly(int capacity, double rate, int small, int medium, int large);
+    
+    // 从快照视图整体恢复状态（校验全部通过后才替换当前状态）
+    bool restoreFrom(const SnapshotView& view);
+    
+    // 定义PARKING_DEBUG_INDEX时，每次变更后校验位置索引（只用于单线程调试，其他大门线程进行中的操作会被误判为不一致）
+    void verifyIndex() const;
+
 };
 
 #endif // PARKINGSYSTEM_H
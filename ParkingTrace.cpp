@@ -0,0 +1,330 @@
+#include "ParkingTrace.h"
+#include <cstring>
+#include <cstddef>
+
+using namespace std;
+
+static const char TRACE_MAGIC[8] = { 'P', 'A', 'R', 'K', 'T', 'R', 'C', 'E' };
+static const uint32_t TRACE_BYTE_ORDER = 0x01020304u;
+
+// 写入二进制轨迹时的缓冲区大小
+static const size_t TRACE_WRITE_BUFFER = 1 << 20;
+
+static_assert(sizeof(TraceEvent) == 28, "轨迹事件应为28字节");
+static_assert(sizeof(TraceHeader) == 32, "轨迹文件头应为32字节");
+
+// 取下一个以空白分隔的字段，没有更多字段时返回false
+static bool nextField(const char*& cursor, const char*& begin, size_t& length) {
+    while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+        cursor++;
+    }
+    if (*cursor == '\0') {
+        return false;
+    }
+    begin = cursor;
+    while (*cursor != '\0' && *cursor != ' ' && *cursor != '\t' && *cursor != '\r') {
+        cursor++;
+    }
+    length = static_cast<size_t>(cursor - begin);
+    return true;
+}
+
+// 把字段解析为32位无符号整数
+static bool parseNumber(const char* begin, size_t length, uint32_t& value) {
+    if (length == 0 || length > 10) {
+        return false;
+    }
+    unsigned long long result = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (begin[i] < '0' || begin[i] > '9') {
+            return false;
+        }
+        result = result * 10 + static_cast<unsigned>(begin[i] - '0');
+    }
+    if (result > 0xFFFFFFFFull) {
+        return false;
+    }
+    value = static_cast<uint32_t>(result);
+    return true;
+}
+
+// 填写轨迹事件的车牌
+bool setTracePlate(TraceEvent& event, const char* plate, size_t length) {
+    if (length == 0 || length > static_cast<size_t>(Car::MAX_PLATE_LENGTH)) {
+        return false;
+    }
+    memset(event.plate, 0, sizeof(event.plate));
+    memcpy(event.plate, plate, length);
+    event.plateLength = static_cast<uint8_t>(length);
+    return true;
+}
+
+// 校验轨迹事件的字段
+bool isValidTraceEvent(const TraceEvent& event) {
+    if (event.op != TRACE_ARRIVAL && event.op != TRACE_DEPARTURE) {
+        return false;
+    }
+    if (event.carType > LARGE || event.reserved != 0) {
+        return false;
+    }
+    if (event.plateLength == 0 || event.plateLength > Car::MAX_PLATE_LENGTH) {
+        return false;
+    }
+    return event.plate[event.plateLength] == '\0';
+}
+
+// 构造函数
+TraceReader::TraceReader()
+    : events(nullptr), eventCount(0), position(0), lineNumber(0), lastTime(0) {
+}
+
+// 打开轨迹文件
+bool TraceReader::open(const string& filename) {
+    in.close();
+    mapped.close();
+    events = nullptr;
+    eventCount = 0;
+    position = 0;
+    lineNumber = 0;
+    lastTime = 0;
+    errorText.clear();
+    
+    // 按文件标识区分二进制轨迹和文本轨迹
+    {
+        ifstream probe(filename.c_str(), ios::binary);
+        if (!probe) {
+            return false;
+        }
+        char magic[sizeof(TRACE_MAGIC)];
+        if (probe.read(magic, sizeof(magic)) && memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0) {
+            return openBinary(filename);
+        }
+    }
+    in.open(filename.c_str());
+    return in.is_open();
+}
+
+// 映射并校验二进制轨迹
+bool TraceReader::openBinary(const string& filename) {
+    if (!mapped.open(filename) || mapped.size() < sizeof(TraceHeader)) {
+        errorText = "二进制轨迹文件不完整";
+        return false;
+    }
+    
+    TraceHeader header;
+    memcpy(&header, mapped.data(), sizeof(header));
+    if (header.version != TRACE_VERSION || header.byteOrder != TRACE_BYTE_ORDER ||
+        header.eventSize != sizeof(TraceEvent)) {
+        errorText = "二进制轨迹的版本或记录布局与当前平台不符";
+        mapped.close();
+        return false;
+    }
+    
+    // 事件数必须与文件长度一致（写入中途失败的文件事件数没有回填）
+    // 由文件长度算出事件数再比较，文件头中伪造的事件数不会因乘法溢出而通过校验
+    size_t payload = mapped.size() - sizeof(TraceHeader);
+    if (payload % sizeof(TraceEvent) != 0 || header.eventCount != payload / sizeof(TraceEvent)) {
+        errorText = "二进制轨迹的事件数与文件长度不符";
+        mapped.close();
+        return false;
+    }
+    events = reinterpret_cast<const TraceEvent*>(static_cast<const char*>(mapped.data()) + sizeof(TraceHeader));
+    eventCount = header.eventCount;
+    return true;
+}
+
+// 判断打开的是否为二进制轨迹
+bool TraceReader::isBinary() const {
+    return mapped.isOpen();
+}
+
+// 获取二进制轨迹的事件数组
+const TraceEvent* TraceReader::data() const {
+    return events;
+}
+
+// 获取二进制轨迹的事件数
+uint64_t TraceReader::size() const {
+    return eventCount;
+}
+
+// 读取下一个事件
+bool TraceReader::next(TraceEvent& event) {
+    if (!errorText.empty()) {
+        return false;
+    }
+    if (mapped.isOpen()) {
+        if (position >= eventCount) {
+            return false;
+        }
+        memcpy(&event, events + position, sizeof(event));
+        position++;
+        lineNumber++;
+        if (!isValidTraceEvent(event)) {
+            fail("事件字段无效");
+            return false;
+        }
+        if (event.time < lastTime) {
+            fail("事件时间早于上一个事件");
+            return false;
+        }
+        lastTime = event.time;
+        return true;
+    }
+    while (getline(in, line)) {
+        lineNumber++;
+        if (parseLine(event)) {
+            if (event.time < lastTime) {
+                fail("事件时间早于上一个事件");
+                return false;
+            }
+            lastTime = event.time;
+            return true;
+        }
+        if (!errorText.empty()) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// 解析一行
+bool TraceReader::parseLine(TraceEvent& event) {
+    const char* cursor = line.c_str();
+    const char* field;
+    size_t length;
+    if (!nextField(cursor, field, length) || field[0] == '#') {
+        return false;
+    }
+    
+    memset(&event, 0, sizeof(event));
+    if (length != 1 || (field[0] != TRACE_ARRIVAL && field[0] != TRACE_DEPARTURE)) {
+        fail("事件类型应为A或D");
+        return false;
+    }
+    event.op = static_cast<uint8_t>(field[0]);
+    
+    if (!nextField(cursor, field, length) || !setTracePlate(event, field, length)) {
+        fail("车牌号缺失或过长");
+        return false;
+    }
+    if (!nextField(cursor, field, length) || !parseNumber(field, length, event.time)) {
+        fail("时间缺失或无效");
+        return false;
+    }
+    
+    uint32_t value;
+    if (event.op == TRACE_ARRIVAL && nextField(cursor, field, length)) {
+        if (!parseNumber(field, length, value) || value > LARGE) {
+            fail("车型无效");
+            return false;
+        }
+        event.carType = static_cast<uint8_t>(value);
+        if (nextField(cursor, field, length)) {
+            if (!parseNumber(field, length, event.dwell)) {
+                fail("停车时长无效");
+                return false;
+            }
+        }
+    }
+    if (nextField(cursor, field, length) && field[0] != '#') {
+        fail("多余的字段");
+        return false;
+    }
+    return true;
+}
+
+// 记录错误
+void TraceReader::fail(const char* reason) {
+    errorText = (mapped.isOpen() ? "第" + to_string(lineNumber) + "个事件："
+                                 : "第" + to_string(lineNumber) + "行：") + reason;
+}
+
+// 获取出错原因
+const string& TraceReader::error() const {
+    return errorText;
+}
+
+// 获取已读取的行数
+unsigned long TraceReader::getLineNumber() const {
+    return lineNumber;
+}
+
+// 构造函数
+TraceWriter::TraceWriter() : file(nullptr), binary(true), seed(0), eventCount(0), failed(false) {
+}
+
+// 析构函数
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+// 创建轨迹文件
+bool TraceWriter::open(const string& filename, bool binaryFormat, uint32_t generatorSeed) {
+    close();
+    file = fopen(filename.c_str(), binaryFormat ? "wb" : "w");
+    if (file == nullptr) {
+        return false;
+    }
+    setvbuf(file, nullptr, _IOFBF, TRACE_WRITE_BUFFER);
+    binary = binaryFormat;
+    seed = generatorSeed;
+    eventCount = 0;
+    failed = false;
+    
+    if (binary) {
+        // 先写入事件数为0的文件头，关闭时回填
+        TraceHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+        header.version = TRACE_VERSION;
+        header.byteOrder = TRACE_BYTE_ORDER;
+        header.eventSize = sizeof(TraceEvent);
+        header.seed = seed;
+        failed = fwrite(&header, sizeof(header), 1, file) != 1;
+    } else if (seed != 0) {
+        failed = fprintf(file, "# seed %u\n", seed) < 0;
+    }
+    return !failed;
+}
+
+// 写入一个事件
+bool TraceWriter::write(const TraceEvent& event) {
+    if (file == nullptr || failed) {
+        return false;
+    }
+    if (binary) {
+        failed = fwrite(&event, sizeof(event), 1, file) != 1;
+    } else if (event.op == TRACE_ARRIVAL) {
+        failed = fprintf(file, "A %s %u %u %u\n", event.plate, event.time,
+                         static_cast<unsigned>(event.carType), event.dwell) < 0;
+    } else {
+        failed = fprintf(file, "D %s %u\n", event.plate, event.time) < 0;
+    }
+    if (!failed) {
+        eventCount++;
+    }
+    return !failed;
+}
+
+// 回填事件数并关闭文件
+bool TraceWriter::close() {
+    if (file == nullptr) {
+        return false;
+    }
+    if (binary && !failed) {
+        uint64_t count = eventCount;
+        failed = fseek(file, static_cast<long>(offsetof(TraceHeader, eventCount)), SEEK_SET) != 0 ||
+                 fwrite(&count, sizeof(count), 1, file) != 1;
+    }
+    if (fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+// 获取已写入的事件数
+uint64_t TraceWriter::count() const {
+    return eventCount;
+}
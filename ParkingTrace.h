@@ -0,0 +1,147 @@
+#ifndef PARKINGTRACE_H
+#define PARKINGTRACE_H
+
+#include "Car.h"
+#include "MappedFile.h"
+#include <string>
+#include <fstream>
+#include <cstdio>
+
+// 车流轨迹（模拟器的输入）
+// 文本格式每行一个事件，沿用课题测试数据的('A'/'D', 车牌, 时间)形式，后面可以附加车型和停车时长：
+//   A 车牌 时间 [车型 [停车时长]]     车辆到达（车型默认为0即小型车）
+//   D 车牌 时间                     车辆离开
+// 时间为秒数，事件按时间先后排列（相同时间的事件按出现次序处理）；空行和'#'开头的行忽略。
+// 停车时长不为0的到达由模拟器在车辆进入停车场后按时长安排离开，轨迹中不必再写离开事件。
+//
+// 二进制格式 [TraceHeader][TraceEvent × eventCount]：事件按内存布局原样写入，
+// 读取时映射文件后逐条复制（或直接访问映射的事件数组），不逐字段解析。
+// 与快照一样，文件头记录了事件大小和字节序标记，只能在布局相同的平台之间交换。
+const uint32_t TRACE_VERSION = 1;
+
+enum TraceOp : unsigned char {
+    TRACE_ARRIVAL = 'A',        // 车辆到达
+    TRACE_DEPARTURE = 'D'       // 车辆离开
+};
+
+// 轨迹事件（定长、可平凡复制）
+struct TraceEvent {
+    uint32_t time;              // 事件时间（秒）
+    uint32_t dwell;             // 停车时长（秒，从进入停车场开始计；0表示由轨迹中的离开事件决定）
+    uint8_t op;                 // 事件类型（TraceOp）
+    uint8_t carType;            // 车型（仅到达事件有效）
+    uint8_t plateLength;        // 车牌长度
+    uint8_t reserved;           // 保留（恒为0）
+    char plate[Car::MAX_PLATE_LENGTH + 1];  // 车牌号（未用部分填0）
+    
+    // 取得车牌
+    PlateView plateView() const { return PlateView(plate, plateLength); }
+};
+
+// 二进制轨迹文件头
+struct TraceHeader {
+    char magic[8];              // 文件标识"PARKTRCE"
+    uint32_t version;           // 格式版本
+    uint32_t byteOrder;         // 字节序标记（写入0x01020304）
+    uint32_t eventSize;         // 事件大小（sizeof(TraceEvent)）
+    uint32_t seed;              // 生成轨迹使用的种子（不是生成的轨迹时为0）
+    uint64_t eventCount;        // 事件数
+};
+
+// 轨迹读取器
+// 文本轨迹逐行读取，二进制轨迹映射文件后逐条复制，都不把整个文件读入堆内存，
+// 任意大小的轨迹都可以边读边模拟。打开时按文件标识自动区分两种格式。
+class TraceReader {
+private:
+    std::ifstream in;           // 文本轨迹文件
+    std::string line;           // 当前行（复用缓冲区）
+    MappedFile mapped;          // 映射的二进制轨迹文件
+    const TraceEvent* events;   // 二进制轨迹的事件数组（指向映射的文件，文本轨迹为nullptr）
+    uint64_t eventCount;        // 二进制轨迹的事件数
+    uint64_t position;          // 二进制轨迹中下一个事件的下标
+    unsigned long lineNumber;   // 当前行号
+    uint32_t lastTime;          // 上一个事件的时间（检查事件次序）
+    std::string errorText;      // 出错原因（没有错误时为空）
+    
+public:
+    // 构造函数
+    TraceReader();
+    
+    // 打开轨迹文件（文本或二进制），失败返回false（二进制文件头不符时error()给出原因）
+    bool open(const std::string& filename);
+    
+    // 判断打开的是否为二进制轨迹
+    bool isBinary() const;
+    
+    // 获取二进制轨迹的事件数组和事件数（指向映射的文件，读取器关闭前有效；文本轨迹返回nullptr）
+    // 基准测试可以直接遍历，不经过next的逐条复制和检查
+    const TraceEvent* data() const;
+    uint64_t size() const;
+    
+    // 读取下一个事件
+    // 返回false表示已读完或出错（出错时error()不为空，之后的读取都返回false）
+    bool next(TraceEvent& event);
+    
+    // 获取出错原因（文本轨迹带行号，二进制轨迹带事件序号）
+    const std::string& error() const;
+    
+    // 获取已读取的行数（二进制轨迹为已读取的事件数）
+    unsigned long getLineNumber() const;
+    
+private:
+    // 解析一行，成功返回true；空行和注释行返回false且不设置错误
+    bool parseLine(TraceEvent& event);
+    
+    // 映射并校验二进制轨迹
+    bool openBinary(const std::string& filename);
+    
+    // 记录错误
+    void fail(const char* reason);
+    
+    // 读取器不可复制
+    TraceReader(const TraceReader&);
+    TraceReader& operator=(const TraceReader&);
+};
+
+// 轨迹写入器
+// 二进制格式按块缓冲后整块写入，关闭时回填文件头中的事件数；文本格式便于查看和手工编辑
+class TraceWriter {
+private:
+    FILE* file;                 // 轨迹文件（未打开时为nullptr）
+    bool binary;                // 是否写二进制格式
+    uint32_t seed;              // 写入文件头的种子
+    uint64_t eventCount;        // 已写入的事件数
+    bool failed;                // 是否发生过写入错误
+    
+public:
+    // 构造函数
+    TraceWriter();
+    
+    // 析构函数（自动关闭）
+    ~TraceWriter();
+    
+    // 创建轨迹文件（已存在则覆盖）
+    bool open(const std::string& filename, bool binaryFormat = true, uint32_t generatorSeed = 0);
+    
+    // 写入一个事件
+    bool write(const TraceEvent& event);
+    
+    // 回填事件数并关闭文件，返回全部写入是否成功
+    bool close();
+    
+    // 获取已写入的事件数
+    uint64_t count() const;
+    
+private:
+    // 写入器不可复制
+    TraceWriter(const TraceWriter&);
+    TraceWriter& operator=(const TraceWriter&);
+};
+
+// 填写轨迹事件的车牌，车牌过长或为空时返回false
+bool setTracePlate(TraceEvent& event, const char* plate, size_t length);
+
+// 校验轨迹事件的字段（事件类型、车型、车牌长度；不检查事件次序）
+bool isValidTraceEvent(const TraceEvent& event);
+
+#endif // PARKINGTRACE_H
@@ -0,0 +1,133 @@
+#include "ParkingTracer.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+// 线程编号（每个线程第一次记录时领取，从1开始，作为Chrome跟踪中的tid）
+static atomic<uint32_t> nextThreadNumber(1);
+
+static uint32_t localThreadNumber() {
+    static thread_local uint32_t number = nextThreadNumber.fetch_add(1, memory_order_relaxed);
+    return number;
+}
+
+// 构造函数
+ParkingTracer::ParkingTracer(int capacity)
+    : cells(nullptr), mask(0), nextPosition(0), origin(now()), steadyOrigin(chrono::steady_clock::now()) {
+    uint64_t rounded = 2;
+    while (rounded < static_cast<uint64_t>(capacity)) {
+        rounded <<= 1;
+    }
+    cells = new Cell[rounded];
+    mask = rounded - 1;
+    clear();
+}
+
+// 析构函数
+ParkingTracer::~ParkingTracer() {
+    delete[] cells;
+}
+
+// 记录一个阶段
+// 与顺序锁相同：先把序号清零，写入字段，再发布序号；读取方前后两次读到相同的序号才采用
+void ParkingTracer::record(const char* name, uint64_t start, uint64_t end, uint32_t value) {
+    uint64_t position = nextPosition.fetch_add(1, memory_order_relaxed);
+    Cell& cell = cells[position & mask];
+    cell.sequence.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    cell.name.store(name, memory_order_relaxed);
+    cell.begin.store(start > origin ? start - origin : 0, memory_order_relaxed);
+    cell.duration.store(end > start ? end - start : 0, memory_order_relaxed);
+    cell.thread.store(localThreadNumber(), memory_order_relaxed);
+    cell.value.store(value, memory_order_relaxed);
+    cell.sequence.store(position + 1, memory_order_release);
+}
+
+// 获取已记录的阶段数
+uint64_t ParkingTracer::count() const {
+    return nextPosition.load(memory_order_relaxed);
+}
+
+// 获取缓冲区容量
+int ParkingTracer::capacity() const {
+    return static_cast<int>(mask + 1);
+}
+
+// 清空缓冲区
+void ParkingTracer::clear() {
+    for (uint64_t i = 0; i <= mask; i++) {
+        cells[i].sequence.store(0, memory_order_relaxed);
+    }
+    nextPosition.store(0, memory_order_relaxed);
+}
+
+// 每个计时读数对应的纳秒数
+double ParkingTracer::nanosecondsPerTick() const {
+#ifdef PARKING_TRACE_TSC
+    // 时间戳计数器的频率按创建以来两种读数的增量换算（输出时距创建越久越准确）
+    uint64_t ticks = now() - origin;
+    double nanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - steadyOrigin).count();
+    return ticks > 0 && nanoseconds > 0 ? nanoseconds / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+// 输出纳秒数为微秒（Chrome跟踪格式的时间单位），保留3位小数
+static void writeMicroseconds(ostream& out, uint64_t ns) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%llu.%03u",
+             static_cast<unsigned long long>(ns / 1000), static_cast<unsigned>(ns % 1000));
+    out << buffer;
+}
+
+// 按Chrome跟踪格式输出
+// 每个阶段是一个完整事件（"ph":"X"，开始时间加持续时间），按缓冲区中的次序输出，查看工具会按时间排列
+uint64_t ParkingTracer::writeChromeTrace(ostream& out) const {
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ParkingSystem\"}}";
+    
+    double scale = nanosecondsPerTick();
+    uint64_t end = nextPosition.load(memory_order_acquire);
+    uint64_t begin = end > mask + 1 ? end - (mask + 1) : 0;
+    uint64_t written = 0;
+    for (uint64_t position = begin; position < end; position++) {
+        const Cell& cell = cells[position & mask];
+        uint64_t sequence = cell.sequence.load(memory_order_acquire);
+        if (sequence != position + 1) {
+            continue;   // 正在写入或已被之后的记录覆盖
+        }
+        const char* name = cell.name.load(memory_order_relaxed);
+        uint64_t start = cell.begin.load(memory_order_relaxed);
+        uint64_t duration = cell.duration.load(memory_order_relaxed);
+        uint32_t thread = cell.thread.load(memory_order_relaxed);
+        uint32_t value = cell.value.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (cell.sequence.load(memory_order_relaxed) != sequence) {
+            continue;
+        }
+        
+        // 阶段名称都是代码中的ASCII字符串常量，不需要转义
+        out << ",\n{\"name\":\"" << name << "\",\"cat\":\"parking\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+            << ",\"ts\":";
+        writeMicroseconds(out, static_cast<uint64_t>(static_cast<double>(start) * scale));
+        out << ",\"dur\":";
+        writeMicroseconds(out, static_cast<uint64_t>(static_cast<double>(duration) * scale));
+        out << ",\"args\":{\"value\":" << value << "}}";
+        written++;
+    }
+    out << "\n]}\n";
+    return written;
+}
+
+// 按Chrome跟踪格式写入文件
+bool ParkingTracer::flushToFile(const string& filename) const {
+    ofstream out(filename.c_str(), ios::trunc);
+    if (!out) {
+        return false;
+    }
+    writeChromeTrace(out);
+    out.close();
+    return !out.fail();
+}
@@ -0,0 +1,134 @@
+#ifndef PARKINGTRACER_H
+#define PARKINGTRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// x86上阶段计时读取时间戳计数器（rdtsc，比steady_clock便宜），输出时按与steady_clock的对照换算为纳秒；
+// 要求计数器频率恒定（constant_tsc，近年的x86处理器都满足）。其他平台或定义PARKING_TRACE_STEADY_CLOCK时读取steady_clock
+#if !defined(PARKING_TRACE_STEADY_CLOCK) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define PARKING_TRACE_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// 操作阶段跟踪（可选）：记录到达/离开各阶段的起止时间，输出为Chrome跟踪格式（JSON），
+// 可以在chrome://tracing或Perfetto中按线程查看每次操作的时间花在哪里。
+// 挂接到ParkingSystem后（setTracer）记录，没有挂接时各阶段只判断一次空指针。
+// 挂接后每个阶段约增加几十纳秒（读取计时和写入一个单元；前后相接的阶段共用一次计时读数），
+// 一次到达加一次离开记录约11个阶段，见parking_bench tracer。
+//
+// 阶段记录在定长的环形缓冲区中：写入方用原子加法领取位置，写完后发布该单元的序号，不加锁；
+// 缓冲区写满后覆盖最早的记录，输出的是最近的capacity个阶段。
+// 输出时按序号校验每个单元，跳过正在写入的单元，可以与写入同时进行；
+// 写入速度快到在一个单元写完之前绕回同一单元时，该记录可能丢失或错乱（容量足够大时不会发生）。
+class ParkingTracer {
+private:
+    // 缓冲区单元（字段都是relaxed原子变量，输出时可以与写入同时读取）
+    struct Cell {
+        std::atomic<uint64_t> sequence;     // 写入位置+1（0表示空或正在写入）
+        std::atomic<const char*> name;      // 阶段名称（字符串常量，不复制）
+        std::atomic<uint64_t> begin;        // 开始时间（计时读数，相对于跟踪器创建的时刻）
+        std::atomic<uint64_t> duration;     // 持续时间（计时读数之差）
+        std::atomic<uint32_t> thread;       // 线程编号
+        std::atomic<uint32_t> value;        // 附加值（车辆ID、让路车辆数等，含义见各阶段）
+    };
+    
+    Cell* cells;                        // 缓冲区（容量为2的幂）
+    uint64_t mask;                      // 容量减1
+    std::atomic<uint64_t> nextPosition; // 下一个写入位置
+    uint64_t origin;                    // 跟踪器创建时的计时读数
+    std::chrono::steady_clock::time_point steadyOrigin; // 跟踪器创建时的steady_clock读数（换算计时读数用）
+    
+public:
+    // 构造函数（容量向上取整为2的幂）
+    explicit ParkingTracer(int capacity = 65536);
+    
+    // 析构函数
+    ~ParkingTracer();
+    
+    // 取得计时读数（x86上为时间戳计数器的周期数，其他平台为steady_clock的纳秒数；只用于相减）
+    static uint64_t now() {
+#ifdef PARKING_TRACE_TSC
+        return static_cast<uint64_t>(__rdtsc());
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    
+    // 记录一个阶段（start和end为now()的读数）
+    void record(const char* name, uint64_t start, uint64_t end, uint32_t value = 0);
+    
+    // 获取已记录的阶段数（含已被覆盖的）
+    uint64_t count() const;
+    
+    // 获取缓冲区容量
+    int capacity() const;
+    
+    // 清空缓冲区（不能与写入同时调用）
+    void clear();
+    
+    // 按Chrome跟踪格式输出缓冲区中的阶段，返回输出的阶段数
+    uint64_t writeChromeTrace(std::ostream& out) const;
+    
+    // 按Chrome跟踪格式写入文件
+    bool flushToFile(const std::string& filename) const;
+    
+private:
+    // 每个计时读数对应的纳秒数（按创建以来的计时读数与steady_clock对照）
+    double nanosecondsPerTick() const;
+    
+    // 跟踪器不可复制
+    ParkingTracer(const ParkingTracer&);
+    ParkingTracer& operator=(const ParkingTracer&);
+};
+
+// 阶段计时：构造时记下开始时间，finish或析构时记录（跟踪器为nullptr时什么也不做）
+// 紧接着上一个阶段开始的阶段可以从上一个阶段构造，直接以它结束时的读数为开始时间，少读一次计时
+class TraceScope {
+private:
+    ParkingTracer* tracer;
+    const char* name;           // 阶段名称（结束后为nullptr）
+    uint64_t start;             // 开始时的读数（结束后为结束时的读数）
+    uint32_t value;
+    
+public:
+    TraceScope(ParkingTracer* target, const char* phase, uint32_t phaseValue = 0)
+        : tracer(target), name(phase), start(target != nullptr ? ParkingTracer::now() : 0), value(phaseValue) {}
+    
+    // 紧接着previous开始（previous必须已经finish）
+    TraceScope(const TraceScope& previous, const char* phase, uint32_t phaseValue = 0)
+        : tracer(previous.tracer), name(phase), start(previous.start), value(phaseValue) {}
+    
+    ~TraceScope() {
+        finish();
+    }
+    
+    // 设置附加值（在阶段结束前得知时使用）
+    void setValue(uint32_t phaseValue) {
+        value = phaseValue;
+    }
+    
+    // 提前结束阶段（之后析构不再记录）
+    void finish() {
+        if (tracer != nullptr && name != nullptr) {
+            uint64_t end = ParkingTracer::now();
+            tracer->record(name, start, end, value);
+            name = nullptr;
+            start = end;
+        }
+    }
+    
+private:
+    TraceScope(const TraceScope&);
+    TraceScope& operator=(const TraceScope&);
+};
+
+#endif // PARKINGTRACER_H
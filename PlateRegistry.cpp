@@ -0,0 +1,180 @@
+#include "PlateRegistry.h"
+#include <cstring>
+
+using namespace std;
+
+const uint32_t PlateRegistry::EMPTY_SLOT;
+const uint32_t PlateRegistry::DELETED_SLOT;
+
+// 构造函数
+PlateRegistry::PlateRegistry() : liveCount(0), usedSlots(0) {
+    slots.assign(16, EMPTY_SLOT);
+}
+
+// 计算车牌哈希值（FNV-1a）
+uint32_t PlateRegistry::hashPlate(const PlateView& plate) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < plate.size(); i++) {
+        hash ^= static_cast<unsigned char>(plate.data()[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// 查找车牌所在的槽，未找到返回-1
+long PlateRegistry::findSlot(const PlateView& plate, uint32_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    
+    while (slots[slot] != EMPTY_SLOT) {
+        uint32_t id = slots[slot];
+        if (id != DELETED_SLOT) {
+            const Entry& entry = entries[id];
+            if (entry.hash == hash && PlateView(entry.plate, entry.length) == plate) {
+                return static_cast<long>(slot);
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+// 登记车牌，返回车辆ID（已登记则返回原ID）
+uint32_t PlateRegistry::intern(const PlateView& plate) {
+    uint32_t hash = hashPlate(plate);
+    long existing = findSlot(plate, hash);
+    if (existing >= 0) {
+        return slots[existing];
+    }
+    
+    // 负载因子（含删除标记）保持在1/2以下
+    if (static_cast<size_t>(usedSlots + 1) * 2 > slots.size()) {
+        size_t newSlotCount = slots.size();
+        while (static_cast<size_t>(liveCount + 1) * 2 > newSlotCount / 2) {
+            newSlotCount *= 2;
+        }
+        rehash(newSlotCount);
+    }
+    
+    // 优先复用已回收的ID
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<uint32_t>(entries.size());
+        entries.push_back(Entry());
+    }
+    
+    Entry& entry = entries[id];
+    size_t length = plate.size() > static_cast<size_t>(Car::MAX_PLATE_LENGTH)
+                  ? static_cast<size_t>(Car::MAX_PLATE_LENGTH) : plate.size();
+    memcpy(entry.plate, plate.data(), length);
+    entry.plate[length] = '\0';
+    entry.length = static_cast<unsigned char>(length);
+    entry.live = true;
+    entry.hash = hash;
+    
+    // 插入到第一个空槽或删除标记处
+    size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    while (slots[slot] != EMPTY_SLOT && slots[slot] != DELETED_SLOT) {
+        slot = (slot + 1) & mask;
+    }
+    if (slots[slot] == EMPTY_SLOT) {
+        usedSlots++;
+    }
+    slots[slot] = id;
+    liveCount++;
+    return id;
+}
+
+// 查找车牌对应的车辆ID
+uint32_t PlateRegistry::find(const PlateView& plate) const {
+    long slot = findSlot(plate, hashPlate(plate));
+    return slot >= 0 ? slots[slot] : INVALID_VEHICLE_ID;
+}
+
+// 注销车辆ID
+void PlateRegistry::release(uint32_t id) {
+    if (!isLive(id)) {
+        return;
+    }
+    
+    Entry& entry = entries[id];
+    long slot = findSlot(PlateView(entry.plate, entry.length), entry.hash);
+    if (slot >= 0) {
+        slots[slot] = DELETED_SLOT;
+    }
+    entry.live = false;
+    freeIds.push_back(id);
+    liveCount--;
+}
+
+// 获取车辆ID对应的车牌号
+PlateView PlateRegistry::plateOf(uint32_t id) const {
+    if (id >= entries.size()) {
+        return PlateView();
+    }
+    return PlateView(entries[id].plate, entries[id].length);
+}
+
+// 检查车辆ID是否处于登记状态
+bool PlateRegistry::isLive(uint32_t id) const {
+    return id < entries.size() && entries[id].live;
+}
+
+// 获取当前登记的车牌数量
+int PlateRegistry::size() const {
+    return liveCount;
+}
+
+// 获取ID上界
+uint32_t PlateRegistry::idLimit() const {
+    return static_cast<uint32_t>(entries.size());
+}
+
+// 预留容量
+void PlateRegistry::reserve(int count) {
+    if (count <= 0) {
+        return;
+    }
+    entries.reserve(count);
+    
+    // 登记count个车牌后负载因子仍不超过1/2
+    size_t newSlotCount = slots.size();
+    while (static_cast<size_t>(count) * 2 > newSlotCount) {
+        newSlotCount *= 2;
+    }
+    if (newSlotCount != slots.size()) {
+        rehash(newSlotCount);
+    }
+}
+
+// 清空登记表
+void PlateRegistry::clear() {
+    entries.clear();
+    freeIds.clear();
+    slots.assign(16, EMPTY_SLOT);
+    liveCount = 0;
+    usedSlots = 0;
+}
+
+// 重建哈希表（同时清除删除标记）
+void PlateRegistry::rehash(size_t newSlotCount) {
+    slots.assign(newSlotCount, EMPTY_SLOT);
+    usedSlots = 0;
+    
+    size_t mask = newSlotCount - 1;
+    for (uint32_t id = 0; id < entries.size(); id++) {
+        if (!entries[id].live) {
+            continue;
+        }
+        size_t slot = entries[id].hash & mask;
+        while (slots[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+        usedSlots++;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef PLATEREGISTRY_H
+#define PLATEREGISTRY_H
+
+#include "Car.h"
+#include <vector>
+
+// 车牌登记表
+// 车辆在大门处登记一次车牌，换取一个稠密的32位车辆ID；
+// 停车场、候车道和系统内部都用ID存储、比较和索引，车牌字符串只在入口处比较一次。
+// 内部使用开放寻址（线性探测）哈希表，车辆离场后ID被回收复用，ID始终保持稠密。
+class PlateRegistry {
+private:
+    // 按ID存储的登记记录
+    struct Entry {
+        char plate[Car::MAX_PLATE_LENGTH + 1];  // 车牌号
+        unsigned char length;                   // 车牌长度
+        bool live;                              // 是否仍在使用
+        uint32_t hash;                          // 车牌哈希值（扩容时无需重新计算）
+    };
+    
+    std::vector<Entry> entries;      // ID -> 登记记录
+    std::vector<uint32_t> freeIds;   // 已回收、可复用的ID
+    std::vector<uint32_t> slots;     // 哈希槽，存放ID或EMPTY_SLOT/DELETED_SLOT
+    int liveCount;                   // 当前登记的车牌数量
+    int usedSlots;                   // 已占用的槽数量（含删除标记）
+    
+    static const uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+    static const uint32_t DELETED_SLOT = 0xFFFFFFFEu;
+    
+public:
+    // 构造函数
+    PlateRegistry();
+    
+    // 登记车牌，返回车辆ID（已登记则返回原ID）
+    uint32_t intern(const PlateView& plate);
+    
+    // 查找车牌对应的车辆ID，未登记返回INVALID_VEHICLE_ID
+    uint32_t find(const PlateView& plate) const;
+    
+    // 注销车辆ID（车辆离场后调用），ID会被后续登记复用
+    void release(uint32_t id);
+    
+    // 获取车辆ID对应的车牌号
+    PlateView plateOf(uint32_t id) const;
+    
+    // 检查车辆ID是否处于登记状态
+    bool isLive(uint32_t id) const;
+    
+    // 获取当前登记的车牌数量
+    int size() const;
+    
+    // 获取ID上界（所有ID都小于该值），用于按ID索引的数组
+    uint32_t idLimit() const;
+    
+    // 预留容量，登记count个车牌之前不再扩容重建哈希表
+    void reserve(int count);
+    
+    // 清空登记表
+    void clear();
+    
+private:
+    // 计算车牌哈希值（FNV-1a）
+    static uint32_t hashPlate(const PlateView& plate);
+    
+    // 查找车牌所在的槽，未找到返回-1
+    long findSlot(const PlateView& plate, uint32_t hash) const;
+    
+    // 重建哈希表
+    void rehash(size_t newSlotCount);
+};
+
+#endif // PLATEREGISTRY_H
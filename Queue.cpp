@@ -1,140 +1,221 @@
 #include "Queue.h"
+#include "TimestampFormat.h"
 #include <iostream>
 #include <iomanip>
 
 using namespace std;
 
-// 캯
-Queue::Queue() : front(nullptr), rear(nullptr), count(0) {}
+const int Queue::NIL;
+const int Queue::FREE;
 
-// 
-Queue::~Queue() {
-    clear();
+// 构造函数
+Queue::Queue() : front(NIL), rear(NIL), freeList(NIL), count(0) {}
+
+// 预留节点池容量
+void Queue::reserve(int capacity) {
+    if (capacity > 0) {
+        nodes.reserve(capacity);
+    }
 }
 
-// ж϶ǷΪ
+// 判断队列是否为空
 bool Queue::isEmpty() const {
-    return front == nullptr;
+    return front == NIL;
 }
 
-// ȡԪ
+// 获取队列中元素数量
 int Queue::size() const {
     return count;
 }
 
-// Ӳ
-void Queue::enqueue(const Car& car) {
-    QueueNode* newNode = new QueueNode(car);
+// 入队操作
+int Queue::enqueue(const Car& car) {
+    // 优先复用空闲节点，没有空闲节点时才扩充节点池
+    int newNode;
+    if (freeList != NIL) {
+        newNode = freeList;
+        freeList = nodes[newNode].next;
+        nodes[newNode].car = car;
+        nodes[newNode].next = NIL;
+        nodes[newNode].prev = NIL;
+    } else {
+        newNode = static_cast<int>(nodes.size());
+        nodes.push_back(QueueNode(car));
+    }
     
     if (isEmpty()) {
         front = rear = newNode;
     } else {
-        rear->next = newNode;
+        nodes[rear].next = newNode;
+        nodes[newNode].prev = rear;
         rear = newNode;
     }
     
     count++;
+    return newNode;
 }
 
-// Ӳ
+// 出队操作
 bool Queue::dequeue() {
     if (isEmpty()) {
         return false;
     }
+    return removeNode(front);
+}
+
+// 移除指定节点上的车辆
+bool Queue::removeNode(int index) {
+    if (index < 0 || index >= static_cast<int>(nodes.size()) || nodes[index].prev == FREE) {
+        return false;
+    }
     
-    QueueNode* temp = front;
-    front = front->next;
-    
-    if (front == nullptr) {
-        rear = nullptr;
+    // 从双向链表中摘下节点
+    QueueNode& node = nodes[index];
+    if (node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    } else {
+        front = node.next;
+    }
+    if (node.next != NIL) {
+        nodes[node.next].prev = node.prev;
+    } else {
+        rear = node.prev;
     }
     
-    delete temp;
+    // 节点归还空闲链表
+    node.next = freeList;
+    node.prev = FREE;
+    freeList = index;
     count--;
     return true;
 }
 
-// ȡͷԪ
+// 获取队头元素
 Car Queue::getFront() const {
     if (isEmpty()) {
-        // һĬϵCar
+        // 返回一个默认的Car对象
         return Car();
     }
-    return front->car;
+    return nodes[front].car;
+}
+
+// 获取队头节点下标
+int Queue::getFrontNode() const {
+    return front;
+}
+
+// 获取指定下标的节点
+const QueueNode& Queue::getNode(int index) const {
+    return nodes[index];
 }
 
-// ҳͨƺţ
+// 查找车辆（通过车牌号）
 int Queue::findCar(const string& licensePlate) const {
-    QueueNode* current = front;
+    PlateView target(licensePlate);
+    int current = front;
+    int position = 1;
+    
+    while (current != NIL) {
+        if (nodes[current].car.plate() == target) {
+            return position;
+        }
+        current = nodes[current].next;
+        position++;
+    }
+    
+    return 0; // 未找到
+}
+
+// 查找车辆（通过车辆ID）
+int Queue::findCarById(uint32_t vehicleId) const {
+    int current = front;
     int position = 1;
     
-    while (current != nullptr) {
-        if (current->car.getLicensePlate() == licensePlate) {
+    while (current != NIL) {
+        if (nodes[current].car.getVehicleId() == vehicleId) {
             return position;
         }
-        current = current->next;
+        current = nodes[current].next;
         position++;
     }
     
-    return 0; // δҵ
+    return 0; // 未找到
 }
 
-// ȡָλõĳӶͷʼ1ʾͷ
+// 获取指定位置的车辆（从队头开始计数，1表示队头）
 Car Queue::getCarAt(int position) const {
     if (position < 1 || position > count) {
-        // λЧĬCar
+        // 位置无效，返回默认Car对象
         return Car();
     }
     
-    QueueNode* current = front;
+    int current = front;
     for (int i = 1; i < position; i++) {
-        current = current->next;
+        current = nodes[current].next;
     }
     
-    return current->car;
+    return nodes[current].car;
 }
 
-// ʾгϢ
+// 遍历队列中车辆
+Queue::const_iterator Queue::begin() const {
+    return const_iterator(this, front);
+}
+
+Queue::const_iterator Queue::end() const {
+    return const_iterator(this, NIL);
+}
+
+Queue::const_reverse_iterator Queue::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+Queue::const_reverse_iterator Queue::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+// 显示队列中所有车辆信息
 void Queue::display() const {
     if (isEmpty()) {
-        cout << "򳵵Ϊ" << endl;
+        cout << "候车道为空" << endl;
         return;
     }
     
-    cout << "򳵵״̬ͷǰ棩" << endl;
+    cout << "候车道状态（队头在最前面）：" << endl;
     cout << "==========================================" << endl;
-    cout << left << setw(15) << "λ" 
-         << setw(15) << "ƺ" 
-         << setw(15) << "" 
-         << setw(20) << "ʱ" << endl;
+    cout << left << setw(15) << "位置" 
+         << setw(15) << "车牌号" 
+         << setw(15) << "车型" 
+         << setw(20) << "进入时间" << endl;
     cout << "------------------------------------------" << endl;
     
-    QueueNode* current = front;
+    int current = front;
     int position = 1;
     
-    while (current != nullptr) {
-        Car car = current->car;
+    while (current != NIL) {
+        const Car& car = nodes[current].car;
         
-        // תʱΪַ
-        char entryTimeStr[20];
-        time_t entryTime = car.getEntryTime();
-        struct tm* timeinfo = localtime(&entryTime);
-        strftime(entryTimeStr, sizeof(entryTimeStr), "%Y-%m-%d %H:%M:%S", timeinfo);
+        // 转换时间为字符串
+        char entryTimeStr[TIMESTAMP_BUFFER_SIZE];
+        formatTimestamp(car.getEntryTime(), entryTimeStr);
         
         cout << left << setw(15) << position
-             << setw(15) << car.getLicensePlate()
+             << setw(15) << car.plate()
              << setw(15) << car.getTypeString()
              << setw(20) << entryTimeStr << endl;
         
-        current = current->next;
+        current = nodes[current].next;
         position++;
     }
     cout << "==========================================" << endl;
 }
 
-// ն
+// 清空队列
+// 节点池的内存保留，供后续入队复用
 void Queue::clear() {
-    while (!isEmpty()) {
-        dequeue();
-    }
+    nodes.clear();
+    front = NIL;
+    rear = NIL;
+    freeList = NIL;
+    count = 0;
 }
@@ -2,54 +2,138 @@
 #define QUEUE_H
 
 #include "Car.h"
+#include <vector>
+#include <iterator>
+#include <cstddef>
 
-// нڵṹ
+// 队列节点结构
+// 节点存放在队列自己的节点池中，next/prev是前后节点在池中的下标（双向链表）
 struct QueueNode {
-    Car car;            // 
-    QueueNode* next;    // ָһڵָ
+    Car car;            // 车辆数据
+    int next;           // 下一个节点的下标（-1表示没有）
+    int prev;           // 上一个节点的下标（-1表示没有，-2表示节点空闲）
     
-    QueueNode(const Car& c) : car(c), next(nullptr) {}
+    QueueNode() : next(-1), prev(-1) {}
+    QueueNode(const Car& c) : car(c), next(-1), prev(-1) {}
 };
 
+// 候车道队列
+// 节点从节点池中分配，出队的节点挂到空闲链表上供后续入队复用，
+// 稳定运行时入队和出队都不再调用new/delete。
+// 节点之间双向链接，已知节点下标时可在O(1)时间内从队列中间移除车辆。
+// 节点池是普通的vector，队列可以直接复制、赋值和移动。
 class Queue {
 private:
-    QueueNode* front;   // ͷָ
-    QueueNode* rear;    // βָ
-    int count;          // Ԫ
+    std::vector<QueueNode> nodes;   // 节点池
+    int front;          // 队头节点下标
+    int rear;           // 队尾节点下标
+    int freeList;       // 空闲节点链表头
+    int count;          // 队列中元素数量
     
 public:
-    // 캯
+    static const int NIL = -1;      // 空节点下标
+    static const int FREE = -2;     // 空闲节点的prev标记
+    
+    // 只读双向迭代器，从队头到队尾按链表次序遍历（不复制、不修改）
+    class const_iterator {
+    private:
+        const Queue* queue;     // 所属队列
+        int node;               // 当前节点下标（NIL表示末尾）
+        
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Car value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Car* pointer;
+        typedef const Car& reference;
+        
+        const_iterator() : queue(nullptr), node(NIL) {}
+        const_iterator(const Queue* q, int index) : queue(q), node(index) {}
+        
+        reference operator*() const { return queue->nodes[node].car; }
+        pointer operator->() const { return &queue->nodes[node].car; }
+        
+        // 当前车辆所在节点下标
+        int index() const { return node; }
+        
+        const_iterator& operator++() {
+            node = queue->nodes[node].next;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        const_iterator& operator--() {
+            node = (node == NIL) ? queue->rear : queue->nodes[node].prev;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --*this;
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+    };
+    
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    
+    // 构造函数
     Queue();
     
-    // 
-    ~Queue();
+    // 预留节点池容量
+    void reserve(int capacity);
     
-    // ж϶ǷΪ
+    // 判断队列是否为空
     bool isEmpty() const;
     
-    // ȡԪ
+    // 获取队列中元素数量
     int size() const;
     
-    // Ӳ
-    void enqueue(const Car& car);
+    // 入队操作
+    // 返回新车辆所在节点的下标（节点在车辆出队前保持不变）
+    int enqueue(const Car& car);
     
-    // Ӳ
+    // 出队操作
     bool dequeue();
     
-    // ȡͷԪ
+    // 移除指定节点上的车辆（O(1)，其余车辆保持原有次序）
+    // 节点下标无效或节点已空闲时返回false
+    bool removeNode(int index);
+    
+    // 获取队头元素
     Car getFront() const;
     
-    // ҳͨƺţ
-    // سڶеλãӶͷʼ1ʾͷ
+    // 获取队头节点下标（队列为空时返回NIL）
+    int getFrontNode() const;
+    
+    // 获取指定下标的节点
+    const QueueNode& getNode(int index) const;
+    
+    // 查找车辆（通过车牌号）
+    // 返回车辆在队列中的位置（从队头开始计数，1表示队头）
     int findCar(const std::string& licensePlate) const;
     
-    // ȡָλõĳӶͷʼ1ʾͷ
+    // 查找车辆（通过车辆ID，整数比较）
+    // 返回值含义同findCar
+    int findCarById(uint32_t vehicleId) const;
+    
+    // 获取指定位置的车辆（从队头开始计数，1表示队头）
     Car getCarAt(int position) const;
     
-    // ʾгϢ
+    // 遍历队列中车辆（正向从队头开始，反向从队尾开始）
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+    
+    // 显示队列中所有车辆信息
     void display() const;
     
-    // ն
+    // 清空队列
     void clear();
 };
 
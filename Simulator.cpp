@@ -0,0 +1,430 @@
+#include "ParkingSystem.h"
+#include "ParkingTrace.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+// 轨迹驱动的离散事件模拟器（parking_sim）
+// 按事件时间次序把轨迹中的到达/离开送入ParkingSystem：轨迹按时间逐行读入，
+// 带停车时长的到达在车辆进入停车场后由模拟器安排离开事件，两路事件按时间合并（同一时刻先处理离开）。
+// 结束后输出处理速度、候车道峰值长度、候车时间分布、让路次数和收入，用于容量规划和回归对比。
+
+// 模拟参数
+struct SimulationOptions {
+    string traceFile;           // 轨迹文件
+    string metricsFile;         // 运行指标的输出文件（Prometheus文本格式，"-"表示标准输出，空表示不记录）
+    string chromeTraceFile;     // 操作阶段跟踪的输出文件（Chrome跟踪格式，空表示不记录）
+    int traceCapacity;          // 阶段跟踪保留的阶段数
+    int capacity;               // 停车场容量
+    int spaces[3];              // 小/中/大型车位数量（-1表示按容量平均分配）
+    int reserve[3];             // 保留感知策略的保留量
+    double hourlyRate;          // 每小时费率
+    AllocationPolicyKind policy;    // 车位分配策略
+    
+    SimulationOptions() : traceCapacity(1 << 20), capacity(10), hourlyRate(5.0), policy(ALLOCATE_STRICT) {
+        for (int i = 0; i < 3; i++) {
+            spaces[i] = -1;
+            reserve[i] = 0;
+        }
+    }
+};
+
+// 模拟器安排的离开事件
+struct ScheduledDeparture {
+    uint32_t time;              // 离开时间
+    uint64_t sequence;          // 对应到达的序号（车辆提前离开后再次到达时，旧的离开事件作废）
+    TraceEvent event;           // 离开事件（车牌）
+    
+    bool operator>(const ScheduledDeparture& other) const {
+        return time != other.time ? time > other.time : sequence > other.sequence;
+    }
+};
+
+// 模拟统计
+struct SimulationStats {
+    unsigned long long traceEvents;     // 轨迹中的事件数
+    unsigned long long scheduledEvents; // 模拟器安排的离开事件数
+    unsigned long long parkedDirectly;  // 到达后直接停入停车场
+    unsigned long long diverted;        // 到达后进入候车道
+    unsigned long long rejected;        // 到达失败（车牌重复、车牌或车型无效）
+    unsigned long long lotDepartures;   // 从停车场离开
+    unsigned long long laneDepartures;  // 从候车道离开
+    unsigned long long unknownDepartures;   // 离开的车辆不存在
+    unsigned long long admitted;        // 候车道车辆进入停车场
+    unsigned long long makeWayMoves;    // 让路车辆总数
+    int maxMakeWay;                     // 单次离开的最多让路车辆数
+    int laneLength;                     // 当前候车道长度
+    int peakLaneLength;                 // 候车道峰值长度
+    double revenue;                     // 收入
+    unsigned long long zeroWaits;       // 不用候车的车辆数
+    vector<uint32_t> waits;             // 候车车辆的候车时间（秒）
+    
+    SimulationStats() : traceEvents(0), scheduledEvents(0), parkedDirectly(0), diverted(0), rejected(0),
+                        lotDepartures(0), laneDepartures(0), unknownDepartures(0), admitted(0),
+                        makeWayMoves(0), maxMakeWay(0), laneLength(0), peakLaneLength(0),
+                        revenue(0), zeroWaits(0) {}
+};
+
+class TraceSimulation : public ParkingEventSink {
+private:
+    ParkingSystem system;
+    SimulationStats stats;
+    uint32_t now;                       // 当前事件时间
+    SimulationClock clock;              // 模拟时钟（随事件时间推进，在场车辆的时长和费用按它计算）
+    uint64_t nextSequence;              // 下一个到达序号
+    priority_queue<ScheduledDeparture, vector<ScheduledDeparture>, greater<ScheduledDeparture> > calendar;
+    unordered_map<uint32_t, ScheduledDeparture> dwellOfWaiting;    // 候车车辆（车辆ID） -> 进入停车场后安排的离开
+    unordered_map<string, uint64_t> scheduledPlates;               // 已安排离开的车牌 -> 到达序号
+    
+public:
+    explicit TraceSimulation(const SimulationOptions& options)
+        : system(options.capacity, options.hourlyRate, options.policy), now(0), nextSequence(0) {
+        if (options.spaces[0] >= 0) {
+            system.setParkingSpaces(options.spaces[0], options.spaces[1], options.spaces[2]);
+        }
+        system.setSpaceReserve(options.reserve[0], options.reserve[1], options.reserve[2]);
+        system.setEventSink(this);
+        system.setClock(&clock);
+    }
+    
+    // 运行模拟，轨迹读取出错时返回false
+    bool run(TraceReader& reader) {
+        TraceEvent event;
+        bool hasEvent = reader.next(event);
+        while (hasEvent || !calendar.empty()) {
+            // 同一时刻先处理离开，再处理轨迹中的事件
+            if (!calendar.empty() && (!hasEvent || calendar.top().time <= event.time)) {
+                ScheduledDeparture departure = calendar.top();
+                calendar.pop();
+                advanceTo(departure.time);
+                fireScheduled(departure);
+            } else {
+                advanceTo(event.time);
+                stats.traceEvents++;
+                if (event.op == TRACE_ARRIVAL) {
+                    arrive(event);
+                } else {
+                    scheduledPlates.erase(string(event.plate, event.plateLength));
+                    depart(event);
+                }
+                hasEvent = reader.next(event);
+            }
+        }
+        return reader.error().empty();
+    }
+    
+    SimulationStats& getStats() {
+        return stats;
+    }
+    
+    const ParkingSystem& getSystem() const {
+        return system;
+    }
+    
+    // 挂接运行指标
+    void setMetrics(ParkingMetrics* metrics) {
+        system.setMetrics(metrics);
+    }
+    
+    // 挂接操作阶段跟踪
+    void setTracer(ParkingTracer* tracer) {
+        system.setTracer(tracer);
+    }
+    
+    // 事件接收器：到达和离开的结果由调用处直接处理
+    void onArrival(const PlateView&, const ArrivalResult&) {}
+    void onDeparture(const PlateView&, const DepartureResult&) {}
+    
+    // 候车道车辆进入停车场：记录候车时间，带停车时长的车辆从现在开始计时安排离开
+    void onLaneAdmitted(const Car& car) {
+        stats.admitted++;
+        stats.laneLength--;
+        recordWait(now - static_cast<uint32_t>(car.getEntryTime()));
+        
+        unordered_map<uint32_t, ScheduledDeparture>::iterator it = dwellOfWaiting.find(car.getVehicleId());
+        if (it != dwellOfWaiting.end()) {
+            it->second.time = now + it->second.time;
+            schedule(it->second);
+            dwellOfWaiting.erase(it);
+        }
+    }
+    
+private:
+    // 推进到事件时间
+    void advanceTo(uint32_t time) {
+        now = time;
+        clock.set(static_cast<time_t>(time));
+    }
+    
+    // 处理到达事件
+    void arrive(const TraceEvent& event) {
+        ArrivalResult result = system.carArrival(string(event.plate, event.plateLength), event.carType, now);
+        if (!result.ok()) {
+            stats.rejected++;
+            return;
+        }
+        
+        ScheduledDeparture departure;
+        departure.sequence = nextSequence++;
+        departure.event = event;
+        departure.event.op = TRACE_DEPARTURE;
+        if (result.outcome == ARRIVAL_PARKED) {
+            stats.parkedDirectly++;
+            recordWait(0);
+            if (event.dwell > 0) {
+                departure.time = now + event.dwell;
+                schedule(departure);
+            }
+        } else {
+            stats.diverted++;
+            stats.laneLength++;
+            stats.peakLaneLength = max(stats.peakLaneLength, stats.laneLength);
+            if (event.dwell > 0) {
+                // 暂存停车时长，进入停车场时再换算成离开时间
+                departure.time = event.dwell;
+                dwellOfWaiting[result.vehicleId] = departure;
+            }
+        }
+    }
+    
+    // 处理离开事件
+    void depart(const TraceEvent& event) {
+        DepartureResult result = system.carDeparture(string(event.plate, event.plateLength), now);
+        switch (result.outcome) {
+            case DEPARTURE_FROM_LOT:
+                stats.lotDepartures++;
+                stats.revenue += result.fee;
+                stats.makeWayMoves += result.makeWayCount;
+                stats.maxMakeWay = max(stats.maxMakeWay, result.makeWayCount);
+                break;
+            case DEPARTURE_FROM_LANE:
+                stats.laneDepartures++;
+                stats.laneLength--;
+                dwellOfWaiting.erase(result.car.getVehicleId());
+                break;
+            default:
+                stats.unknownDepartures++;
+                break;
+        }
+    }
+    
+    // 安排离开事件
+    void schedule(const ScheduledDeparture& departure) {
+        scheduledPlates[string(departure.event.plate, departure.event.plateLength)] = departure.sequence;
+        calendar.push(departure);
+    }
+    
+    // 处理模拟器安排的离开（车辆已按轨迹提前离开或再次到达时作废）
+    void fireScheduled(const ScheduledDeparture& departure) {
+        unordered_map<string, uint64_t>::iterator it =
+            scheduledPlates.find(string(departure.event.plate, departure.event.plateLength));
+        if (it == scheduledPlates.end() || it->second != departure.sequence) {
+            return;
+        }
+        scheduledPlates.erase(it);
+        stats.scheduledEvents++;
+        depart(departure.event);
+    }
+    
+    // 记录一辆车的候车时间
+    void recordWait(uint32_t seconds) {
+        if (seconds == 0) {
+            stats.zeroWaits++;
+        } else {
+            stats.waits.push_back(seconds);
+        }
+    }
+};
+
+// 候车时间的百分位数（包括不用候车的车辆，waits会被部分排序）
+static double waitPercentile(SimulationStats& stats, double fraction) {
+    unsigned long long total = stats.zeroWaits + stats.waits.size();
+    if (total == 0) {
+        return 0;
+    }
+    unsigned long long rank = static_cast<unsigned long long>(fraction * (total - 1) + 0.5);
+    if (rank < stats.zeroWaits) {
+        return 0;
+    }
+    vector<uint32_t>::iterator nth = stats.waits.begin() + static_cast<long>(rank - stats.zeroWaits);
+    nth_element(stats.waits.begin(), nth, stats.waits.end());
+    return *nth;
+}
+
+// 输出模拟报告
+static void printReport(TraceSimulation& simulation, double seconds) {
+    SimulationStats& stats = simulation.getStats();
+    unsigned long long events = stats.traceEvents + stats.scheduledEvents;
+    unsigned long long parked = stats.zeroWaits + stats.waits.size();
+    double waitSum = 0;
+    uint32_t maxWait = 0;
+    for (size_t i = 0; i < stats.waits.size(); i++) {
+        waitSum += stats.waits[i];
+        maxWait = max(maxWait, stats.waits[i]);
+    }
+    
+    cout << fixed;
+    cout << "\n=== 模拟结果 ===" << endl;
+    cout << "处理事件：" << events << " 个（轨迹 " << stats.traceEvents
+         << "，模拟器安排的离开 " << stats.scheduledEvents << "），耗时 "
+         << setprecision(3) << seconds << " 秒，"
+         << setprecision(0) << (seconds > 0 ? events / seconds : 0.0) << " 个/秒" << endl;
+    cout << "到达：直接停入 " << stats.parkedDirectly << "，进入候车道 " << stats.diverted
+         << "，拒绝 " << stats.rejected << endl;
+    cout << "离开：停车场 " << stats.lotDepartures << "，候车道 " << stats.laneDepartures
+         << "，车辆不存在 " << stats.unknownDepartures << endl;
+    cout << "候车道：峰值长度 " << stats.peakLaneLength << "，结束时 " << stats.laneLength
+         << "，放行 " << stats.admitted << endl;
+    cout << "候车时间（秒，共 " << parked << " 辆进入停车场）：平均 "
+         << setprecision(1) << (parked > 0 ? waitSum / parked : 0.0)
+         << "，P50 " << setprecision(0) << waitPercentile(stats, 0.50)
+         << "，P90 " << waitPercentile(stats, 0.90)
+         << "，P99 " << waitPercentile(stats, 0.99)
+         << "，最长 " << maxWait << endl;
+    cout << "让路：共 " << stats.makeWayMoves << " 辆次，平均每次离开 "
+         << setprecision(2) << (stats.lotDepartures > 0 ? static_cast<double>(stats.makeWayMoves) / stats.lotDepartures : 0.0)
+         << "，最多 " << stats.maxMakeWay << endl;
+    cout << "收入：" << setprecision(2) << stats.revenue << " 元" << endl;
+    
+    const ParkingSystem& system = simulation.getSystem();
+    cout << "结束时停车场：" << system.getTotalCapacity() - system.getAvailableSpaces()
+         << "/" << system.getTotalCapacity() << "，在场车辆按最后的事件时间应收 "
+         << setprecision(2) << system.getAccruedFees() << " 元" << endl;
+}
+
+// 输出到达和离开的操作耗时（运行指标中的直方图）
+static void printLatencies(const ParkingMetrics& metrics) {
+    const char* names[] = { "到达", "离开" };
+    const MetricHistogram histograms[] = { METRIC_ARRIVAL_LATENCY, METRIC_DEPARTURE_LATENCY };
+    HistogramSnapshot histogram;
+    for (int i = 0; i < 2; i++) {
+        metrics.snapshot(histograms[i], histogram);
+        cout << names[i] << "耗时（纳秒，共 " << histogram.count << " 次）：平均 "
+             << setprecision(0) << histogram.mean()
+             << "，P50 " << histogram.percentile(50)
+             << "，P99 " << histogram.percentile(99)
+             << "，P99.9 " << histogram.percentile(99.9)
+             << "，最长 " << histogram.max() << endl;
+    }
+}
+
+// 输出用法
+static void printUsage(const char* program) {
+    cout << "用法：" << program << " 轨迹文件 [选项]" << endl;
+    cout << "  --capacity N           停车场容量（默认10）" << endl;
+    cout << "  --spaces S M L         小/中/大型车位数量（每种最多16777215个，默认按容量平均分配）" << endl;
+    cout << "  --rate R               每小时费率（默认5.0）" << endl;
+    cout << "  --policy P             车位分配策略：strict、best-fit、reserve（默认strict）" << endl;
+    cout << "  --reserve S M L        保留感知策略每种车位的保留量（默认0）" << endl;
+    cout << "  --metrics FILE         记录运行指标，结束时按Prometheus文本格式写入文件（-表示标准输出）" << endl;
+    cout << "  --chrome-trace FILE    记录到达/离开的各阶段，结束时按Chrome跟踪格式写入文件" << endl;
+    cout << "  --trace-capacity N     阶段跟踪保留最近的N个阶段（默认1048576）" << endl;
+}
+
+// 解析命令行参数
+static bool parseOptions(int argc, char* argv[], SimulationOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        int remaining = argc - i - 1;
+        if (arg == "--capacity" && remaining >= 1) {
+            options.capacity = atoi(argv[++i]);
+        } else if ((arg == "--spaces" || arg == "--reserve") && remaining >= 3) {
+            int* target = arg == "--spaces" ? options.spaces : options.reserve;
+            for (int t = 0; t < 3; t++) {
+                target[t] = atoi(argv[++i]);
+            }
+        } else if (arg == "--rate" && remaining >= 1) {
+            options.hourlyRate = atof(argv[++i]);
+        } else if (arg == "--policy" && remaining >= 1) {
+            string name = argv[++i];
+            if (name == "strict") {
+                options.policy = ALLOCATE_STRICT;
+            } else if (name == "best-fit") {
+                options.policy = ALLOCATE_BEST_FIT;
+            } else if (name == "reserve") {
+                options.policy = ALLOCATE_RESERVE_AWARE;
+            } else {
+                return false;
+            }
+        } else if (arg == "--metrics" && remaining >= 1) {
+            options.metricsFile = argv[++i];
+        } else if (arg == "--chrome-trace" && remaining >= 1) {
+            options.chromeTraceFile = argv[++i];
+        } else if (arg == "--trace-capacity" && remaining >= 1) {
+            options.traceCapacity = atoi(argv[++i]);
+        } else if (arg[0] != '-' && options.traceFile.empty()) {
+            options.traceFile = arg;
+        } else {
+            return false;
+        }
+    }
+    for (int t = 0; t < 3; t++) {
+        if (options.spaces[0] >= 0 && (options.spaces[t] < 0 || options.spaces[t] > MAX_SPACES_PER_TYPE)) {
+            return false;
+        }
+    }
+    return !options.traceFile.empty() && options.capacity > 0 && options.traceCapacity > 0;
+}
+
+int main(int argc, char* argv[]) {
+    SimulationOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    
+    TraceReader reader;
+    if (!reader.open(options.traceFile)) {
+        cerr << "错误：无法打开轨迹文件 " << options.traceFile << endl;
+        return 1;
+    }
+    
+    TraceSimulation simulation(options);
+    ParkingMetrics metrics;
+    if (!options.metricsFile.empty()) {
+        simulation.setMetrics(&metrics);
+    }
+    bool tracing = !options.chromeTraceFile.empty();
+    ParkingTracer tracer(tracing ? options.traceCapacity : 2);
+    if (tracing) {
+        simulation.setTracer(&tracer);
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool ok = simulation.run(reader);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    if (!ok) {
+        cerr << "错误：轨迹文件格式错误，" << reader.error() << endl;
+    }
+    printReport(simulation, seconds);
+    
+    if (tracing) {
+        if (!tracer.flushToFile(options.chromeTraceFile)) {
+            cerr << "错误：无法写入阶段跟踪文件 " << options.chromeTraceFile << endl;
+            return 1;
+        }
+        uint64_t kept = min<uint64_t>(tracer.count(), static_cast<uint64_t>(tracer.capacity()));
+        cout << "阶段跟踪：最近 " << kept << " 个阶段已写入 " << options.chromeTraceFile << endl;
+    }
+    
+    if (!options.metricsFile.empty()) {
+        printLatencies(metrics);
+        if (options.metricsFile == "-") {
+            cout << endl;
+            metrics.writePrometheus(cout);
+        } else if (!metrics.exportToFile(options.metricsFile)) {
+            cerr << "错误：无法写入运行指标文件 " << options.metricsFile << endl;
+            return 1;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+#include "SpaceBitmap.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+// 字中最低的0位的序号（调用方保证字不全为1）
+static inline int lowestZeroBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, ~word);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(~word);
+#endif
+}
+
+// 字中1的个数
+static inline int popcount(uint64_t word) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(word));
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+// 构造函数
+SpaceBitmap::SpaceBitmap(int count) : spaceCount(0) {
+    reset(count);
+}
+
+// 重新设置车位数量
+void SpaceBitmap::reset(int count) {
+    spaceCount = count > 0 ? count : 0;
+    words.assign((spaceCount + 63) / 64, Word());
+    firstFree.index.store(0);
+    
+    // 末尾多出的位置1，查找空位时跳过
+    int tail = spaceCount % 64;
+    if (tail != 0) {
+        words.back().bits.store(~0ULL << tail);
+    }
+}
+
+// 占用编号最小的空闲车位（从第一个可能有空位的字开始查找）
+int SpaceBitmap::acquireFirstFree() {
+    size_t start = firstFree.index.load();
+    for (size_t w = start; w < words.size(); w++) {
+        uint64_t current = words[w].bits.load();
+        // 比较并交换失败时current更新为最新值，该字仍有空位就在同一个字里重试
+        while (current != ~0ULL) {
+            int bit = lowestZeroBit(current);
+            uint64_t occupied = current | (1ULL << bit);
+            if (words[w].bits.compare_exchange_weak(current, occupied)) {
+                moveFirstFree(start, occupied == ~0ULL ? w + 1 : w);
+                return static_cast<int>(w) * 64 + bit;
+            }
+        }
+    }
+    moveFirstFree(start, words.size());
+    return -1;
+}
+
+// 查找时经过的字[start, target)都已占满，起点还是start时移到target
+// 移动之后再检查一遍这些字：其间有车位释放（释放方看到的起点还是start，没有移回）时把起点移回来
+void SpaceBitmap::moveFirstFree(size_t start, size_t target) {
+    size_t expected = start;
+    if (target == start || !firstFree.index.compare_exchange_strong(expected, target)) {
+        return;
+    }
+    for (size_t w = start; w < target; w++) {
+        if (words[w].bits.load() != ~0ULL) {
+            lowerFirstFree(w);
+            return;
+        }
+    }
+}
+
+// 第word个字有了空位，起点在它之后时移回这个字
+void SpaceBitmap::lowerFirstFree(size_t word) {
+    size_t current = firstFree.index.load();
+    while (word < current && !firstFree.index.compare_exchange_weak(current, word)) {
+    }
+}
+
+// 占用指定车位
+bool SpaceBitmap::acquire(int spaceId) {
+    if (spaceId < 0 || spaceId >= spaceCount) {
+        return false;
+    }
+    uint64_t mask = 1ULL << (spaceId % 64);
+    return (words[spaceId / 64].bits.fetch_or(mask) & mask) == 0;
+}
+
+// 释放车位
+void SpaceBitmap::release(int spaceId) {
+    if (spaceId >= 0 && spaceId < spaceCount) {
+        words[spaceId / 64].bits.fetch_and(~(1ULL << (spaceId % 64)));
+        lowerFirstFree(static_cast<size_t>(spaceId / 64));
+    }
+}
+
+// 判断车位是否已被占用
+bool SpaceBitmap::isOccupied(int spaceId) const {
+    if (spaceId < 0 || spaceId >= spaceCount) {
+        return false;
+    }
+    return (words[spaceId / 64].bits.load() >> (spaceId % 64)) & 1;
+}
+
+// 统计已占用的车位数
+int SpaceBitmap::countOccupied() const {
+    int count = 0;
+    for (size_t w = 0; w < words.size(); w++) {
+        count += popcount(words[w].bits.load());
+    }
+    // 减去末尾恒为1的多余位
+    int tail = spaceCount % 64;
+    return tail != 0 ? count - (64 - tail) : count;
+}
+
+// 获取车位数量
+int SpaceBitmap::size() const {
+    return spaceCount;
+}
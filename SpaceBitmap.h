@@ -0,0 +1,79 @@
+#ifndef SPACEBITMAP_H
+#define SPACEBITMAP_H
+
+#include <vector>
+#include <atomic>
+#include <stdint.h>
+#include <cstddef>
+
+// 车位占用位图（每个车位一位，1表示已占用，车位编号就是位的序号）
+// 按64位字查找第一个空位（对字取反后数末尾的0），统计用popcount；
+// 另记下第一个可能有空位的字，它之前的字都已占满，分配从这里开始查找，车位多、前面都已占满时不必从头扫描。
+// 占用和释放是对单个字的原子操作，多个大门线程可以同时分配，互不阻塞
+// （并发释放和分配时，分配到的可能不是当时编号最小的空位）。
+// 最后一个字中超出车位数量的位始终置1，查找时不会选中。
+// 复制时逐字复制当前值（与AtomicCounter一样，只在没有并发修改时复制）
+class SpaceBitmap {
+private:
+    // 可复制的原子字
+    struct Word {
+        std::atomic<uint64_t> bits;
+        
+        Word() : bits(0) {}
+        Word(const Word& other) : bits(other.bits.load()) {}
+        Word& operator=(const Word& other) {
+            bits.store(other.bits.load());
+            return *this;
+        }
+    };
+    
+    // 可复制的原子字序号
+    struct Cursor {
+        std::atomic<size_t> index;
+        
+        Cursor() : index(0) {}
+        Cursor(const Cursor& other) : index(other.index.load()) {}
+        Cursor& operator=(const Cursor& other) {
+            index.store(other.index.load());
+            return *this;
+        }
+    };
+    
+    std::vector<Word> words;    // 占用位
+    Cursor firstFree;           // 第一个可能有空位的字（之前的字都已占满）
+    int spaceCount;             // 车位数量
+    
+public:
+    // 构造函数（全部车位空闲）
+    explicit SpaceBitmap(int count = 0);
+    
+    // 重新设置车位数量（全部车位空闲）
+    void reset(int count);
+    
+    // 占用编号最小的空闲车位，返回车位编号；没有空闲车位时返回-1
+    int acquireFirstFree();
+    
+    // 占用指定车位，编号无效或已被占用时返回false
+    bool acquire(int spaceId);
+    
+    // 释放车位
+    void release(int spaceId);
+    
+    // 判断车位是否已被占用
+    bool isOccupied(int spaceId) const;
+    
+    // 统计已占用的车位数（逐字popcount）
+    int countOccupied() const;
+    
+    // 获取车位数量
+    int size() const;
+    
+private:
+    // 查找时经过的字[start, target)都已占满：起点还是start时移到target
+    void moveFirstFree(size_t start, size_t target);
+    
+    // 第word个字有了空位：起点在它之后时移回这个字
+    void lowerFirstFree(size_t word);
+};
+
+#endif // SPACEBITMAP_H
@@ -1,124 +1,184 @@
 #include "Stack.h"
+#include "TimestampFormat.h"
 #include <iostream>
 #include <iomanip>
 
 using namespace std;
 
-// 캯
-Stack::Stack() : top(-1) {}
+// 构造函数
+Stack::Stack(int capacity) : maxSize(capacity > 0 ? capacity : 0) {
+    data.reserve(maxSize);
+}
+
+// 获取栈的最大容量
+int Stack::capacity() const {
+    return maxSize;
+}
+
+// 修改栈的最大容量
+bool Stack::setCapacity(int capacity) {
+    if (capacity < size()) {
+        return false;
+    }
+    maxSize = capacity;
+    data.reserve(maxSize);
+    return true;
+}
 
-// жջǷΪ
+// 用连续的车辆记录整体替换栈中内容
+bool Stack::assign(const Car* cars, int count) {
+    if (count < 0 || count > maxSize) {
+        return false;
+    }
+    // 车辆记录可平凡复制，整块复制即可
+    data.assign(cars, cars + count);
+    return true;
+}
+
+// 判断栈是否为空
 bool Stack::isEmpty() const {
-    return top == -1;
+    return data.empty();
 }
 
-// жջǷ
+// 判断栈是否已满
 bool Stack::isFull() const {
-    return top == MAX_SIZE - 1;
+    return size() >= maxSize;
 }
 
-// ȡջԪ
+// 获取栈中元素数量
 int Stack::size() const {
-    return top + 1;
+    return static_cast<int>(data.size());
 }
 
-// ջ
+// 入栈操作
 bool Stack::push(const Car& car) {
     if (isFull()) {
         return false;
     }
-    data[++top] = car;
+    data.push_back(car);
     return true;
 }
 
-// ջ
+// 出栈操作
 bool Stack::pop() {
     if (isEmpty()) {
         return false;
     }
-    top--;
+    data.pop_back();
     return true;
 }
 
-// ȡջԪ
+// 获取栈顶元素
 Car Stack::peek() const {
     if (isEmpty()) {
-        // һĬϵCar
+        // 返回一个默认的Car对象
         return Car();
     }
-    return data[top];
+    return data.back();
 }
 
-// ҳͨƺţ
+// 查找车辆（通过车牌号）
 int Stack::findCar(const string& licensePlate) const {
+    PlateView target(licensePlate);
+    int top = size() - 1;
+    for (int i = top; i >= 0; i--) {
+        if (data[i].plate() == target) {
+            // 返回位置（从栈顶开始计数，1表示栈顶）
+            return top - i + 1;
+        }
+    }
+    return 0; // 未找到
+}
+
+// 查找车辆（通过车辆ID）
+int Stack::findCarById(uint32_t vehicleId) const {
+    int top = size() - 1;
     for (int i = top; i >= 0; i--) {
-        if (data[i].getLicensePlate() == licensePlate) {
-            // λãջʼ1ʾջ
+        if (data[i].getVehicleId() == vehicleId) {
             return top - i + 1;
         }
     }
-    return 0; // δҵ
+    return 0; // 未找到
 }
 
-// ȡָλõĳջʼ1ʾջ
+// 获取指定位置的车辆（从栈顶开始计数，1表示栈顶）
 Car Stack::getCarAt(int position) const {
     if (position < 1 || position > size()) {
-        // λЧĬCar
+        // 位置无效，返回默认Car对象
         return Car();
     }
-    // ջdata[top]λ1Ӧdata[top]
-    int index = top - position + 1;
+    // 计算数组索引：栈顶是data.back()，位置1对应data.back()
+    int index = size() - position;
+    return data[index];
+}
+
+// 按数组下标获取车辆引用（0表示栈底）
+const Car& Stack::at(int index) const {
     return data[index];
 }
 
-// Ƴָλõĳջʼ1ʾջ
+// 移除指定位置的车辆（从栈顶开始计数，1表示栈顶）
 bool Stack::removeCarAt(int position) {
     if (position < 1 || position > size()) {
         return false;
     }
     
-    // ҪƳĳ
-    int removeIndex = top - position + 1;
-    
-    // ĳǰƶ
-    for (int i = removeIndex; i < top; i++) {
-        data[i] = data[i + 1];
-    }
+    // 计算要移除的车辆的数组索引
+    int removeIndex = size() - position;
     
-    top--;
+    // 将后面的车辆整体向前移动（车辆记录可平凡复制，相当于一次memmove）
+    data.erase(data.begin() + removeIndex);
     return true;
 }
 
-// ʾջгϢ
+// 遍历栈中车辆
+Stack::const_iterator Stack::begin() const {
+    return data.begin();
+}
+
+Stack::const_iterator Stack::end() const {
+    return data.end();
+}
+
+Stack::const_reverse_iterator Stack::rbegin() const {
+    return data.rbegin();
+}
+
+Stack::const_reverse_iterator Stack::rend() const {
+    return data.rend();
+}
+
+// 显示栈中所有车辆信息
 void Stack::display() const {
     if (isEmpty()) {
-        cout << "ͣΪ" << endl;
+        cout << "停车场为空" << endl;
         return;
     }
     
-    cout << "ͣ״̬ջǰ棩" << endl;
+    cout << "停车场状态（栈顶在最前面）：" << endl;
     cout << "==========================================" << endl;
-    cout << left << setw(15) << "λ" 
-         << setw(15) << "ƺ" 
-         << setw(15) << "" 
-         << setw(15) << "λ" 
-         << setw(20) << "ʱ" << endl;
+    cout << left << setw(15) << "位置" 
+         << setw(15) << "车牌号" 
+         << setw(15) << "车型" 
+         << setw(15) << "车位类型" 
+         << setw(10) << "车位编号" 
+         << setw(20) << "进入时间" << endl;
     cout << "------------------------------------------" << endl;
     
+    int top = size() - 1;
     for (int i = top; i >= 0; i--) {
         int position = top - i + 1;
-        Car car = data[i];
+        const Car& car = data[i];
         
-        // תʱΪַ
-        char entryTimeStr[20];
-        time_t entryTime = car.getEntryTime();
-        struct tm* timeinfo = localtime(&entryTime);
-        strftime(entryTimeStr, sizeof(entryTimeStr), "%Y-%m-%d %H:%M:%S", timeinfo);
+        // 转换时间为字符串
+        char entryTimeStr[TIMESTAMP_BUFFER_SIZE];
+        formatTimestamp(car.getEntryTime(), entryTimeStr);
         
         cout << left << setw(15) << position
-             << setw(15) << car.getLicensePlate()
+             << setw(15) << car.plate()
              << setw(15) << car.getTypeString()
              << setw(15) << car.getSpaceTypeString()
+             << setw(10) << car.getSpaceId()
              << setw(20) << entryTimeStr << endl;
     }
     cout << "==========================================" << endl;
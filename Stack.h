@@ -2,47 +2,77 @@
 #define STACK_H
 
 #include "Car.h"
+#include <vector>
 
 class Stack {
 private:
-    static const int MAX_SIZE = 100;  // ջ
-    Car data[MAX_SIZE];               // 洢
-    int top;                          // ջָ
+    std::vector<Car> data;            // 存储车辆的数组（构造时一次性预留容量）
+    int maxSize;                      // 栈的最大容量
     
 public:
-    // 캯
-    Stack();
+    static const int DEFAULT_CAPACITY = 100;  // 默认容量
     
-    // жջǷΪ
+    // 只读迭代器：正向从栈底（最北端）到栈顶（大门），反向从大门一侧开始
+    typedef std::vector<Car>::const_iterator const_iterator;
+    typedef std::vector<Car>::const_reverse_iterator const_reverse_iterator;
+    
+    // 构造函数
+    // 只预留存储空间，不逐个构造车辆对象
+    explicit Stack(int capacity = DEFAULT_CAPACITY);
+    
+    // 用连续的车辆记录整体替换栈中内容（cars[0]为栈底）
+    // 数量超过容量时返回false，栈保持不变
+    bool assign(const Car* cars, int count);
+    
+    // 获取栈的最大容量
+    int capacity() const;
+    
+    // 修改栈的最大容量（不能小于当前车辆数量）
+    bool setCapacity(int capacity);
+    
+    // 判断栈是否为空
     bool isEmpty() const;
     
-    // жջǷ
+    // 判断栈是否已满
     bool isFull() const;
     
-    // ȡջԪ
+    // 获取栈中元素数量
     int size() const;
     
-    // ջ
+    // 入栈操作
     bool push(const Car& car);
     
-    // ջ
+    // 出栈操作
     bool pop();
     
-    // ȡջԪ
+    // 获取栈顶元素
     Car peek() const;
     
-    // ҳͨƺţ
-    // سջеλãջʼ1ʾջ
+    // 查找车辆（通过车牌号）
+    // 返回车辆在栈中的位置（从栈顶开始计数，1表示栈顶）
     int findCar(const std::string& licensePlate) const;
     
-    // ȡָλõĳջʼ1ʾջ
+    // 查找车辆（通过车辆ID，整数比较）
+    // 返回值含义同findCar
+    int findCarById(uint32_t vehicleId) const;
+    
+    // 获取指定位置的车辆（从栈顶开始计数，1表示栈顶）
     Car getCarAt(int position) const;
     
-    // Ƴָλõĳջʼ1ʾջ
-    // ڳ뿪ʱĲ
+    // 按数组下标获取车辆引用（0表示栈底，不复制）
+    const Car& at(int index) const;
+    
+    // 移除指定位置的车辆（从栈顶开始计数，1表示栈顶）
+    // 用于车辆离开时的操作
     bool removeCarAt(int position);
     
-    // ʾջгϢ
+    // 遍历栈中车辆（不复制、不修改）
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+    
+    // 显示栈中所有车辆信息
     void display() const;
 };
 
@@ -0,0 +1,74 @@
+#include "ThreadPool.h"
+
+using namespace std;
+
+// 构造函数
+ThreadPool::ThreadPool(int threads) : running(0), stopping(false) {
+    if (threads < 1) {
+        threads = 1;
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+// 析构函数
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+// 提交任务
+void ThreadPool::submit(const function<void()>& task) {
+    {
+        lock_guard<mutex> guard(lock);
+        tasks.push_back(task);
+    }
+    taskReady.notify_one();
+}
+
+// 等待已提交的任务全部完成
+void ThreadPool::wait() {
+    unique_lock<mutex> guard(lock);
+    while (!tasks.empty() || running > 0) {
+        allDone.wait(guard);
+    }
+}
+
+// 获取工作线程数
+int ThreadPool::size() const {
+    return static_cast<int>(workers.size());
+}
+
+// 工作线程：循环取出并执行任务
+void ThreadPool::workerLoop() {
+    unique_lock<mutex> guard(lock);
+    for (;;) {
+        while (tasks.empty() && !stopping) {
+            taskReady.wait(guard);
+        }
+        if (tasks.empty()) {
+            return;     // 正在关闭且没有剩余任务
+        }
+        
+        function<void()> task = tasks.front();
+        tasks.pop_front();
+        running++;
+        
+        // 执行任务时不持有锁
+        guard.unlock();
+        task();
+        guard.lock();
+        
+        running--;
+        if (tasks.empty() && running == 0) {
+            allDone.notify_all();
+        }
+    }
+}
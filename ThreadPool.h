@@ -0,0 +1,49 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// 固定大小的线程池
+// 任务按提交次序取出执行；wait等待已提交的任务全部完成，之后可以继续提交。
+// 任务之间没有次序保证，需要先后执行的操作应放在同一个任务中。
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;           // 工作线程
+    std::deque<std::function<void()> > tasks;   // 待执行的任务
+    std::mutex lock;                            // 保护任务队列和计数
+    std::condition_variable taskReady;          // 有新任务或线程池关闭
+    std::condition_variable allDone;            // 全部任务已完成
+    int running;                                // 正在执行的任务数
+    bool stopping;                              // 线程池正在关闭
+    
+public:
+    // 构造函数（threads小于1时按1个线程创建）
+    explicit ThreadPool(int threads);
+    
+    // 析构函数（执行完已提交的任务后结束工作线程）
+    ~ThreadPool();
+    
+    // 提交任务
+    void submit(const std::function<void()>& task);
+    
+    // 等待已提交的任务全部完成
+    void wait();
+    
+    // 获取工作线程数
+    int size() const;
+    
+private:
+    // 工作线程：循环取出并执行任务
+    void workerLoop();
+    
+    // 线程池不可复制
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+#endif // THREADPOOL_H
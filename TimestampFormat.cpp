@@ -0,0 +1,136 @@
+#include "TimestampFormat.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+// 每个线程缓存的日期数（按UTC日序号直接映射，必须是2的幂）
+static const int DAY_SLOTS = 16;
+static const long long SECONDS_PER_DAY = 86400;
+
+// 缓存的一个本地日期：[begin, end)内的时间都在这一天，且UTC偏移不变
+struct CachedDay {
+    long long begin;            // 当天0点（time_t）
+    long long end;              // 次日0点
+    unsigned generation;        // 填入时的缓存代数（与当前代数不同时作废）
+    char prefix[12];            // "YYYY-MM-DD "
+};
+
+// 缓存代数（resetTimestampCache时加一；从1开始，线程的缓存初始为0，即全部无效）
+static atomic<unsigned> cacheGeneration(1);
+
+// 取得调用线程的缓存
+static CachedDay* localDays() {
+    static thread_local CachedDay days[DAY_SLOTS];
+    return days;
+}
+
+// 可重入地把time换算为本地时间
+static bool toLocalTime(time_t time, struct tm& result) {
+#ifdef _WIN32
+    return localtime_s(&result, &time) == 0;
+#else
+    return localtime_r(&time, &result) != nullptr;
+#endif
+}
+
+// 写入两位十进制数
+static inline void writeTwoDigits(char* out, int value) {
+    out[0] = static_cast<char>('0' + value / 10);
+    out[1] = static_cast<char>('0' + value % 10);
+}
+
+// 按当天的秒数写入"HH:MM:SS"
+static inline void writeClock(char* out, int secondOfDay) {
+    writeTwoDigits(out, secondOfDay / 3600);
+    out[2] = ':';
+    writeTwoDigits(out + 3, secondOfDay / 60 % 60);
+    out[5] = ':';
+    writeTwoDigits(out + 6, secondOfDay % 60);
+}
+
+// 写入"YYYY-MM-DD "，年份不是4位数时返回false（不缓存）
+static bool writeDatePrefix(char* out, const struct tm& local) {
+    int year = local.tm_year + 1900;
+    if (year < 0 || year > 9999) {
+        return false;
+    }
+    writeTwoDigits(out, year / 100);
+    writeTwoDigits(out + 2, year % 100);
+    out[4] = '-';
+    writeTwoDigits(out + 5, local.tm_mon + 1);
+    out[7] = '-';
+    writeTwoDigits(out + 8, local.tm_mday);
+    out[10] = ' ';
+    return true;
+}
+
+// 判断本地时间是否为指定日期的指定时刻
+static bool isLocalTime(long long time, const struct tm& day, int hour, int minute, int second) {
+    struct tm local;
+    return toLocalTime(static_cast<time_t>(time), local) &&
+           local.tm_year == day.tm_year && local.tm_mon == day.tm_mon && local.tm_mday == day.tm_mday &&
+           local.tm_hour == hour && local.tm_min == minute && local.tm_sec == second;
+}
+
+// 格式化时间戳
+int formatTimestamp(time_t time, char* buffer) {
+    long long t = static_cast<long long>(time);
+    long long utcDay = t >= 0 ? t / SECONDS_PER_DAY : (t - SECONDS_PER_DAY + 1) / SECONDS_PER_DAY;
+    CachedDay& day = localDays()[utcDay & (DAY_SLOTS - 1)];
+    unsigned generation = cacheGeneration.load(memory_order_relaxed);
+    
+    if (day.generation != generation || t < day.begin || t >= day.end) {
+        // 未命中：读取一次本地时间，算出当天0点和次日0点
+        struct tm local;
+        if (!toLocalTime(time, local)) {
+            memcpy(buffer, "0000-00-00 00:00:00", TIMESTAMP_BUFFER_SIZE);
+            return TIMESTAMP_LENGTH;
+        }
+        int secondOfDay = local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+        if (!writeDatePrefix(buffer, local)) {
+            // 年份超过4位：按通用格式输出，超出缓冲区的部分截掉
+            char text[64];
+            snprintf(text, sizeof(text), "%04d-%02d-%02d %02d:%02d:%02d",
+                     local.tm_year + 1900, local.tm_mon + 1, local.tm_mday,
+                     local.tm_hour, local.tm_min, local.tm_sec);
+            text[TIMESTAMP_LENGTH] = '\0';
+            int length = static_cast<int>(strlen(text));
+            memcpy(buffer, text, length + 1);
+            return length;
+        }
+        writeClock(buffer + 11, secondOfDay);
+        buffer[TIMESTAMP_LENGTH] = '\0';
+        
+        // 当天0点和23:59:59都与按固定偏移推算的一致时才缓存（夏令时切换的那天不缓存）
+        long long begin = t - secondOfDay;
+        long long end = begin + SECONDS_PER_DAY;
+        if (secondOfDay < SECONDS_PER_DAY &&
+            isLocalTime(begin, local, 0, 0, 0) && isLocalTime(end - 1, local, 23, 59, 59)) {
+            day.begin = begin;
+            day.end = end;
+            day.generation = generation;
+            memcpy(day.prefix, buffer, 11);
+        }
+        return TIMESTAMP_LENGTH;
+    }
+    
+    // 命中：复制日期前缀，时分秒由当天的秒数算出
+    memcpy(buffer, day.prefix, 11);
+    writeClock(buffer + 11, static_cast<int>(t - day.begin));
+    buffer[TIMESTAMP_LENGTH] = '\0';
+    return TIMESTAMP_LENGTH;
+}
+
+// 把时间格式化为字符串
+string timestampToString(time_t time) {
+    char buffer[TIMESTAMP_BUFFER_SIZE];
+    int length = formatTimestamp(time, buffer);
+    return string(buffer, length);
+}
+
+// 使各线程的缓存失效
+void resetTimestampCache() {
+    cacheGeneration.fetch_add(1, memory_order_relaxed);
+}
@@ -0,0 +1,27 @@
+#ifndef TIMESTAMPFORMAT_H
+#define TIMESTAMPFORMAT_H
+
+#include <ctime>
+#include <string>
+
+// 时间戳格式化："YYYY-MM-DD HH:MM:SS"（本地时间，与strftime的"%Y-%m-%d %H:%M:%S"相同）
+// 每个线程缓存最近用到的若干个本地日期：日期前缀"YYYY-MM-DD "和当天0点对应的time_t（即当天的UTC偏移），
+// 同一天的时间戳只用整数运算算出时分秒，写入调用方的缓冲区，不调用localtime和strftime，也不分配内存。
+// 缓存未命中时用可重入的localtime_r（Windows上为localtime_s）读取一次；缓存是线程自己的，多个线程可以同时调用。
+// 当天有夏令时切换（UTC偏移在一天之内变化）时不缓存，每次都按本地时间换算。
+
+// 时间戳的长度和缓冲区的最小字节数（含结尾的'\0'）
+const int TIMESTAMP_LENGTH = 19;
+const int TIMESTAMP_BUFFER_SIZE = TIMESTAMP_LENGTH + 1;
+
+// 把time格式化写入buffer（至少TIMESTAMP_BUFFER_SIZE字节，以'\0'结尾），返回写入的字符数
+// 超出本地时间可表示的范围时写入"0000-00-00 00:00:00"
+int formatTimestamp(time_t time, char* buffer);
+
+// 把time格式化为字符串
+std::string timestampToString(time_t time);
+
+// 使各线程的缓存失效（运行中修改了时区（设置TZ后调用tzset）时调用，各线程下一次格式化时重新读取）
+void resetTimestampCache();
+
+#endif // TIMESTAMPFORMAT_H
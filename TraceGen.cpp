@@ -0,0 +1,133 @@
+#include "WorkloadGenerator.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+
+// 合成车流生成工具（parking_tracegen）
+// 按给定的到达过程、车型比例和停车时长分布生成到达事件，写成二进制（默认）或文本轨迹，供parking_sim读取。
+// 相同的种子和参数总是生成相同的轨迹。
+
+// 输出用法
+static void printUsage(const char* program) {
+    cout << "用法：" << program << " 输出文件 [选项]" << endl;
+    cout << "  --events N             生成的到达数（默认100000）" << endl;
+    cout << "  --seed S               随机数种子（默认1）" << endl;
+    cout << "  --process P            到达过程：poisson、rush-hour、event-day（默认poisson）" << endl;
+    cout << "  --gap G                平峰的平均到达间隔，秒（默认240）" << endl;
+    cout << "  --peak F               高峰到达率倍数（默认3）" << endl;
+    cout << "  --surge F              活动时段到达率倍数（默认6）" << endl;
+    cout << "  --surge-every D        每隔多少天一次活动日（默认7）" << endl;
+    cout << "  --mix S M L            小/中/大型车比例，百分比（默认34 33 33）" << endl;
+    cout << "  --dwell D              停车时长分布：exponential、lognormal、fixed（默认exponential）" << endl;
+    cout << "  --mean-dwell T         平均停车时长，秒（默认6600）" << endl;
+    cout << "  --spread S             对数正态分布的形状参数（默认1.0）" << endl;
+    cout << "  --min-dwell T          最短停车时长，秒（默认60）" << endl;
+    cout << "  --text                 写成文本轨迹（默认二进制）" << endl;
+}
+
+// 解析命令行参数
+static bool parseOptions(int argc, char* argv[], WorkloadConfig& config, string& output, bool& text) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--events" && hasValue) {
+            config.arrivals = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && hasValue) {
+            config.seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--process" && hasValue) {
+            string name = argv[++i];
+            if (name == "poisson") {
+                config.process = PROCESS_POISSON;
+            } else if (name == "rush-hour") {
+                config.process = PROCESS_RUSH_HOUR;
+            } else if (name == "event-day") {
+                config.process = PROCESS_EVENT_DAY;
+            } else {
+                return false;
+            }
+        } else if (arg == "--gap" && hasValue) {
+            config.meanGap = atof(argv[++i]);
+        } else if (arg == "--peak" && hasValue) {
+            config.peakFactor = atof(argv[++i]);
+        } else if (arg == "--surge" && hasValue) {
+            config.surgeFactor = atof(argv[++i]);
+        } else if (arg == "--surge-every" && hasValue) {
+            config.surgeEvery = atoi(argv[++i]);
+        } else if (arg == "--mix" && i + 3 < argc) {
+            for (int t = 0; t < 3; t++) {
+                config.mix[t] = atoi(argv[++i]);
+            }
+        } else if (arg == "--dwell" && hasValue) {
+            string name = argv[++i];
+            if (name == "exponential") {
+                config.dwell = DWELL_EXPONENTIAL;
+            } else if (name == "lognormal") {
+                config.dwell = DWELL_LOGNORMAL;
+            } else if (name == "fixed") {
+                config.dwell = DWELL_FIXED;
+            } else {
+                return false;
+            }
+        } else if (arg == "--mean-dwell" && hasValue) {
+            config.meanDwell = atof(argv[++i]);
+        } else if (arg == "--spread" && hasValue) {
+            config.dwellSpread = atof(argv[++i]);
+        } else if (arg == "--min-dwell" && hasValue) {
+            config.minDwell = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--text") {
+            text = true;
+        } else if (arg[0] != '-' && output.empty()) {
+            output = arg;
+        } else {
+            return false;
+        }
+    }
+    return !output.empty() && config.meanGap > 0 && config.meanDwell > 0 &&
+           config.mix[0] >= 0 && config.mix[1] >= 0 && config.mix[2] >= 0 &&
+           config.mix[0] + config.mix[1] + config.mix[2] == 100;
+}
+
+int main(int argc, char* argv[]) {
+    WorkloadConfig config;
+    string output;
+    bool text = false;
+    if (!parseOptions(argc, argv, config, output, text)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    
+    TraceWriter writer;
+    if (!writer.open(output, !text, config.seed)) {
+        cerr << "错误：无法创建轨迹文件 " << output << endl;
+        return 1;
+    }
+    
+    WorkloadGenerator generator(config);
+    TraceEvent event;
+    unsigned long long types[3] = { 0, 0, 0 };
+    double dwellSum = 0;
+    uint32_t lastTime = 0;
+    while (generator.next(event)) {
+        if (!writer.write(event)) {
+            break;
+        }
+        types[event.carType]++;
+        dwellSum += event.dwell;
+        lastTime = event.time;
+    }
+    if (!writer.close()) {
+        cerr << "错误：写入轨迹文件失败 " << output << endl;
+        return 1;
+    }
+    
+    unsigned long long count = writer.count();
+    cout << "已生成 " << count << " 个到达事件（" << (text ? "文本" : "二进制") << "）：" << output << endl;
+    cout << fixed << setprecision(1);
+    cout << "时间跨度：" << lastTime / 86400.0 << " 天" << endl;
+    cout << "车型：小型 " << types[0] << "，中型 " << types[1] << "，大型 " << types[2] << endl;
+    cout << "平均停车时长：" << (count > 0 ? dwellSum / count / 60 : 0.0) << " 分钟" << endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "WaitingLane.h"
+#include "TimestampFormat.h"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+const int WaitingLane::LANE_COUNT;
+
+// 迭代器：从各子队列的队头（或末尾）开始
+WaitingLane::const_iterator::const_iterator(const WaitingLane* owner, bool atEnd)
+    : lane(owner), current(-1) {
+    for (int i = 0; i < LANE_COUNT; i++) {
+        cur[i] = atEnd ? owner->lanes[i].end() : owner->lanes[i].begin();
+    }
+    settle();
+}
+
+// 选出当前到达序号最小的子队列
+void WaitingLane::const_iterator::settle() {
+    current = -1;
+    uint64_t best = 0;
+    for (int i = 0; i < LANE_COUNT; i++) {
+        if (cur[i] == lane->lanes[i].end()) {
+            continue;
+        }
+        uint64_t seq = lane->sequenceOf(i, cur[i].index());
+        if (current == -1 || seq < best) {
+            current = i;
+            best = seq;
+        }
+    }
+}
+
+WaitingLane::const_iterator& WaitingLane::const_iterator::operator++() {
+    ++cur[current];
+    settle();
+    return *this;
+}
+
+bool WaitingLane::const_iterator::operator==(const const_iterator& other) const {
+    for (int i = 0; i < LANE_COUNT; i++) {
+        if (cur[i] != other.cur[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 构造函数
+WaitingLane::WaitingLane() : nextSeq(0) {}
+
+// 判断候车道是否为空
+bool WaitingLane::isEmpty() const {
+    return size() == 0;
+}
+
+// 获取候车道中车辆总数
+int WaitingLane::size() const {
+    int total = 0;
+    for (int i = 0; i < LANE_COUNT; i++) {
+        total += lanes[i].size();
+    }
+    return total;
+}
+
+// 车辆进入其车型对应的子队列
+int WaitingLane::enqueue(const Car& car) {
+    int lane = car.getType();
+    int node = lanes[lane].enqueue(car);
+    
+    // 节点下标由子队列的节点池分配，序号数组随节点池一起增长
+    if (node >= static_cast<int>(seqs[lane].size())) {
+        seqs[lane].resize(node + 1);
+    }
+    seqs[lane][node] = nextSeq++;
+    return node;
+}
+
+// 移除指定子队列、指定节点上的车辆
+bool WaitingLane::remove(int lane, int node) {
+    if (lane < 0 || lane >= LANE_COUNT) {
+        return false;
+    }
+    return lanes[lane].removeNode(node);
+}
+
+// 指定子队列队头车辆出队
+bool WaitingLane::dequeue(int lane) {
+    if (lane < 0 || lane >= LANE_COUNT) {
+        return false;
+    }
+    return lanes[lane].dequeue();
+}
+
+// 在可选的子队列中选出队头到达序号最小的子队列
+int WaitingLane::pickEarliest(const bool eligible[LANE_COUNT]) const {
+    int best = -1;
+    uint64_t bestSeq = 0;
+    for (int i = 0; i < LANE_COUNT; i++) {
+        if (!eligible[i] || lanes[i].isEmpty()) {
+            continue;
+        }
+        uint64_t seq = seqs[i][lanes[i].getFrontNode()];
+        if (best == -1 || seq < bestSeq) {
+            best = i;
+            bestSeq = seq;
+        }
+    }
+    return best;
+}
+
+// 获取指定子队列的队头车辆
+const Car& WaitingLane::front(int lane) const {
+    return lanes[lane].getNode(lanes[lane].getFrontNode()).car;
+}
+
+// 获取指定子队列
+const Queue& WaitingLane::getLane(int lane) const {
+    return lanes[lane];
+}
+
+// 获取指定子队列节点上车辆的到达序号
+uint64_t WaitingLane::sequenceOf(int lane, int node) const {
+    return seqs[lane][node];
+}
+
+// 按到达次序遍历候车道中的车辆
+WaitingLane::const_iterator WaitingLane::begin() const {
+    return const_iterator(this, false);
+}
+
+WaitingLane::const_iterator WaitingLane::end() const {
+    return const_iterator(this, true);
+}
+
+// 显示候车道中所有车辆信息
+void WaitingLane::display() const {
+    if (isEmpty()) {
+        cout << "候车道为空" << endl;
+        return;
+    }
+    
+    cout << "候车道状态（按到达次序，最早到达的在最前面）：" << endl;
+    cout << "==========================================" << endl;
+    cout << left << setw(15) << "位置"
+         << setw(15) << "车牌号"
+         << setw(15) << "车型"
+         << setw(20) << "进入时间" << endl;
+    cout << "------------------------------------------" << endl;
+    
+    int position = 1;
+    for (const_iterator it = begin(); it != end(); ++it) {
+        // 转换时间为字符串
+        char entryTimeStr[TIMESTAMP_BUFFER_SIZE];
+        formatTimestamp(it->getEntryTime(), entryTimeStr);
+        
+        cout << left << setw(15) << position
+             << setw(15) << it->plate()
+             << setw(15) << it->getTypeString()
+             << setw(20) << entryTimeStr << endl;
+        
+        position++;
+    }
+    cout << "==========================================" << endl;
+    cout << "各车型排队数量：小型车 " << lanes[SMALL].size()
+         << "，中型车 " << lanes[MEDIUM].size()
+         << "，大型车 " << lanes[LARGE].size() << endl;
+}
+
+// 清空候车道
+void WaitingLane::clear() {
+    for (int i = 0; i < LANE_COUNT; i++) {
+        lanes[i].clear();
+        seqs[i].clear();
+    }
+    nextSeq = 0;
+}
@@ -0,0 +1,105 @@
+#ifndef WAITINGLANE_H
+#define WAITINGLANE_H
+
+#include "Queue.h"
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+// 候车道调度器
+// 每种车型一条子队列，车辆入队时取得一个全局递增的到达序号。
+// 停车场出现空位时，在"有合适车位"的子队列队头中选到达序号最小的车辆放行，
+// 直到没有可以停入的车辆为止：队头的大型车在等大型车位时，后面的小型车不再被它挡住；
+// 可以停入的车辆之间仍按到达次序放行，同一车型内严格先来先走。
+class WaitingLane {
+public:
+    static const int LANE_COUNT = 3;    // 子队列数量（每种车型一条）
+    
+private:
+    Queue lanes[LANE_COUNT];                    // 各车型的子队列
+    std::vector<uint64_t> seqs[LANE_COUNT];     // 子队列节点下标 -> 到达序号
+    uint64_t nextSeq;                           // 下一辆车的到达序号
+    
+public:
+    // 只读迭代器，按到达次序合并遍历各子队列（不复制、不修改）
+    class const_iterator {
+    private:
+        const WaitingLane* lane;                    // 所属候车道
+        Queue::const_iterator cur[LANE_COUNT];      // 各子队列的当前位置
+        int current;                                // 当前车辆所在子队列（-1表示末尾）
+        
+        // 选出当前到达序号最小的子队列
+        void settle();
+    
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Car value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Car* pointer;
+        typedef const Car& reference;
+        
+        const_iterator() : lane(nullptr), current(-1) {}
+        const_iterator(const WaitingLane* owner, bool atEnd);
+        
+        reference operator*() const { return *cur[current]; }
+        pointer operator->() const { return &*cur[current]; }
+        
+        // 当前车辆所在子队列和节点下标
+        int laneIndex() const { return current; }
+        int index() const { return cur[current].index(); }
+        
+        const_iterator& operator++();
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+    
+    // 构造函数
+    WaitingLane();
+    
+    // 判断候车道是否为空
+    bool isEmpty() const;
+    
+    // 获取候车道中车辆总数
+    int size() const;
+    
+    // 车辆进入其车型对应的子队列
+    // 返回车辆所在节点的下标（子队列即车型）
+    int enqueue(const Car& car);
+    
+    // 移除指定子队列、指定节点上的车辆（O(1)）
+    bool remove(int lane, int node);
+    
+    // 指定子队列队头车辆出队
+    bool dequeue(int lane);
+    
+    // 在eligible为true的子队列中，选出队头到达序号最小的子队列
+    // 没有可选的子队列时返回-1
+    int pickEarliest(const bool eligible[LANE_COUNT]) const;
+    
+    // 获取指定子队列的队头车辆（子队列不能为空）
+    const Car& front(int lane) const;
+    
+    // 获取指定子队列
+    const Queue& getLane(int lane) const;
+    
+    // 获取指定子队列节点上车辆的到达序号
+    uint64_t sequenceOf(int lane, int node) const;
+    
+    // 按到达次序遍历候车道中的车辆
+    const_iterator begin() const;
+    const_iterator end() const;
+    
+    // 显示候车道中所有车辆信息（按到达次序）
+    void display() const;
+    
+    // 清空候车道
+    void clear();
+};
+
+#endif // WAITINGLANE_H
@@ -0,0 +1,131 @@
+#include "WorkloadGenerator.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+static const double SECONDS_PER_HOUR = 3600.0;
+static const double SECONDS_PER_DAY = 86400.0;
+static const double PI = 3.14159265358979323846;
+
+// 以center点钟为中心、宽度为width小时的高斯型时段（中心处为1）
+static double bump(double hourOfDay, double center, double width) {
+    double distance = (hourOfDay - center) / width;
+    return exp(-0.5 * distance * distance);
+}
+
+// 构造函数
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& workload)
+    : config(workload), random(workload.seed), clock(workload.startTime), maxRate(0), produced(0) {
+    // 到达率上限：两个高峰时段互不重叠，各自最多加上(peakFactor-1)倍平峰到达率，活动时段另加(surgeFactor-1)倍
+    double base = 1.0 / config.meanGap;
+    maxRate = base;
+    if (config.process != PROCESS_POISSON && config.peakFactor > 1) {
+        maxRate += base * (config.peakFactor - 1) * 2;
+    }
+    if (config.process == PROCESS_EVENT_DAY && config.surgeFactor > 1) {
+        maxRate += base * (config.surgeFactor - 1);
+    }
+}
+
+// 获取t时刻的到达率
+double WorkloadGenerator::rateAt(double t) const {
+    double base = 1.0 / config.meanGap;
+    if (config.process == PROCESS_POISSON) {
+        return base;
+    }
+    
+    double hour = fmod(t, SECONDS_PER_DAY) / SECONDS_PER_HOUR;
+    double rate = base;
+    if (config.peakFactor > 1) {
+        // 早高峰8点、晚高峰18点，各持续约两小时
+        rate += base * (config.peakFactor - 1) * (bump(hour, 8.0, 1.0) + bump(hour, 18.0, 1.0));
+    }
+    
+    // 活动日（每surgeEvery天的最后一天）19:30前后到达率骤增，持续约三小时
+    long day = static_cast<long>(t / SECONDS_PER_DAY);
+    if (config.process == PROCESS_EVENT_DAY && config.surgeFactor > 1 && config.surgeEvery > 0 &&
+        day % config.surgeEvery == config.surgeEvery - 1) {
+        rate += base * (config.surgeFactor - 1) * bump(hour, 19.5, 1.5);
+    }
+    return rate;
+}
+
+// 生成下一个到达事件
+bool WorkloadGenerator::next(TraceEvent& event) {
+    if (produced >= config.arrivals) {
+        return false;
+    }
+    
+    // 稀疏法：候选时刻按最大到达率的泊松过程生成，以 当时到达率/最大到达率 的概率接受
+    do {
+        clock += -log(random.uniform()) / maxRate;
+    } while (config.process != PROCESS_POISSON && random.uniform() * maxRate > rateAt(clock));
+    if (clock > 4294967295.0) {
+        // 事件时间以32位秒数存储，超出范围后不再生成
+        return false;
+    }
+    
+    memset(&event, 0, sizeof(event));
+    event.op = TRACE_ARRIVAL;
+    event.time = static_cast<uint32_t>(clock);
+    
+    int roll = static_cast<int>(random.uniform() * 100);
+    event.carType = static_cast<uint8_t>(roll < config.mix[0] ? SMALL
+                                         : (roll < config.mix[0] + config.mix[1] ? MEDIUM : LARGE));
+    event.dwell = drawDwell();
+    
+    // 车牌按生成次序编号（"V"加上十进制序号），每辆车都不同
+    char plate[Car::MAX_PLATE_LENGTH + 1];
+    int length = snprintf(plate, sizeof(plate), "V%llu", static_cast<unsigned long long>(produced));
+    setTracePlate(event, plate, static_cast<size_t>(length));
+    
+    produced++;
+    return true;
+}
+
+// 抽取停车时长
+uint32_t WorkloadGenerator::drawDwell() {
+    double seconds;
+    switch (config.dwell) {
+        case DWELL_FIXED:
+            seconds = config.meanDwell;
+            break;
+        case DWELL_LOGNORMAL: {
+            // Box-Muller变换得到标准正态分布；中位数取 平均值/exp(σ*σ/2)，使平均值等于meanDwell
+            double z = sqrt(-2.0 * log(random.uniform())) * cos(2.0 * PI * random.uniform());
+            double median = config.meanDwell / exp(0.5 * config.dwellSpread * config.dwellSpread);
+            seconds = median * exp(config.dwellSpread * z);
+            break;
+        }
+        default: {
+            // 最短时长之外的部分服从指数分布，总的平均值等于meanDwell
+            double extra = config.meanDwell - config.minDwell;
+            seconds = config.minDwell + (extra > 0 ? -log(random.uniform()) * extra : 0);
+            break;
+        }
+    }
+    
+    if (seconds < config.minDwell) {
+        seconds = config.minDwell;
+    }
+    if (seconds > 4294967295.0) {
+        seconds = 4294967295.0;
+    }
+    // 停车时长为0表示由轨迹中的离开事件决定，生成的到达至少停1秒
+    uint32_t dwell = static_cast<uint32_t>(seconds);
+    return dwell > 0 ? dwell : 1;
+}
+
+// 获取已生成的到达数
+uint64_t WorkloadGenerator::count() const {
+    return produced;
+}
+
+// 从头重新生成
+void WorkloadGenerator::restart() {
+    random = TraceRandom(config.seed);
+    clock = config.startTime;
+    produced = 0;
+}
@@ -0,0 +1,102 @@
+#ifndef WORKLOADGENERATOR_H
+#define WORKLOADGENERATOR_H
+
+#include "ParkingTrace.h"
+
+// 到达过程
+enum ArrivalProcess : unsigned char {
+    PROCESS_POISSON,            // 泊松到达（到达率恒定）
+    PROCESS_RUSH_HOUR,          // 早晚高峰（8点和18点前后到达率升高）
+    PROCESS_EVENT_DAY           // 早晚高峰，另外每隔几天有一次晚间活动，到达率骤增
+};
+
+// 停车时长分布
+enum DwellDistribution : unsigned char {
+    DWELL_EXPONENTIAL,          // 最短时长 + 指数分布
+    DWELL_LOGNORMAL,            // 对数正态分布（右偏，少数车辆停很久）
+    DWELL_FIXED                 // 固定时长
+};
+
+// 车流生成参数
+struct WorkloadConfig {
+    uint32_t seed;              // 随机数种子（相同的种子和参数总是生成相同的车流）
+    uint64_t arrivals;          // 生成的到达数
+    uint32_t startTime;         // 起始时间（秒，按一天的0点对齐计算高峰时段）
+    ArrivalProcess process;     // 到达过程
+    double meanGap;             // 平峰的平均到达间隔（秒）
+    double peakFactor;          // 高峰到达率是平峰的多少倍
+    double surgeFactor;         // 活动时段到达率是平峰的多少倍
+    int surgeEvery;             // 每隔多少天一次活动日
+    int mix[3];                 // 小/中/大型车的比例（百分比，合计100）
+    DwellDistribution dwell;    // 停车时长分布
+    double meanDwell;           // 平均停车时长（秒）
+    double dwellSpread;         // 对数正态分布的形状参数（对数的标准差）
+    uint32_t minDwell;          // 最短停车时长（秒）
+    
+    WorkloadConfig()
+        : seed(1), arrivals(100000), startTime(0), process(PROCESS_POISSON), meanGap(240),
+          peakFactor(3.0), surgeFactor(6.0), surgeEvery(7), dwell(DWELL_EXPONENTIAL),
+          meanDwell(6600), dwellSpread(1.0), minDwell(60) {
+        mix[0] = 34;
+        mix[1] = 33;
+        mix[2] = 33;
+    }
+};
+
+// 可复现的伪随机数（splitmix64）
+// 不使用<random>中的分布：标准库实现不同时分布的输出不同，同一个种子在不同平台上会生成不同的车流
+class TraceRandom {
+private:
+    uint64_t state;
+    
+public:
+    explicit TraceRandom(uint64_t seed) : state(seed) {}
+    
+    // 64位随机数
+    uint64_t nextBits() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    
+    // (0, 1)上的均匀分布
+    double uniform() {
+        return (static_cast<double>(nextBits() >> 11) + 0.5) / 9007199254740992.0;
+    }
+};
+
+// 合成车流生成器
+// 按到达过程生成到达时间（非齐次泊松过程用稀疏法：按最大到达率生成候选时刻，再按当时的到达率接受），
+// 车型按比例抽取，停车时长按选定的分布抽取；只生成到达事件，离开由模拟器按停车时长安排。
+// 每辆车的车牌不同。生成器本身就是内存中的事件流，基准测试可以直接逐个取用，不经过文件
+class WorkloadGenerator {
+private:
+    WorkloadConfig config;      // 生成参数
+    TraceRandom random;         // 随机数
+    double clock;               // 当前时间（秒）
+    double maxRate;             // 到达率上限（每秒）
+    uint64_t produced;          // 已生成的到达数
+    
+public:
+    // 构造函数
+    explicit WorkloadGenerator(const WorkloadConfig& workload);
+    
+    // 生成下一个到达事件，已生成指定数量时返回false
+    bool next(TraceEvent& event);
+    
+    // 获取t时刻的到达率（每秒）
+    double rateAt(double t) const;
+    
+    // 获取已生成的到达数
+    uint64_t count() const;
+    
+    // 从头重新生成（与新建生成器相同）
+    void restart();
+    
+private:
+    // 抽取停车时长
+    uint32_t drawDwell();
+};
+
+#endif // WORKLOADGENERATOR_H
@@ -1,4 +1,5 @@
 #include "ParkingSystem.h"
+#include "ParkingCheckpoint.h"
 #include "ConsoleGUI.h"
 #include <iostream>
 #include <string>
@@ -10,53 +11,61 @@
 
 using namespace std;
 
-// ʾ˵
+// 检查点快照和操作日志文件（位于当前目录）
+const char* CHECKPOINT_FILE = "parking_checkpoint.snap";
+const char* JOURNAL_FILE = "parking_journal.log";
+
+// 日志累计多少条记录后在后台写一次检查点
+const uint32_t CHECKPOINT_RECORDS = 1000;
+
+// 显示菜单
 void displayMenu() {
-    cout << "\n========== ͣϵͳ ==========" << endl;
-    cout << "1. " << endl;
-    cout << "2. 뿪" << endl;
-    cout << "3. ѯͣ״̬" << endl;
-    cout << "4. ѯ򳵵״̬" << endl;
-    cout << "5. ѯ״̬" << endl;
-    cout << "6. ҳ" << endl;
-    cout << "7. в" << endl;
-    cout << "8. ݵļ" << endl;
-    cout << "9. ļ" << endl;
-    cout << "10. ͼνģʽ" << endl;
-    cout << "0. ˳ϵͳ" << endl;
+    cout << "\n========== 停车场管理系统 ==========" << endl;
+    cout << "1. 车辆到达" << endl;
+    cout << "2. 车辆离开" << endl;
+    cout << "3. 查询停车场状态" << endl;
+    cout << "4. 查询候车道状态" << endl;
+    cout << "5. 查询所有状态" << endl;
+    cout << "6. 查找车辆" << endl;
+    cout << "7. 运行测试数据" << endl;
+    cout << "8. 保存数据到文件" << endl;
+    cout << "9. 从文件加载数据" << endl;
+    cout << "10. 图形界面模式" << endl;
+    cout << "11. 导出文本数据（调试用）" << endl;
+    cout << "0. 退出系统" << endl;
     cout << "=====================================" << endl;
-    cout << "ѡ (0-10): ";
+    cout << "请选择操作 (0-11): ";
 }
 
-// ȡ
+// 获取车型输入
 int getCarType() {
     int type;
     while (true) {
-        cout << "ѡ (0-Сͳ, 1-ͳ, 2-ͳ): ";
+        cout << "请选择车型 (0-小型车, 1-中型车, 2-大型车): ";
         cin >> type;
         if (type >= 0 && type <= 2) {
             return type;
         }
-        cout << "룡" << endl;
+        cout << "输入错误，请重新输入！" << endl;
     }
 }
 
-// ȡʱ
-time_t getTimeInput(const string& prompt) {
+// 获取时间输入（直接回车或格式错误时使用clock的当前时间）
+time_t getTimeInput(const string& prompt, const Clock& clock) {
     string timeStr;
-    cout << prompt << " (ʽ: YYYY-MM-DD HH:MM:SSֱӻسʹõǰʱ): ";
-    cin.ignore(); // 뻺
+    cout << prompt << " (格式: YYYY-MM-DD HH:MM:SS，直接回车使用当前时间): ";
+    cin.ignore(); // 清除输入缓冲区
     getline(cin, timeStr);
     
     if (timeStr.empty()) {
-        return time(nullptr); // ʹõǰʱ
+        return clock.now(); // 使用当前时间
     }
     
-    // ʱַ - ֶΪget_timeC++11пܲ
+    // 解析时间字符串 - 手动解析，因为get_time在C++11中可能不可用
     struct tm tm;
     memset(&tm, 0, sizeof(struct tm));
     
-    // 򵥽ʽYYYY-MM-DD HH:MM:SS
+    // 简单解析格式：YYYY-MM-DD HH:MM:SS
     int year, month, day, hour, minute, second;
     if (sscanf(timeStr.c_str(), "%d-%d-%d %d:%d:%d", 
                &year, &month, &day, &hour, &minute, &second) == 6) {
@@ -66,28 +75,28 @@ time_t getTimeInput(const string& prompt) {
         tm.tm_hour = hour;
         tm.tm_min = minute;
         tm.tm_sec = second;
-        tm.tm_isdst = -1; // Զжʱ
+        tm.tm_isdst = -1; // 自动判断夏令时
         
         return mktime(&tm);
     } else {
-        cout << "ʱʽʹõǰʱ" << endl;
-        return time(nullptr);
+        cout << "时间格式错误，使用当前时间" << endl;
+        return clock.now();
     }
 }
 
-// в
+// 运行测试数据
 void runTestData(ParkingSystem& system) {
-    cout << "\n=== в ===" << endl;
-    cout << "ԿҪ" << endl;
-    cout << "n=2Ϊ" << endl;
+    cout << "\n=== 运行测试数据 ===" << endl;
+    cout << "测试数据来自课题要求：" << endl;
+    cout << "设n=2，输入数据为：" << endl;
     cout << "('A',1,5),('A',2,10),('D',1,15),('A',3,20)," << endl;
     cout << "('A',4,25),('A',5,30),('D',2,35),('D',4,40)" << endl;
-    cout << "ע⣺಻10" << endl;
+    cout << "注意：测试数据最多不超过10组" << endl;
     
-    // ͣΪ2
-    system = ParkingSystem(2, 5.0); // 2λÿСʱ5Ԫ
+    // 设置停车场容量为2
+    system = ParkingSystem(2, 5.0); // 2个车位，每小时5元
     
-    //  - ʹü򵥽ṹtuple
+    // 测试数据 - 使用简单结构代替tuple
     struct TestData {
         char action;
         int licensePlate;
@@ -95,21 +104,21 @@ void runTestData(ParkingSystem& system) {
     };
     
     TestData testData[] = {
-        {'A', 1, 5},   // 1ʱ5
-        {'A', 2, 10},  // 2ʱ10
-        {'D', 1, 15},  // 1뿪ʱ15
-        {'A', 3, 20},  // 3ʱ20
-        {'A', 4, 25},  // 4ʱ25
-        {'A', 5, 30},  // 5ʱ30
-        {'D', 2, 35},  // 2뿪ʱ35
-        {'D', 4, 40}   // 4뿪ʱ40
+        {'A', 1, 5},   // 车辆1到达，时间5
+        {'A', 2, 10},  // 车辆2到达，时间10
+        {'D', 1, 15},  // 车辆1离开，时间15
+        {'A', 3, 20},  // 车辆3到达，时间20
+        {'A', 4, 25},  // 车辆4到达，时间25
+        {'A', 5, 30},  // 车辆5到达，时间30
+        {'D', 2, 35},  // 车辆2离开，时间35
+        {'D', 4, 40}   // 车辆4离开，时间40
     };
     
     int dataCount = sizeof(testData) / sizeof(testData[0]);
     
-    // ȷݲ10
+    // 确保测试数据不超过10组
     if (dataCount > 10) {
-        cout << "棺ݳ10飬ֻǰ10" << endl;
+        cout << "警告：测试数据超过10组，将只运行前10组" << endl;
         dataCount = 10;
     }
     
@@ -118,36 +127,83 @@ void runTestData(ParkingSystem& system) {
         int licensePlate = testData[i].licensePlate;
         int timeValue = testData[i].timeValue;
         
-        cout << "\n " << (i+1) << "/" << dataCount << ": " << action << ", : " << licensePlate << ", ʱ: " << timeValue << endl;
+        cout << "\n操作 " << (i+1) << "/" << dataCount << ": " << action << ", 车牌: " << licensePlate << ", 时间: " << timeValue << endl;
         
         if (action == 'A') {
-            // 
-            // ƺתΪַ
+            // 车辆到达
+            // 将车牌号转换为字符串
             string plateStr = to_string(licensePlate);
-            // ʹСͳΪ
+            // 使用小型车作为测试
             system.carArrival(plateStr, 0, timeValue);
         } else if (action == 'D') {
-            // 뿪
+            // 车辆离开
             string plateStr = to_string(licensePlate);
             system.carDeparture(plateStr, timeValue);
         }
         
-        // ÿ2βʾһμҪ״̬ˢ
+        // 每2次操作显示一次简要状态，避免刷屏
         if ((i + 1) % 2 == 0 || i == dataCount - 1) {
-            cout << "  ǰ״̬: ͣ " << (system.getTotalCapacity() - system.getAvailableSpaces()) 
-                 << "/" << system.getTotalCapacity() << ", 򳵵 " 
-                 << system.getWaitingLaneLength() << " " << endl;
+            cout << "  当前状态: 停车场 " << (system.getTotalCapacity() - system.getAvailableSpaces()) 
+                 << "/" << system.getTotalCapacity() << ", 候车道 " 
+                 << system.getWaitingLaneLength() << " 辆车" << endl;
         }
     }
     
-    cout << "\nɣ " << dataCount << " ݡ" << endl;
-    cout << "\n״̬:" << endl;
+    cout << "\n测试数据运行完成！共运行了 " << dataCount << " 组数据。" << endl;
+    cout << "\n最终状态:" << endl;
     system.displayAllStatus();
-    cout << "\n˵..." << endl;
+    cout << "\n按任意键返回主菜单..." << endl;
     ::system("pause > nul");
 }
 
-// ͼνģʽ
+// 启动恢复：加载上次的检查点快照，重放之后的日志记录，然后挂接日志记录本次运行的变更
+void recoverState(ParkingSystem& system, ParkingJournal& journal, ParkingCheckpointer& checkpointer) {
+    bool hasCheckpoint = isSnapshotFile(CHECKPOINT_FILE);
+    if (hasCheckpoint && !system.loadSnapshot(CHECKPOINT_FILE)) {
+        // 快照损坏时不打开日志，保留原有的日志文件
+        cout << "警告：检查点快照 " << CHECKPOINT_FILE << " 已损坏，本次运行不记录操作日志！" << endl;
+        return;
+    }
+    
+    vector<JournalRecord> records;
+    if (!journal.open(JOURNAL_FILE, records)) {
+        cout << "警告：无法打开操作日志 " << JOURNAL_FILE << "，本次运行不记录操作日志！" << endl;
+        return;
+    }
+    
+    int replayed = system.replayJournal(records);
+    if (replayed < 0) {
+        cout << "警告：操作日志与检查点衔接不上，只恢复到能重放的最后一条记录！" << endl;
+    }
+    if (hasCheckpoint || replayed != 0) {
+        cout << "已恢复上次的数据：停车场 " << system.getTotalCapacity() - system.getAvailableSpaces()
+             << " 辆车，候车道 " << system.getWaitingLaneLength() << " 辆车";
+        if (replayed > 0) {
+            cout << "（重放 " << replayed << " 条日志记录）";
+        }
+        cout << endl;
+    }
+    
+    // 恢复后的状态立即写入检查点，日志从空开始
+    system.setJournal(&journal);
+    if (!checkpointer.checkpointNow(system)) {
+        cout << "警告：检查点保存失败！" << endl;
+    }
+}
+
+// 系统状态被整体替换（运行测试数据、加载文件）后重新挂接日志并做检查点
+// 日志中原有的记录对新状态不再有效，检查点之后日志从空开始
+void reattachJournal(ParkingSystem& system, ParkingJournal& journal, ParkingCheckpointer& checkpointer) {
+    if (!journal.isOpen()) {
+        return;
+    }
+    system.setJournal(&journal);
+    if (!checkpointer.checkpointNow(system)) {
+        cout << "警告：检查点保存失败！" << endl;
+    }
+}
+
+// 图形界面模式
 void graphicalInterfaceMode(ParkingSystem& system) {
     ConsoleGUI gui(system);
     bool inGraphicalMode = true;
@@ -159,42 +215,42 @@ void graphicalInterfaceMode(ParkingSystem& system) {
         cin >> choice;
         
         switch (choice) {
-            case 0: // ˳ϵͳ
+            case 0: // 退出系统
                 inGraphicalMode = false;
-                cout << "˳ͼνģʽ..." << endl;
+                cout << "退出图形界面模式..." << endl;
                 break;
                 
-            case 1: // ͼν棩
+            case 1: // 车辆到达（图形界面）
                 gui.displayArrivalInterface();
                 break;
                 
-            case 2: // 뿪ͼν棩
+            case 2: // 车辆离开（图形界面）
                 gui.displayDepartureInterface();
                 break;
                 
-            case 3: // 鿴ͣӻ
+            case 3: // 查看停车场可视化
                 gui.displayParkingVisualization(system);
                 break;
                 
-            case 4: // 鿴򳵵ӻ
+            case 4: // 查看候车道可视化
                 gui.displayWaitingLaneVisualization(system);
                 break;
                 
-            case 5: // 鿴ϵͳӻ
+            case 5: // 查看完整系统可视化
                 gui.displayFullVisualization(system);
                 break;
                 
-            case 6: // в
+            case 6: // 运行测试数据
                 gui.displayTestDataInterface();
                 break;
                 
-            case 7: // ı
+            case 7: // 返回文本界面
                 inGraphicalMode = false;
-                cout << "ıģʽ..." << endl;
+                cout << "返回文本界面模式..." << endl;
                 break;
                 
             default:
-                cout << "Чѡ룡" << endl;
+                cout << "无效的选择，请重新输入！" << endl;
                 ::system("pause");
                 break;
         }
@@ -202,128 +258,180 @@ void graphicalInterfaceMode(ParkingSystem& system) {
 }
 
 int main() {
-    // ʼͣϵͳ
-    ParkingSystem system(10, 5.0); // 10λÿСʱ5Ԫ
+    // 初始化停车场系统
+    ParkingSystem system(10, 5.0); // 10个车位，每小时5元
     
-    // óλã3Сͳλ3ͳλ4ͳλ
+    // 设置车位配置：3个小型车位，3个中型车位，4个大型车位
     system.setParkingSpaces(3, 3, 4);
     
     int choice;
     bool running = true;
     
-    cout << "ӭʹͣģϵͳ" << endl;
-    cout << "ϵͳѳʼ10λ3С/3/4󣩣ʣ5Ԫ/Сʱ" << endl;
+    cout << "欢迎使用停车场模拟系统！" << endl;
+    cout << "系统已初始化：10个车位（3小/3中/4大），费率：5元/小时" << endl;
+    
+    // 从检查点和操作日志恢复上次的数据
+    ParkingJournal journal;
+    ParkingCheckpointer checkpointer(CHECKPOINT_FILE);
+    recoverState(system, journal, checkpointer);
+    bool journalWarned = false;
     
     while (running) {
+        // 日志由后台线程按时间间隔落盘，交互操作之间停顿时不必在这里同步
+        if (journal.isOpen() && !journal.good() && !journalWarned) {
+            cout << "警告：操作日志写入失败，之后的变更不会记录！" << endl;
+            journalWarned = true;
+        }
+        
+        // 日志累计足够多的记录后在后台写检查点，不阻塞后续操作
+        checkpointer.poll();
+        if (journal.good() && !checkpointer.inProgress() &&
+            journal.lastLsn() - checkpointer.lastCheckpointLsn() >= CHECKPOINT_RECORDS) {
+            checkpointer.begin(system);
+        }
+        
         displayMenu();
         cin >> choice;
         
         switch (choice) {
-            case 0: // ˳ϵͳ
+            case 0: // 退出系统
                 running = false;
-                cout << "лʹͣģϵͳټ" << endl;
+                // 退出前做一次检查点，下次启动不必重放日志
+                if (journal.good() && !checkpointer.checkpointNow(system)) {
+                    cout << "警告：检查点保存失败！" << endl;
+                }
+                cout << "感谢使用停车场模拟系统，再见！" << endl;
                 break;
                 
-            case 1: { // 
+            case 1: { // 车辆到达
                 string licensePlate;
-                cout << "복ƺ: ";
+                cout << "请输入车牌号: ";
                 cin >> licensePlate;
                 
                 int carType = getCarType();
-                time_t arrivalTime = getTimeInput("뵽ʱ");
+                time_t arrivalTime = getTimeInput("请输入到达时间", system.getClock());
                 
-                int result = system.carArrival(licensePlate, carType, arrivalTime);
-                if (result == 0) {
-                    cout << "ѳɹͣͣ" << endl;
-                } else if (result == 1) {
-                    cout << "ѽ򳵵ȴ" << endl;
+                ArrivalResult result = system.carArrival(licensePlate, carType, arrivalTime);
+                if (result.outcome == ARRIVAL_PARKED) {
+                    cout << "车辆已成功停入停车场！" << endl;
+                } else if (result.outcome == ARRIVAL_WAITING) {
+                    cout << "车辆已进入候车道等待！" << endl;
                 } else {
-                    cout << "ʧܣ" << endl;
+                    cout << "车辆到达失败！" << endl;
                 }
                 break;
             }
                 
-            case 2: { // 뿪
+            case 2: { // 车辆离开
                 string licensePlate;
-                cout << "복ƺ: ";
+                cout << "请输入车牌号: ";
                 cin >> licensePlate;
                 
-                time_t departureTime = getTimeInput("뿪ʱ");
+                time_t departureTime = getTimeInput("请输入离开时间", system.getClock());
                 
-                bool success = system.carDeparture(licensePlate, departureTime);
-                if (success) {
-                    cout << "뿪ɹ" << endl;
+                DepartureResult result = system.carDeparture(licensePlate, departureTime);
+                if (result.ok()) {
+                    cout << "车辆离开成功！" << endl;
                 } else {
-                    cout << "뿪ʧܣ" << endl;
+                    cout << "车辆离开失败！" << endl;
                 }
                 break;
             }
                 
-            case 3: // ѯͣ״̬
+            case 3: // 查询停车场状态
                 system.displayParkingStatus();
                 break;
                 
-            case 4: // ѯ򳵵״̬
+            case 4: // 查询候车道状态
                 system.displayWaitingLaneStatus();
                 break;
                 
-            case 5: // ѯ״̬
+            case 5: // 查询所有状态
                 system.displayAllStatus();
                 break;
                 
-            case 6: { // ҳ
+            case 6: { // 查找车辆
                 string licensePlate;
-                cout << "Ҫҵĳƺ: ";
+                cout << "请输入要查找的车牌号: ";
                 cin >> licensePlate;
                 
                 int location = system.findCar(licensePlate);
+                double fee;
+                long duration;
                 if (location == 1) {
-                    cout << " " << licensePlate << " ͣ" << endl;
+                    cout << "车辆 " << licensePlate << " 在停车场中" << endl;
+                    if (system.getAccruedFee(licensePlate, fee, duration)) {
+                        cout << "已停车 " << duration / 60 << " 分钟，当前应收 "
+                             << fixed << setprecision(2) << fee << " 元" << endl;
+                    }
                 } else if (location == 2) {
-                    cout << " " << licensePlate << " ں򳵵" << endl;
+                    cout << "车辆 " << licensePlate << " 在候车道中" << endl;
                 } else {
-                    cout << "δҵ " << licensePlate << endl;
+                    cout << "未找到车辆 " << licensePlate << endl;
                 }
                 break;
             }
                 
-            case 7: // в
+            case 7: // 运行测试数据
                 runTestData(system);
+                reattachJournal(system, journal, checkpointer);
                 break;
                 
-            case 8: { // ݵļ
+            case 8: { // 保存数据到文件
                 string filename;
-                cout << "ļ: ";
+                cout << "请输入文件名: ";
                 cin >> filename;
                 
-                if (system.saveToFile(filename)) {
-                    cout << "ݱɹ" << endl;
+                // 保存为二进制快照
+                if (system.saveSnapshot(filename)) {
+                    cout << "数据保存成功！" << endl;
                 } else {
-                    cout << "ݱʧܣ" << endl;
+                    cout << "数据保存失败！" << endl;
                 }
                 break;
             }
                 
-            case 9: { // ļ
+            case 9: { // 从文件加载数据
                 string filename;
-                cout << "ļ: ";
+                cout << "请输入文件名: ";
                 cin >> filename;
                 
-                if (system.loadFromFile(filename)) {
-                    cout << "ݼسɹ" << endl;
+                // 二进制快照直接映射加载，其他文件按文本导出格式读取
+                bool loaded = isSnapshotFile(filename) ? system.loadSnapshot(filename)
+                                                       : system.loadFromFile(filename);
+                if (loaded) {
+                    cout << "数据加载成功！" << endl;
+                    reattachJournal(system, journal, checkpointer);
                 } else {
-                    cout << "ݼʧܣ" << endl;
+                    cout << "数据加载失败！" << endl;
                 }
                 break;
             }
                 
-            case 10: { // ͼνģʽ
+            case 10: { // 图形界面模式
                 graphicalInterfaceMode(system);
+                // 图形界面中运行测试数据会整体替换系统状态
+                if (system.getJournal() == nullptr) {
+                    reattachJournal(system, journal, checkpointer);
+                }
+                break;
+            }
+                
+            case 11: { // 导出文本数据
+                string filename;
+                cout << "请输入文件名: ";
+                cin >> filename;
+                
+                if (system.saveToFile(filename)) {
+                    cout << "文本数据导出成功！" << endl;
+                } else {
+                    cout << "文本数据导出失败！" << endl;
+                }
                 break;
             }
                 
             default:
-                cout << "Чѡ룡" << endl;
+                cout << "无效的选择，请重新输入！" << endl;
                 break;
         }
     }